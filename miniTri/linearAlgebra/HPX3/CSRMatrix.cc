@@ -60,18 +60,19 @@
 #include <list>
 #include <map>
 #include <set>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 #include "CSRMatrix.h"
 #include "Vector.h"
 #include "mmUtil.h"
+#include "permUtil.h"
 #include "mmio.h"
 
 int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
 
-void createPermutation(boost::shared_array<int> degree, std::vector<int> &perm, std::vector<int> &iperm);
-void formDegreeMultiMap(boost::shared_array<int> degree, int size, std::multimap<int,int> &degreeMap);
+void fillRowBlock(CSRRowBlock &blk, const std::map<int,int> *rowSets);
 
 unsigned int choose2(unsigned int k);
 
@@ -83,23 +84,14 @@ struct blockDS
 };
 
 
-struct matDS
-{
-  boost::shared_array<int> nnzInRow;
-  boost::shared_array<boost::shared_array<int> > cols;
-  boost::shared_array<boost::shared_array<int> > vals;
-  boost::shared_array<boost::shared_array<int> > vals2;
-  int startrow;
-  int endrow;
-};
-
-
 ////////////////////////////////
 // Function to launch with HPX
 ////////////////////////////////
-int matmat_ComputeRowBlock(const CSRMat &A, const CSRMat &B, blockDS blockInfo, matDS outData);
+int matmat_ComputeRowBlock(CSRView A, CSRView B, blockDS blockInfo, CSRRowBlock *outBlock);
+
+void Kcounts_FindDepBlocks(CSRView C, blockDS blockInfo, int blockSize, std::set<int> &blockIDs);
 
-void Kcounts_ComputeRowBlock(const matDS &inData,
+void Kcounts_ComputeRowBlock(CSRView C, blockDS blockInfo,
                              const Vector &vTriDegrees,
 			     const Vector &eTriDegrees,
 			     const std::map<int,std::map<int,int> > & edgeInds,
@@ -117,18 +109,23 @@ void CSRMat::print() const
 {
   std::cout << "Matrix: " << m << " " << n << " " << getNNZ() << std::endl;
 
+  CSRView view = getView();
+
   for(int rownum=0; rownum<m; rownum++)
   {
-    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    const int *rowCols = view.getRowCols(rownum);
+    const int *rowVals = view.getRowVals(rownum);
+    const int *rowVals2 = view.getRowVals2(rownum);
+
+    for(int nzIdx=0; nzIdx<view.getNNZInRow(rownum); nzIdx++)
     {
-      std::cout << rownum << " " << cols[rownum][nzIdx] << " { ";
+      std::cout << rownum << " " << rowCols[nzIdx] << " { ";
 
-      std::cout << vals[rownum][nzIdx];
+      std::cout << rowVals[nzIdx];
 
-      // replace with nullPtr
-      if(vals2 != boost::shared_array<boost::shared_array<int> >())
+      if(rowVals2 != 0)
       {
-	std::cout << ", " << vals2[rownum][nzIdx];
+	std::cout << ", " << rowVals2[nzIdx];
       }
       std::cout << "}" << std::endl;
     }
@@ -144,17 +141,22 @@ std::list<int> CSRMat::getSumElements() const
 {
   std::list<int> matList;
 
+  CSRView view = getView();
+
   for(int rownum=0; rownum<m; rownum++)
   {
-    int nrows = nnzInRow[rownum];
+    int nrows = view.getNNZInRow(rownum);
+    const int *rowVals = view.getRowVals(rownum);
+    const int *rowVals2 = view.getRowVals2(rownum);
+
     for(int nzIdx=0; nzIdx<nrows; nzIdx++)
     {
       matList.push_back(rownum);
 
-      matList.push_back(vals[rownum][nzIdx]);
+      matList.push_back(rowVals[nzIdx]);
 
       // perhaps should add check for this
-      matList.push_back(vals2[rownum][nzIdx]);
+      matList.push_back(rowVals2[nzIdx]);
 
     }
   }
@@ -169,11 +171,11 @@ std::list<int> CSRMat::getSumElements() const
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::getRowNNZs(std::vector<int> &rowNNZs) const
 {
-  std::list<int> matList;
+  CSRView view = getView();
 
   for(int rownum=0; rownum<m; rownum++)
   {
-    rowNNZs[rownum] = nnzInRow[rownum];
+    rowNNZs[rownum] = view.getNNZInRow(rownum);
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -185,11 +187,13 @@ void CSRMat::getRowNNZs(std::vector<int> &rowNNZs) const
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::getColNNZs(std::vector<int> &colNNZs) const
 {
-  for(int rownum=0; rownum<m; rownum++)
+  for(int blk=0; blk<mNumBlocks; blk++)
   {
-    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    const int *blkCols = mBlocks[blk].cols();
+
+    for(int nzIdx=0; nzIdx<mBlocks[blk].nnz; nzIdx++)
     {
-      colNNZs[cols[rownum][nzIdx]]++;
+      colNNZs[blkCols[nzIdx]]++;
     }
   }
 
@@ -204,6 +208,8 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 {
   m = this->getM();
 
+  CSRView view = getView();
+
   if(trans==false)
   {
     for (int startrow=0; startrow<m; startrow+=mBlockSize)
@@ -221,7 +227,7 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 
             for (int rowID=startrow; rowID<endrow; rowID++)
             {
-              y.setVal(rowID,nnzInRow[rowID]);
+              y.setVal(rowID,view.getNNZInRow(rowID));
 	    }
             return;
 	  }
@@ -231,76 +237,162 @@ void CSRMat::SpMV1(bool trans, Vector &y)
   }
   else
   {
-    // Why is this global barrier necessary?
-    //For 1D, must wait until matrix is completely built
-    //TODO
-    hpx::wait_all(mOps); //when_all(mOps)  gives future to mOps, attach continuation
     int vsize=y.getSize();
 
-    int numBlocks = m/mBlockSize;
-    if(m % mBlockSize !=0)
-    {
-      numBlocks++;
-    }
-    // At least 1 block
-    numBlocks = std::max(numBlocks,1);
-
-    //Is there a better way to do this?
-    std::vector<Vector> yloc(numBlocks);
-
-    for(unsigned int i=0;i<numBlocks;i++)
-    {
-      (yloc[i]).resize(vsize);
-    }
+    /////////////////////////////////////////////////////////////////////
+    // Each row block counts its columns into a private vector as soon as
+    // its part of the matrix has been built.  The partial vectors are
+    // summed by a single continuation, so the caller never blocks here.
+    /////////////////////////////////////////////////////////////////////
+    std::vector<Vector> yloc;
+    std::vector<hpx::shared_future<void> > partialOps;
 
     for (int startrow=0; startrow<m; startrow+=mBlockSize)
     {
       int endrow=std::min(startrow+mBlockSize,m);
 
+      // Copies of Vector share the underlying elements
+      Vector yBlock(vsize);
+      yloc.push_back(yBlock);
+
       //Using lambda expression to launch task
-      y.mOps.push_back( hpx::async(
-	 [=,&yloc]() 
+      partialOps.push_back(
+        mOps[startrow/mBlockSize].then
+        (
+	 [=](hpx::shared_future<int> && fc) mutable
           {
-            unsigned int indx = startrow/mBlockSize;
+            fc.get();  // future is ready here, rethrows exception 
+
             for(int rowID=startrow;rowID<endrow; rowID++)
 	    {
-	      int NNZinRow = nnzInRow[rowID];
+	      int NNZinRow = view.getNNZInRow(rowID);
+	      const int *rowCols = view.getRowCols(rowID);
 
 	      for(int nzindx=0; nzindx<NNZinRow; nzindx++)
 	      {
-	        int colA=cols[rowID][nzindx];
-	        yloc[indx].setVal(colA,yloc[indx][colA]+1);
+	        int colA=rowCols[nzindx];
+	        yBlock.setVal(colA,yBlock[colA]+1);
 	      }
 	    }
             return;
 	  }
-	 ));
-
+	)
+      );
     } // end loop over rows                                                        
 
+    hpx::shared_future<void> sumOp = hpx::when_all(partialOps).then
+      (
+       [yloc,vsize,&y](hpx::future<std::vector<hpx::shared_future<void> > > && fp)
+       {
+         fp.get();
+
+         for(unsigned int i=0; i<yloc.size(); i++)
+         {
+           for(int vindx=0;vindx<vsize;vindx++)
+           {
+             y.setVal(vindx,y[vindx]+yloc[i][vindx]);
+           }
+         }
+         return;
+       }
+      );
 
-    //Eventually this synchronization point will be removed
-    // NEED REDUCE
-    // This is overkill, should be replaced with proper reduction
-    // Can I use atomics here?
-    // TODO
-    for(int i=0; i<numBlocks;i++)
+    /////////////////////////////////////////////////////////////////////
+    // Every block of y becomes ready when the reduction has finished
+    /////////////////////////////////////////////////////////////////////
+    int numYBlocks = std::max((vsize+mBlockSize-1)/mBlockSize,1);
+    for(int i=0; i<numYBlocks; i++)
     {
-      y.mOps[i].get();
+      y.mOps.push_back(sumOp);
+    }
+    /////////////////////////////////////////////////////////////////////
 
-      //attach as continuation to y.mOps
+  }
 
-      //parallelize the for loop? hpx::parallel::for_each -- can make asynchronous
-      for(int vindx=0;vindx<vsize;vindx++)
-      {
-        y.setVal(vindx,y[vindx]+yloc[i][vindx]);
-      }
-    }
+}
+//////////////////////////////////////////////////////////////////////////////
 
-    //Global synchronization point, so clear futures
-    y.clearFutures();
+//////////////////////////////////////////////////////////////////////////////
+// computeTriDegrees -- 
+//     Computes triangle vertex degrees (C * 1) and triangle edge degrees
+//     (C' * 1) one row block at a time, as a continuation of the future
+//     that builds that block of C.
+//
+//     Row v of C holds one nonzero for each triangle (v,v2,v3), where
+//     v2 and v3 are the two elements of the nonzero.  That triangle
+//     contains edges (v,v2) and (v,v3).  Each row only updates the
+//     degrees of the edges it owns, i.e. the edges (v,w) with v<w, so
+//     every edge degree is complete after its owning block has been
+//     processed and no reduction across blocks is needed.
+//
+//     The futures pushed onto vTriDegrees.mOps and eTriDegrees.mOps are
+//     the same: entry i is ready when the vertex degrees of row block i
+//     and the degrees of the edges owned by row block i are ready.
+//////////////////////////////////////////////////////////////////////////////
+void CSRMat::computeTriDegrees(const std::map<int,std::map<int,int> > & edgeInds,
+                               Vector &vTriDegrees, Vector &eTriDegrees)
+{
+  m = this->getM();
 
-  }
+  CSRView view = getView();
+
+  for (int startrow=0; startrow<m; startrow+=mBlockSize)
+  {
+    int endrow=std::min(startrow+mBlockSize,m);
+
+    //Using lambda expression to launch task
+    // Task is dependent on equivalent part of matrix having been constructed
+    hpx::shared_future<void> degOp = mOps[startrow/mBlockSize].then
+      (
+       [=,&vTriDegrees,&eTriDegrees,&edgeInds](hpx::shared_future<int> && fc) 
+        {
+          fc.get();  // future is ready here, rethrows exception 
+
+          for (int rowID=startrow; rowID<endrow; rowID++)
+          {
+            int NNZinRow = view.getNNZInRow(rowID);
+            vTriDegrees.setVal(rowID,NNZinRow);
+
+            if(NNZinRow==0)
+            {
+              continue;
+            }
+
+            std::map<int,std::map<int,int> >::const_iterator eIter = edgeInds.find(rowID);
+            if(eIter==edgeInds.end()) // no edges owned by this row
+            {
+              continue;
+            }
+            const std::map<int,int> &rowEdges = eIter->second;
+
+            const int *rowVals = view.getRowVals(rowID);
+            const int *rowVals2 = view.getRowVals2(rowID);
+
+            for(int nzIdx=0; nzIdx<NNZinRow; nzIdx++)
+            {
+              int v2 = rowVals[nzIdx];
+              int v3 = rowVals2[nzIdx];
+
+              if(rowID<v2)
+              {
+                int e = rowEdges.find(v2)->second;
+                eTriDegrees.setVal(e,eTriDegrees[e]+1);
+              }
+              if(rowID<v3)
+              {
+                int e = rowEdges.find(v3)->second;
+                eTriDegrees.setVal(e,eTriDegrees[e]+1);
+              }
+            }
+          }
+          return;
+        }
+      );
+
+    vTriDegrees.mOps.push_back(degOp);
+    eTriDegrees.mOps.push_back(degOp);
+
+  } // end loop over rows
 
 }
 //////////////////////////////////////////////////////////////////////////////
@@ -308,44 +400,38 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 //////////////////////////////////////////////////////////////////////////////
 // matmat -- level 3 basic linear algebra subroutine  
 //        -- Z = AB where Z = this
+//        -- A and B are passed to the tasks as views, so they must outlive
+//           the futures in mOps
 //////////////////////////////////////////////////////////////////////////////
 void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 {
   ///////////////////////////////////////////////////////////////////////////
-  // set dimensions of matrix, build arrays nnzInRow, vals, cols
+  // set dimensions of matrix, build empty row blocks
   ///////////////////////////////////////////////////////////////////////////
-  int oldM=m;
   m = A.getM();
   n = B.getN();
 
-  if(oldM!=m)
-  {
-    nnzInRow = boost::shared_array<int>(new int[m]);
-    cols = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-    vals = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-    vals2 = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-  }
+  allocateBlocks();
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
   // Compute SpGEMM using task parallelism.  Each task computes the part of
   // the SpGEMM operation corresponding to a block of rows.
   ///////////////////////////////////////////////////////////////////////////
+  CSRView viewA = A.getView();
+  CSRView viewB = B.getView();
+
   for (int rownum=0; rownum<m; rownum+=mBlockSize)
   {
     int endrow=std::min(rownum+mBlockSize,m);
 
     blockDS blockInfo;
+    blockInfo.rowID = rownum/mBlockSize;
     blockInfo.startrow = rownum;
     blockInfo.endrow = endrow;
 
-    matDS outData;
-    outData.nnzInRow = nnzInRow;
-    outData.cols = cols;
-    outData.vals = vals;
-    outData.vals2 = vals2;
-
-    mOps.push_back( hpx::async(&matmat_ComputeRowBlock,A,B,blockInfo,outData) );
+    mOps.push_back( hpx::async(&matmat_ComputeRowBlock,viewA,viewB,blockInfo,
+                               &mBlocks[blockInfo.rowID]) );
   } // end loop over rows                                                        
   ///////////////////////////////////////////////////////////////////////////
 
@@ -354,213 +440,249 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-// Might need to use some temporary copy of output in order to achieve good performance
+// Computes one row block of C = A*B.  The nonzeros of the block are gathered
+// in temporary arrays and then copied into the block's buffer.
 ////////////////////////////////////////////////////////////////////////////////
-int matmat_ComputeRowBlock(const CSRMat &A, const CSRMat &B, blockDS blockInfo, matDS outData)
+int matmat_ComputeRowBlock(CSRView A, CSRView B, blockDS blockInfo, CSRRowBlock *outBlock)
 {
   int startrow = blockInfo.startrow;
   int endrow = blockInfo.endrow;
 
-  boost::shared_array<int> nnzInRow = outData.nnzInRow;
-  boost::shared_array<boost::shared_array<int> > cols = outData.cols;
-  boost::shared_array<boost::shared_array<int> > vals = outData.vals;
-  boost::shared_array<boost::shared_array<int> > vals2 = outData.vals2;
-
-  int nnz=0;
+  std::vector<int> rowPtr(endrow-startrow+1,0);
+  std::vector<int> tmpCols;
+  std::vector<int> tmpVals;
+  std::vector<int> tmpVals2;
 
   for (int rownum=startrow; rownum<endrow; rownum++)
   {
-    nnzInRow[rownum]=0;
-
     std::map<int,std::list<int> > newNZs;
 
     int nnzInRowA = A.getNNZInRow(rownum);
+    const int *colsA = A.getRowCols(rownum);
 
     for(int nzindxA=0; nzindxA<nnzInRowA; nzindxA++)
     {
-      int colA=A.getCol(rownum, nzindxA);
+      int colA=colsA[nzindxA];
 
       int nnzInRowB = B.getNNZInRow(colA);
+      const int *colsB = B.getRowCols(colA);
 
       for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
       {
-        int colB=B.getCol(colA, nzindxB);
-
-        nnzInRow[rownum] += addNZ(newNZs,colB, colA);
+        addNZ(newNZs,colsB[nzindxB], colA);
       }
     }
 
     /////////////////////////////////////////////////
-    // Strip out any nonzeros that have only one element
+    // Copy new data into temporary arrays,
+    // stripping out any nonzeros that have only one element
     //   This is an optimization for Triangle Enumeration
     //   Algorithm #2
     /////////////////////////////////////////////////
-    std::map<int,std::list<int> >::iterator iter;
+    std::map<int,std::list<int> >::const_iterator iter;
 
-    for (iter=newNZs.begin(); iter!=newNZs.end(); )
-    {
-      if((*iter).second.size()==1)
-      {
-        // newNZs.erase(iter++);   // Remove nonzero (C++98 Compliant)
-	iter = newNZs.erase(iter); // Remove nonzero (C++11 Compliant)
-        nnzInRow[rownum]--;   // One less nonzero in row
-      }
-      else
-      {
-        ++iter;
-      }
-    }
-    /////////////////////////////////////////////////
-
-    /////////////////////////////////////////////////
-    // If there are nonzeros in this row
-    /////////////////////////////////////////////////
-    if(nnzInRow[rownum] > 0)
+    for (iter=newNZs.begin(); iter!=newNZs.end(); iter++)
     {
-      nnz += nnzInRow[rownum];
-
-      /////////////////////////////////////////
-      //Allocate memory for this row
-      /////////////////////////////////////////
-      cols[rownum] = boost::shared_array<int>(new int[nnzInRow[rownum]]);
-      vals[rownum] = boost::shared_array<int>(new int[nnzInRow[rownum]]);
-      vals2[rownum] = boost::shared_array<int>(new int[nnzInRow[rownum]]);
-
-      /////////////////////////////////////////
-      //Copy new data into row                 
-      /////////////////////////////////////////
-      std::map<int,std::list<int> >::iterator iter;
-      int nzcnt=0;
-
-      // Iterate through list
-      for (iter=newNZs.begin(); iter!=newNZs.end(); iter++)
+      if((*iter).second.size()>1)
       {
-        cols[rownum][nzcnt]= (*iter).first;
+        tmpCols.push_back((*iter).first);
 
  	std::list<int>::const_iterator lIter=(*iter).second.begin();
-	vals[rownum][nzcnt] = *lIter;
+	tmpVals.push_back(*lIter);
         lIter++;
-	vals2[rownum][nzcnt]= *lIter;
-
-	nzcnt++;
+	tmpVals2.push_back(*lIter);
       }
-      /////////////////////////////////////////                     
     }
-    /////////////////////////////////////////
+    rowPtr[rownum-startrow+1] = tmpCols.size();
+    /////////////////////////////////////////////////
 
   } // end loop over rows
   ///////////////////////////////////////////////////////////////////////////
 
+  ///////////////////////////////////////////////////////////////////////////
+  // Copy block into its contiguous buffer
+  ///////////////////////////////////////////////////////////////////////////
+  int nnz = tmpCols.size();
+
+  outBlock->allocate(nnz,true);
+
+  std::copy(rowPtr.begin(),rowPtr.end(),outBlock->rowPtr());
+  std::copy(tmpCols.begin(),tmpCols.end(),outBlock->cols());
+  std::copy(tmpVals.begin(),tmpVals.end(),outBlock->vals());
+  std::copy(tmpVals2.begin(),tmpVals2.end(),outBlock->vals2());
+  ///////////////////////////////////////////////////////////////////////////
+
   return nnz;
 }
 ////////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
 // Compute K counts
+//     -- The k counts of each row block are computed as soon as that block
+//        of C and the triangle degrees it reads are ready.  Returns a
+//        future that is ready once kCounts holds the summed k counts.
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::computeKCounts(const Vector &vTriDegrees,
+hpx::shared_future<void> CSRMat::computeKCounts(const Vector &vTriDegrees,
 			    const Vector &eTriDegrees,
                             const std::map<int,std::map<int,int> > & edgeInds,
-			    std::vector<int> &kCounts)
+			    std::vector<count_t> &kCounts)
 {
 
-  std::vector<hpx::future<void> > ops;
+  std::vector<hpx::shared_future<void> > ops;
   m = this->getM();
 
-  matDS inData;
-  inData.nnzInRow = nnzInRow;
-  inData.cols = cols;
-  inData.vals = vals;
-  inData.vals2 = vals2;
+  CSRView view = getView();
 
   unsigned int kcountSize=kCounts.size();
   std::vector<Vector> kCountLoc;
 
+  int blockSize = mBlockSize;
+
   for (int rownum=0; rownum<m; rownum+=mBlockSize)
   {
     int endrow=std::min(rownum+mBlockSize,m);
 
-    inData.startrow = rownum;
-    inData.endrow = endrow;
+    blockDS blockInfo;
+    blockInfo.rowID = rownum/mBlockSize;
+    blockInfo.startrow = rownum;
+    blockInfo.endrow = endrow;
 
-    unsigned int vInd = kCountLoc.size();
-    kCountLoc.push_back(Vector(kcountSize));
+    // Copies of Vector share the underlying elements
+    Vector kCountBlock(kcountSize);
+    kCountLoc.push_back(kCountBlock);
+
+    /////////////////////////////////////////////////////////////////////
+    // Once this block of C is built, find the row blocks whose degrees its
+    // triangles read and attach the k count computation as a continuation
+    // of those degree computations.
+    /////////////////////////////////////////////////////////////////////
+    hpx::future<hpx::future<void> > kOp = mOps[blockInfo.rowID].then
+      (
+       [=,&vTriDegrees,&eTriDegrees,&edgeInds](hpx::shared_future<int> && fc)
+        {
+          fc.get();  // future is ready here, rethrows exception 
+
+          std::set<int> blockIDs;
+          Kcounts_FindDepBlocks(view,blockInfo,blockSize,blockIDs);
+
+          // vTriDegrees and eTriDegrees share the same per row block futures
+          std::vector<hpx::shared_future<void> > deps;
+          std::set<int>::const_iterator it;
+          for (it = blockIDs.begin(); it != blockIDs.end(); ++it)
+          {
+            deps.push_back(vTriDegrees.mOps[*it]);
+          }
+
+          return hpx::when_all(deps).then
+            (
+             [=,&vTriDegrees,&eTriDegrees,&edgeInds]
+             (hpx::future<std::vector<hpx::shared_future<void> > > && fd)
+              {
+                fd.get();
+                Kcounts_ComputeRowBlock(view,blockInfo,vTriDegrees,eTriDegrees,
+                                        edgeInds,kCountBlock);
+                return;
+              }
+            );
+        }
+      );
 
-    ops.push_back( hpx::async(&Kcounts_ComputeRowBlock,inData,vTriDegrees,eTriDegrees,edgeInds,kCountLoc[vInd]) );
+    // Unwrap future<future<void> >
+    ops.push_back(hpx::future<void>(std::move(kOp)));
 
   } // end loop over rows
 
-
-    //Eventually this synchronization point will be removed
-    for(int i=0; i<ops.size();i++)
-    {
-      ops[i].get();
-      for(int vindx=0;vindx<kcountSize;vindx++)
+  /////////////////////////////////////////////////////////////////////
+  // Sum the k counts of the row blocks once they are all done
+  /////////////////////////////////////////////////////////////////////
+  return hpx::when_all(ops).then
+    (
+     [kCountLoc,kcountSize,&kCounts](hpx::future<std::vector<hpx::shared_future<void> > > && fk)
       {
-        kCounts[vindx] += kCountLoc[i][vindx];
-      }
-    }
-
+        fk.get();
 
+        for(unsigned int i=0; i<kCountLoc.size();i++)
+        {
+          for(unsigned int vindx=0;vindx<kcountSize;vindx++)
+          {
+            kCounts[vindx] += kCountLoc[i][vindx];
+          }
+        }
+        return;
+      }
+    );
+  /////////////////////////////////////////////////////////////////////
                                                         
 }
 //////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
+// Kcounts_FindDepBlocks -- 
+//     Finds the row blocks whose triangle degrees are read by the k count
+//     computation of a block.  A triangle (v1,v2,v3) stored in row v1 reads
+//     the vertex degrees of v1, v2 and v3 and the degrees of its three
+//     edges, which are owned by the row of their lower vertex (v2 or v3).
 //////////////////////////////////////////////////////////////////////////////
-void Kcounts_ComputeRowBlock(const matDS &inData,
-                             const Vector &vTriDegrees,
-			     const Vector &eTriDegrees,
-			     const std::map<int,std::map<int,int> > & edgeInds,
-                             Vector kCounts)
+void Kcounts_FindDepBlocks(CSRView C, blockDS blockInfo, int blockSize, std::set<int> &blockIDs)
 {
-  int startrow = inData.startrow;
-  int endrow = inData.endrow;
+  int startrow = blockInfo.startrow;
+  int endrow = blockInfo.endrow;
+
+  if(startrow<endrow)
+  {
+    blockIDs.insert(startrow/blockSize);
+  }
 
-  // Should try to preallocate memory
-  std::set<int> vList;
-  
-  //////////////////////////////////////////////////////////////////////////////
-  // Store set of vertex and edge IDs.  These will be used to ensure that the
-  // corresponding data has been computed.  These indices will be passed to the
-  // vectors that will wait for the appropriate computations to be complete.
-  //////////////////////////////////////////////////////////////////////////////
   for (int rownum=startrow; rownum<endrow; rownum++)
   {
-    for(int nzIdx=0; nzIdx<inData.nnzInRow[rownum]; nzIdx++)
+    int nnzInRow = C.getNNZInRow(rownum);
+    const int *rowVals = C.getRowVals(rownum);
+    const int *rowVals2 = C.getRowVals2(rownum);
+
+    for(int nzIdx=0; nzIdx<nnzInRow; nzIdx++)
     { 
       int v1 = rownum;
-      int v2 = inData.vals[rownum][nzIdx];
-      int v3 = inData.vals2[rownum][nzIdx];
+      int v2 = rowVals[nzIdx];
+      int v3 = rowVals2[nzIdx];
 
       // Removes redundant triangles
       if(v1>v2 && v1>v3)
       {
-        //Add triangle's vertices to vertex List
-        vList.insert(v1);
-        vList.insert(v2);
-        vList.insert(v3);
-
+        blockIDs.insert(v2/blockSize);
+        blockIDs.insert(v3/blockSize);
       }
     }
   }
+}
+//////////////////////////////////////////////////////////////////////////////
 
-  // Could try moving these waits outside task and change these to continuations
-  // instead
-  vTriDegrees.waitOnIndices(vList);
-  eTriDegrees.waitAll();
-  //////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// Kcounts_ComputeRowBlock -- 
+//     Assumes the triangle degrees read by this block are ready
+//////////////////////////////////////////////////////////////////////////////
+void Kcounts_ComputeRowBlock(CSRView C, blockDS blockInfo,
+                             const Vector &vTriDegrees,
+			     const Vector &eTriDegrees,
+			     const std::map<int,std::map<int,int> > & edgeInds,
+                             Vector kCounts)
+{
+  int startrow = blockInfo.startrow;
+  int endrow = blockInfo.endrow;
 
   //////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////////
   for (int rownum=startrow; rownum<endrow; rownum++)
   {
-    for(int nzIdx=0; nzIdx<inData.nnzInRow[rownum]; nzIdx++)
+    int nnzInRow = C.getNNZInRow(rownum);
+    const int *rowVals = C.getRowVals(rownum);
+    const int *rowVals2 = C.getRowVals2(rownum);
+
+    for(int nzIdx=0; nzIdx<nnzInRow; nzIdx++)
     {
  
       int v1 = rownum;
-      int v2 = inData.vals[rownum][nzIdx];
-      int v3 = inData.vals2[rownum][nzIdx];
+      int v2 = rowVals[nzIdx];
+      int v3 = rowVals2[nzIdx];
 
       // Removes redundant triangles
       if(v1>v2 && v1>v3)
@@ -625,10 +747,6 @@ void Kcounts_ComputeRowBlock(const matDS &inData,
 
 }
 //////////////////////////////////////////////////////////////////////////////
-
-
-
-
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::readMMMatrix(const char *fname)
@@ -637,7 +755,7 @@ void CSRMat::readMMMatrix(const char *fname)
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
@@ -657,7 +775,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED || type==ADJACENCY)
     {
@@ -687,33 +805,13 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////
-  // Allocate memory for matrix
-  //////////////////////////////////////////////////////////////
-  nnzInRow = boost::shared_array<int>(new int[m]);
-  cols = boost::shared_array<boost::shared_array<int> >(new boost::shared_array<int>[m]);
-  vals = boost::shared_array<boost::shared_array<int> >(new boost::shared_array<int>[m]);
+  // copy data from temporary sets to matrix row blocks
   //////////////////////////////////////////////////////////////
+  allocateBlocks();
 
-  //////////////////////////////////////////////////////////////
-  // copy data from temporary sets to matrix data structures
-  //////////////////////////////////////////////////////////////
-  std::map<int,int>::iterator iter;
-
-  for(int rownum=0; rownum<m; rownum++)
+  for(int blk=0; blk<mNumBlocks; blk++)
   {
-    int nnzIndx=0;
-    int nnzToAdd = rowSets[rownum].size();
-    nnzInRow[rownum] = nnzToAdd;
-
-    cols[rownum] = boost::shared_array<int>(new int[nnzToAdd]);
-    vals[rownum] = boost::shared_array<int>(new int[nnzToAdd]);
-
-    for (iter=rowSets[rownum].begin();iter!=rowSets[rownum].end();iter++)
-    {
-      cols[rownum][nnzIndx] = (*iter).first;
-      vals[rownum][nnzIndx] = (*iter).second;
-      nnzIndx++;
-    }
+    fillRowBlock(mBlocks[blk], &rowSets[mBlocks[blk].startrow]);
   }
   //////////////////////////////////////////////////////////////
 
@@ -732,54 +830,40 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
   assert(mtype==LOWERTRI || mtype==UPPERTRI);
   type = mtype;
   
-  //////////////////////////////////////////////////////////////
-  // Allocate memory for matrix -- assumes arrays not allocated
-  //////////////////////////////////////////////////////////////
-  nnzInRow = boost::shared_array<int> (new int[m]);
-  cols = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-  vals = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-  //////////////////////////////////////////////////////////////
+  allocateBlocks();
 
-  for(int rownum=0; rownum<m; rownum++)
+  for(int blk=0; blk<mNumBlocks; blk++)
   {
-    std::map<int,int> nzMap;
+    int startrow = mBlocks[blk].startrow;
+    std::vector< std::map<int,int> > nzMaps(mBlocks[blk].numRows);
 
-    int nnzInRowSrc = matSrc.getNNZInRow(rownum);
-
-    for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    for(int rownum=startrow; rownum<startrow+mBlocks[blk].numRows; rownum++)
     {
-      int colSrc=matSrc.getCol(rownum, nzindxSrc);
-      const int valSrc = matSrc.getVal(rownum, nzindxSrc);
-         
-      // WARNING: assumes there is only 1 value element for now
-      if(type==LOWERTRI && rownum>colSrc)
-      {
-        nzMap[colSrc]=valSrc;
-      }
-      else if(type==UPPERTRI && rownum<colSrc)
-      {
-        nzMap[colSrc]=valSrc;
-      }
+      std::map<int,int> &nzMap = nzMaps[rownum-startrow];
 
-    }
+      int nnzInRowSrc = matSrc.getNNZInRow(rownum);
 
-    int nnzIndx=0;
-    int nnzToAdd = nzMap.size();
-    nnzInRow[rownum] = nnzToAdd;
-
-    cols[rownum] = boost::shared_array<int> (new int[nnzToAdd]);
-    vals[rownum] = boost::shared_array<int> (new int[nnzToAdd]);
-
-    std::map<int,int>::const_iterator iter;
+      for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+      {
+        int colSrc=matSrc.getCol(rownum, nzindxSrc);
+        const int valSrc = matSrc.getVal(rownum, nzindxSrc);
+         
+        // WARNING: assumes there is only 1 value element for now
+        if(type==LOWERTRI && rownum>colSrc)
+        {
+          nzMap[colSrc]=valSrc;
+        }
+        else if(type==UPPERTRI && rownum<colSrc)
+        {
+          nzMap[colSrc]=valSrc;
+        }
 
-    for (iter=nzMap.begin();iter!=nzMap.end();iter++)
-    {
-      cols[rownum][nnzIndx] = (*iter).first;
-      vals[rownum][nnzIndx] = (*iter).second;
-      nnzIndx++;
+      }
     }
 
-  } // end of loop over rows
+    fillRowBlock(mBlocks[blk], &nzMaps[0]);
+
+  } // end of loop over row blocks
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -793,14 +877,6 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc,std::map<int,std::map<int
 
   assert(type==INCIDENCE);
   
-  //////////////////////////////////////////////////////////////
-  // Allocate memory for matrix -- assumes arrays not allocated
-  //////////////////////////////////////////////////////////////
-  nnzInRow = boost::shared_array<int> (new int[m]);
-  cols = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-  vals = boost::shared_array<boost::shared_array<int> > (new boost::shared_array<int>[m]);
-  //////////////////////////////////////////////////////////////
-
   //////////////////////////////////////////////////////////////
   // Store columns that need nonzeros
   //////////////////////////////////////////////////////////////
@@ -831,25 +907,40 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc,std::map<int,std::map<int
   //////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////
-  // Copy data into matrix data structures
+  // Copy data into matrix row blocks
   //     -- Can probably free tmp data structures throughout
   //////////////////////////////////////////////////////////////
-  for(int rownum=0; rownum<m; rownum++)
+  allocateBlocks();
+
+  for(int blk=0; blk<mNumBlocks; blk++)
   {
-    int nnzToAdd = colsInRow[rownum].size();
-    nnzInRow[rownum] = nnzToAdd;
+    CSRRowBlock &block = mBlocks[blk];
+
+    int nnzInBlock=0;
+    for(int lrow=0; lrow<block.numRows; lrow++)
+    {
+      nnzInBlock += colsInRow[block.startrow+lrow].size();
+    }
 
-    cols[rownum] = boost::shared_array<int> (new int[nnzToAdd]);
-    vals[rownum] = boost::shared_array<int> (new int[nnzToAdd]);
+    block.allocate(nnzInBlock,false);
 
-    std::set<int>::const_iterator iter;
+    int *rowPtr = block.rowPtr();
+    int *blkCols = block.cols();
+    int *blkVals = block.vals();
 
     int nnzIndx=0;
-    for (iter=colsInRow[rownum].begin();iter!=colsInRow[rownum].end();iter++)
+    for(int lrow=0; lrow<block.numRows; lrow++)
     {
-      cols[rownum][nnzIndx] = (*iter);
-      vals[rownum][nnzIndx] = 1;
-      nnzIndx++;
+      const std::set<int> &rowCols = colsInRow[block.startrow+lrow];
+
+      std::set<int>::const_iterator iter;
+      for (iter=rowCols.begin();iter!=rowCols.end();iter++)
+      {
+        blkCols[nnzIndx] = (*iter);
+        blkVals[nnzIndx] = 1;
+        nnzIndx++;
+      }
+      rowPtr[lrow+1] = nnzIndx;
     }
   }
   //////////////////////////////////////////////////////////////
@@ -863,87 +954,87 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc,std::map<int,std::map<int
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::permute()
 {
-  std::vector<int> perm(m);
-  std::vector<int> iperm(m);
+  std::vector<int> perm;
+  std::vector<int> iperm;
+
+  std::vector<int> degree(m);
+  getRowNNZs(degree);
 
-  createPermutation(nnzInRow, perm, iperm);
+  createDegreePermutation(&degree[0], m, perm, iperm);
 
   ///////////////////////////////////////////////////////////////////////////
-  // Set temp pointers to save original order
+  // Keep original row blocks until the permuted blocks have been built
   ///////////////////////////////////////////////////////////////////////////
-  std::vector<int> tmpNNZ(m);
-  std::vector<boost::shared_array<int> > tmpCols(m);
-  std::vector<boost::shared_array<int> > tmpVals(m);
+  boost::shared_array<CSRRowBlock> origBlocks = mBlocks;
+  CSRView origView = getView();
 
-  for(int rownum=0; rownum<m; rownum++)
-  {
-    tmpNNZ[rownum] = nnzInRow[rownum];
-    tmpCols[rownum] = cols[rownum];
-    tmpVals[rownum] = vals[rownum];
-  }
+  allocateBlocks();
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
-  //Permute matrix, row by row
+  //Permute matrix, row block by row block
   ///////////////////////////////////////////////////////////////////////////
-  for(int rownum=0; rownum<m; rownum++)
+  for(int blk=0; blk<mNumBlocks; blk++)
   {
-    //////////////////////////////////////////////////////////////////////
-    // Copy data into permuted order
-    //////////////////////////////////////////////////////////////////////
-    nnzInRow[rownum] = tmpNNZ[iperm[rownum]];    
-    cols[rownum] = tmpCols[iperm[rownum]];
- 
-    /////////////////////////////////////////////////////////////////
-    // permute column numbers as well -- perhaps should sort this
-    /////////////////////////////////////////////////////////////////
-    for(int i=0;i<nnzInRow[rownum];i++)
+    int startrow = mBlocks[blk].startrow;
+    std::vector< std::map<int,int> > rowSets(mBlocks[blk].numRows);
+
+    for(int rownum=startrow; rownum<startrow+mBlocks[blk].numRows; rownum++)
     {
-      cols[rownum][i] = perm[cols[rownum][i]];
+      int origRow = iperm[rownum];
+      const int *origCols = origView.getRowCols(origRow);
+      const int *origVals = origView.getRowVals(origRow);
+
+      /////////////////////////////////////////////////////////////////
+      // permute column numbers as well, sorted by the row set
+      /////////////////////////////////////////////////////////////////
+      for(int i=0;i<origView.getNNZInRow(origRow);i++)
+      {
+        rowSets[rownum-startrow][perm[origCols[i]]] = origVals[i];
+      }
+      /////////////////////////////////////////////////////////////////
     }
-    /////////////////////////////////////////////////////////////////
-
-    vals[rownum] = tmpVals[iperm[rownum]];
-
-    //////////////////////////////////////////////////////////////////////
 
+    fillRowBlock(mBlocks[blk], &rowSets[0]);
   }
   ///////////////////////////////////////////////////////////////////////////
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-void createPermutation(boost::shared_array<int> degree, std::vector<int> &perm, std::vector<int> &iperm)
-{
-   std::multimap<int,int> degreeMMap;
-   formDegreeMultiMap(degree,perm.size(),degreeMMap);
-
-   std::multimap<int,int>::const_iterator iter;
-   int cnt=0;
-   for(iter=degreeMMap.begin(); iter!=degreeMMap.end(); ++iter)
-   {
-       perm[(*iter).second] = cnt;
-       iperm[cnt] = (*iter).second;
-       cnt++;
-   }
-}
-////////////////////////////////////////////////////////////////////////////////
-
 //////////////////////////////////////////////////////////////////////////////
-// Form sorted multimap of (degree,rownum) pairs, currently sorted in increasing order
+// fillRowBlock -- Copies the (column,value) maps of the rows of a row block
+//                 into the block's buffer
 //////////////////////////////////////////////////////////////////////////////
-void formDegreeMultiMap(boost::shared_array<int> degree, int size, std::multimap<int,int> &degreeMMap)
+void fillRowBlock(CSRRowBlock &blk, const std::map<int,int> *rowSets)
 {
-  for(int i=0; i<size; i++)
+  int nnzInBlock=0;
+  for(int lrow=0; lrow<blk.numRows; lrow++)
+  {
+    nnzInBlock += rowSets[lrow].size();
+  }
+
+  blk.allocate(nnzInBlock,false);
+
+  int *rowPtr = blk.rowPtr();
+  int *blkCols = blk.cols();
+  int *blkVals = blk.vals();
+
+  int nnzIndx=0;
+  for(int lrow=0; lrow<blk.numRows; lrow++)
   {
-    degreeMMap.insert(std::pair<int, int>(degree[i], i));
+    std::map<int,int>::const_iterator iter;
+    for (iter=rowSets[lrow].begin();iter!=rowSets[lrow].end();iter++)
+    {
+      blkCols[nnzIndx] = (*iter).first;
+      blkVals[nnzIndx] = (*iter).second;
+      nnzIndx++;
+    }
+    rowPtr[lrow+1] = nnzIndx;
   }
 }
 //////////////////////////////////////////////////////////////////////////////
 
-
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
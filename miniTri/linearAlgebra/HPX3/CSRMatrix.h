@@ -58,14 +58,115 @@ typedef enum {UNDEFINED,ADJACENCY,LOWERTRI,UPPERTRI,INCIDENCE} matrixtype;
 #include <list>
 #include <vector>
 #include <map>
+#include <algorithm>
+
+#include "miniTriDefs.h"
 
 #include <hpx/hpx.hpp>
 #include <boost/shared_array.hpp>
 
 class Vector;
 
+//////////////////////////////////////////////////////////////////////////////
+// One row block of a block-segmented CSR matrix.  The row offsets, columns,
+// values and (optionally) second values of the block are stored in one
+// contiguous buffer:  rowPtr[numRows+1] | cols[nnz] | vals[nnz] | vals2[nnz]
+// rowPtr is local to the block.
+//////////////////////////////////////////////////////////////////////////////
+struct CSRRowBlock
+{
+  int startrow;
+  int numRows;
+  int nnz;
+  bool hasVals2;
+
+  std::vector<int> buffer;
+
+  CSRRowBlock()
+    :startrow(0),numRows(0),nnz(0),hasVals2(false),buffer(1,0)
+  {
+  };
+
+  //////////////////////////////////////////////////////////////////////////
+  // Allocates buffer for _nnz nonzeros, rowPtr[0] is set to 0
+  //////////////////////////////////////////////////////////////////////////
+  void allocate(int _nnz, bool _hasVals2)
+  {
+    nnz = _nnz;
+    hasVals2 = _hasVals2;
+
+    int numArrays = hasVals2 ? 3 : 2;
+    std::vector<int>(numRows+1 + numArrays*nnz).swap(buffer);
+  };
+  //////////////////////////////////////////////////////////////////////////
+
+  int * rowPtr() { return &buffer[0]; };
+  int * cols() { return rowPtr() + numRows+1; };
+  int * vals() { return cols() + nnz; };
+  int * vals2() { return hasVals2 ? vals() + nnz : 0; };
+
+  const int * rowPtr() const { return &buffer[0]; };
+  const int * cols() const { return rowPtr() + numRows+1; };
+  const int * vals() const { return cols() + nnz; };
+  const int * vals2() const { return hasVals2 ? vals() + nnz : 0; };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Lightweight, non-owning view of a block-segmented CSR matrix.  Views are
+// passed by value to HPX tasks, which does not touch any reference counts.
+// The viewed matrix must outlive the tasks using the view.
+//////////////////////////////////////////////////////////////////////////////
+class CSRView
+{
+ private:
+  const CSRRowBlock *mBlocks;
+  int mBlockSize;
+
+ public:
+  CSRView(const CSRRowBlock *blocks, int bs)
+    :mBlocks(blocks),mBlockSize(bs)
+  {
+  };
+
+  // returns NNZ in row rnum
+  inline int getNNZInRow(int rnum) const 
+  {
+    const CSRRowBlock &blk = mBlocks[rnum/mBlockSize];
+    const int *rowPtr = blk.rowPtr() + (rnum-blk.startrow);
+    return rowPtr[1]-rowPtr[0];
+  };
+
+  // returns pointers to the columns/values of row rnum
+  inline const int * getRowCols(int rnum) const 
+  {
+    const CSRRowBlock &blk = mBlocks[rnum/mBlockSize];
+    return blk.cols() + blk.rowPtr()[rnum-blk.startrow];
+  };
+
+  inline const int * getRowVals(int rnum) const 
+  {
+    const CSRRowBlock &blk = mBlocks[rnum/mBlockSize];
+    return blk.vals() + blk.rowPtr()[rnum-blk.startrow];
+  };
+
+  // returns 0 if matrix has no second values
+  inline const int * getRowVals2(int rnum) const 
+  {
+    const CSRRowBlock &blk = mBlocks[rnum/mBlockSize];
+    if(blk.hasVals2==false)
+    {
+      return 0;
+    }
+    return blk.vals2() + blk.rowPtr()[rnum-blk.startrow];
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
+//     -- Rows are stored in blocks of mBlockSize rows, each block owning
+//        one contiguous buffer (see CSRRowBlock)
 //////////////////////////////////////////////////////////////////////////////
 class CSRMat 
 {
@@ -74,18 +175,31 @@ class CSRMat
   matrixtype type;
   int m;   //number of rows
   int n;   //number of cols
-  //int nnz; //number of nonzeros
-
-  boost::shared_array<int> nnzInRow;                             // nnz in each row
-  boost::shared_array<boost::shared_array<int> > cols;           //columns of nonzeros
-  boost::shared_array<boost::shared_array<int> > vals; //values of nonzeros
-  boost::shared_array<boost::shared_array<int> > vals2; //values of nonzeros
 
+  int mNumBlocks;
+  boost::shared_array<CSRRowBlock> mBlocks;   // row blocks
 
   std::string mName;
 
   int mBlockSize;
 
+  //////////////////////////////////////////////////////////////////////////
+  // Allocates empty row blocks for the m rows of the matrix
+  //////////////////////////////////////////////////////////////////////////
+  void allocateBlocks()
+  {
+    mNumBlocks = (m+mBlockSize-1)/mBlockSize;
+    mBlocks = boost::shared_array<CSRRowBlock>(new CSRRowBlock[mNumBlocks]);
+
+    for(int i=0; i<mNumBlocks; i++)
+    {
+      mBlocks[i].startrow = i*mBlockSize;
+      mBlocks[i].numRows = std::min(mBlockSize, m-mBlocks[i].startrow);
+      mBlocks[i].buffer.assign(mBlocks[i].numRows+1,0);
+    }
+  };
+  //////////////////////////////////////////////////////////////////////////
+
  public:
 
   //Array of futures for matrix computation 
@@ -99,7 +213,7 @@ class CSRMat
   // default constructor -- builds empty matrix
   //////////////////////////////////////////////////////////////////////////
   CSRMat() 
-    :type(UNDEFINED),m(0),n(0),nnzInRow(),cols(),vals(),vals2(),mName(""),mBlockSize(1)
+    :type(UNDEFINED),m(0),n(0),mNumBlocks(0),mBlocks(),mName(""),mBlockSize(1)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -108,25 +222,19 @@ class CSRMat
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   CSRMat(matrixtype _type,std::string str="",int bs=1) 
-    :type(_type),m(0),n(0),nnzInRow(),cols(),vals(),vals2(),mName(str),mBlockSize(bs)
+    :type(_type),m(0),n(0),mNumBlocks(0),mBlocks(),mName(str),mBlockSize(bs)
   {
   };
   //////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////
-  // constructor -- allocates memory for CSR sparse matrix
+  // constructor -- allocates empty row blocks for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-   CSRMat(int _m, int _n, std::string str="",int bs=1, bool allocateVals2=false)
-    :type(UNDEFINED),m(_m),n(_n),
-    nnzInRow(new int[m]),cols(new boost::shared_array<int> [m]),
-    vals(new boost::shared_array<int> [m]),
+   CSRMat(int _m, int _n, std::string str="",int bs=1)
+    :type(UNDEFINED),m(_m),n(_n),mNumBlocks(0),mBlocks(),
     mName(str),mBlockSize(bs)
   {
-
-    if(allocateVals2==true)
-    {
-      vals2 = boost::shared_array<boost::shared_array<int> >(new boost::shared_array<int> [m]);
-    }
+    allocateBlocks();
   };
   //////////////////////////////////////////////////////////////////////////
 
@@ -134,9 +242,8 @@ class CSRMat
   // Copy constructor -- No data reallocation, just copying of smart pointers
   //////////////////////////////////////////////////////////////////////////
   CSRMat(const CSRMat &obj)
-    //    :type(obj.type),m(obj.m),n(obj.n),nnz(obj.nnz),
     :type(obj.type),m(obj.m),n(obj.n),
-    nnzInRow(obj.nnzInRow),cols(obj.cols), vals(obj.vals),vals2(obj.vals2),
+    mNumBlocks(obj.mNumBlocks),mBlocks(obj.mBlocks),
     mName(obj.mName),mBlockSize(obj.mBlockSize)
   {
   };
@@ -178,29 +285,30 @@ class CSRMat
   // returns the number of cols
   int getN() const { return n;};
 
-  // returns the number of cols
-  // Perhaps better way to do this, if nnz could be incremented by
-  // each thread atomically
-  int getNNZ() const 
+  // returns the number of nonzeros
+  count_t getNNZ() const 
   {
-    int nnz=0;
-    for(int i=0; i< m; i++)
+    count_t nnz=0;
+    for(int i=0; i<mNumBlocks; i++)
     {
-      nnz+=nnzInRow[i];
+      nnz+=mBlocks[i].nnz;
     } 
     return nnz;
   };
 
+  // returns view of matrix that can be passed to tasks
+  CSRView getView() const { return CSRView(mBlocks.get(),mBlockSize); };
+
   // returns NNZ in row rnum
-  inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
+  inline int getNNZInRow(int rnum) const {return getView().getNNZInRow(rnum);};
 
   // returns column # for nonzero in row rowi at index nzindx
-  inline int getCol(int rowi, int nzindx) const {return cols[rowi][nzindx];};
+  inline int getCol(int rowi, int nzindx) const {return getView().getRowCols(rowi)[nzindx];};
 
 
   // returns value for nonzero at inddex nzindx
   inline const int & getVal(int rowi, int nzindx) const 
-    {return vals[rowi][nzindx];};
+    {return getView().getRowVals(rowi)[nzindx];};
 
   //////////////////////////////////////////////////////////////////
 
@@ -216,9 +324,17 @@ class CSRMat
   void matmat(const CSRMat &A, const CSRMat &B);
   //////////////////////////////////////////////////////////////////
 
-  void computeKCounts(const Vector &vTriDegrees,
+  //////////////////////////////////////////////////////////////////
+  // Triangle vertex and edge degrees, computed per row block as
+  // continuations of that block's matmat future
+  //////////////////////////////////////////////////////////////////
+  void computeTriDegrees(const std::map<int,std::map<int,int> > & edgeInds,
+                         Vector &vTriDegrees, Vector &eTriDegrees);
+  //////////////////////////////////////////////////////////////////
+
+  hpx::shared_future<void> computeKCounts(const Vector &vTriDegrees,
 		      const Vector &eTriDegrees, const std::map<int,std::map<int,int> > & edgeInds,
-		      std::vector<int> &kCounts);
+		      std::vector<count_t> &kCounts);
 
   void readMMMatrix(const char *fname);
 
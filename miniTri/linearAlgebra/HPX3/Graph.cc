@@ -102,8 +102,7 @@ void Graph::triangleEnumerate()
 
   gettimeofday(&t1, NULL);
 
-  CSRMat B(INCIDENCE,"B",mBlockSize);
-  B.createIncidentMatrix(mMatrix,mEdgeIndices);
+  mIncMat.createIncidentMatrix(mMatrix,mEdgeIndices);
 
   gettimeofday(&t2, NULL);
 
@@ -120,12 +119,12 @@ void Graph::triangleEnumerate()
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
 
-  boost::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getM(),B.getN(),"C",mBlockSize,true));
+  boost::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getM(),mIncMat.getN(),"C",mBlockSize));
 
   std::cout << "C = A*B: " << std::endl;
 
   gettimeofday(&t1, NULL);
-  C->matmat(mMatrix,B);
+  C->matmat(mMatrix,mIncMat);
   gettimeofday(&t2, NULL);
 
   //C.print();
@@ -135,8 +134,6 @@ void Graph::triangleEnumerate()
 
   std::cout << "--------------------" << std::endl;
 
-  std::cout << "NNZ: " << C->getNNZ() << std::endl;
-
   ///////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////
@@ -168,51 +165,33 @@ void Graph::calculateTriangleDegrees()
             << "**********" << std::endl;
 
   ///////////////////////////////////////////////////////////////////////
-  // Compute triangle vertex degrees
+  // Compute triangle vertex and edge degrees
   //     dv = C * 1
+  //     de = C' * 1
+  //   Launched per row block as continuations of C = A*B, so this only
+  //   times the launch of the tasks
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
-  std::cout << "Computing triangle vertex degrees ...";
+  std::cout << "Computing triangle vertex and edge degrees ...";
 
   gettimeofday(&t1, NULL);
-  mVTriDegrees.resize(mNumVerts); //TODO
-  mVTriDegrees.setBlockSize(mBlockSize);
-
-  //mTriMat->getRowNNZs(mVTriDegrees);
-  mTriMat->SpMV1(false, mVTriDegrees);
-
-  gettimeofday(&t2, NULL);
-
-  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to compute vertex degrees -- not valid: " << eTime << std::endl;
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // Compute triangle edge degrees
-  //   de = C' * 1
-  ///////////////////////////////////////////////////////////////////////
-  std::cout << "--------------------" << std::endl;
-  std::cout << "Computing triangle edge degrees ...";
 
-  gettimeofday(&t1, NULL);
+  mVTriDegrees.resize(mNumVerts);
+  mVTriDegrees.setBlockSize(mBlockSize);
 
-  mETriDegrees.resize(mNumEdges); // is this set to 0?
+  mETriDegrees.resize(mNumEdges);
   mETriDegrees.setBlockSize(mBlockSize);
-  //mTriMat->getColNNZs(mETriDegrees);
-  mTriMat->SpMV1(true, mETriDegrees);
+
+  mTriMat->computeTriDegrees(mEdgeIndices, mVTriDegrees, mETriDegrees);
 
   gettimeofday(&t2, NULL);
 
   std::cout << " done" <<std::endl;
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to compute edge degrees: " << eTime << std::endl;
-
-  std::cout << "------------------------" << std::endl;
-  std::cout << "Triangle edge degree: " << std::endl;
-  //  mETriDegrees.Print();
-  std::cout << "------------------------" << std::endl;
+  std::cout << "TIME - Time to compute triangle degrees -- not valid: " << eTime << std::endl;
 
+  std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
 
   std::cout << "************************************************************"
@@ -228,7 +207,7 @@ void Graph::calculateTriangleDegrees()
 //////////////////////////////////////////////////////////////////////////////
 void Graph::calculateKCounts()
 {
-  mTriMat->computeKCounts(mVTriDegrees,mETriDegrees,mEdgeIndices,mKCounts);
+  mKCountsOp = mTriMat->computeKCounts(mVTriDegrees,mETriDegrees,mEdgeIndices,mKCounts);
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -267,6 +246,12 @@ void Graph::printTriangles() const
 //////////////////////////////////////////////////////////////////////////////
 void Graph::printKCounts()
 {
+  // Wait for k counts of all row blocks to be summed
+  if(mKCountsOp.valid())
+  {
+    mKCountsOp.get();
+  }
+
   std::cout << "K-Counts: " << std::endl;
   for(unsigned int i=3; i<mKCounts.size(); i++)
     {
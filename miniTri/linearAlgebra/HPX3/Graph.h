@@ -77,6 +77,10 @@ class Graph
   int mNumEdges;
   CSRMat mMatrix;
 
+  // Incidence matrix -- read through views by the C = A*B tasks, so it
+  // must outlive them
+  CSRMat mIncMat;
+
   boost::shared_ptr<CSRMat> mTriMat; //Matrix that contains triangle info
 
   std::map<int,std::map<int,int> > mEdgeIndices;
@@ -89,14 +93,17 @@ class Graph
   int mBlockSize;
 
   // K-count frequency table
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
+
+  // Ready when mKCounts has been computed
+  hpx::shared_future<void> mKCountsOp;
 
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mTriMat(),mBlockSize(1)
+    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(),mIncMat(),mTriMat(),mBlockSize(1)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -105,7 +112,8 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string _fname, int bs=1) 
-    :mFilename(_fname),mMatrix(ADJACENCY,"A",bs), mTriMat(),mBlockSize(bs)
+    :mFilename(_fname),mMatrix(ADJACENCY,"A",bs),mIncMat(INCIDENCE,"B",bs),
+     mTriMat(),mBlockSize(bs)
   {
      mMatrix.readMMMatrix(mFilename.c_str());
      mNumVerts = mMatrix.getM();
@@ -155,7 +163,7 @@ class Graph
   {
     hpx::wait_all(mTriMat->mOps);
     // Account for 3 instances of each triangle
-    int numTris = mTriMat->getNNZ()/3;
+    count_t numTris = mTriMat->getNNZ()/3;
 
     std::cout << "WARNING -- GLOBAL BARRIER --" << std::endl;
     std::cout << "   Number of triangles: " << numTris << std::endl;
@@ -65,24 +65,36 @@
 #include "mmUtil.h"
 #include "binFileReader.h"
 
-void printSubmat(const CSRSubmat &submat, int startRow, int locNumRows);
+// Chunk size for dynamically scheduled OpenMP loops over local rows
+static const int ompChunkSize = 64;
 
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
+template<typename ordinal_t>
+void printSubmat(const CSRSubmat<ordinal_t> &submat, int startRow, int locNumRows);
+
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd);
 
 unsigned int choose2(unsigned int k);
 
-void serialSubmatrixMult(const CSRSubmat & submatA, int numRows,
-                         const CSRSubmat & submatB, int startRowB,
-                         std::vector<std::map<int,std::list<int> > > & submatCNZs);
+template<typename ordinal_t>
+void countSubmatCols(const CSRSubmat<ordinal_t> &submat, int numRows, ordinal_t colOffset,
+                     count_t *y, int ySize);
+
+template<typename ordinal_t>
+void serialSubmatrixMult(const CSRSubmat<int> & submatA, int numRows,
+                         const CSRSubmat<ordinal_t> & submatB, int startRowB,
+                         std::vector<std::map<ordinal_t,std::list<int> > > & submatCNZs);
 
-void sendRecvSubmat(const CSRSubmat &submatToSend, int dst, int numRowsSend, int startRowSend,
-                    MPI_Comm comm,int src, CSRSubmat &remSubmat,int &numRowsRecv,int &recvSubmatStartRow);
+template<typename ordinal_t>
+void sendRecvSubmat(const CSRSubmat<ordinal_t> &submatToSend, int dst, int numRowsSend, int startRowSend,
+                    MPI_Comm comm,int src, CSRSubmat<ordinal_t> &remSubmat,int &numRowsRecv,int &recvSubmatStartRow);
 
 //////////////////////////////////////////////////////////////////////////////
 // print function -- outputs matrix to file
 //                -- accepts optional filename, "CSRmatrix.out" default name
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::print() const
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::print() const
 {
   std::cout << "Matrix: " << mGlobNumRows << " " << mGlobNumCols << " " << mGlobNNZ  
             << " " << mLocNNZ << std::endl;
@@ -93,7 +105,7 @@ void CSRMat::print() const
     {
       for(int submatNum=0; submatNum<mWorldSize; submatNum++)
       {
-        const CSRSubmat &submat = mSubmat[submatNum];
+        const CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
 	printSubmat(submat,mStartRow,mLocNumRows);
       }
     }
@@ -105,7 +117,8 @@ void CSRMat::print() const
 //////////////////////////////////////////////////////////////////////////////
 // printSubmat()
 //////////////////////////////////////////////////////////////////////////////
-void printSubmat(const CSRSubmat &submat, int startRow, int locNumRows)
+template<typename ordinal_t>
+void printSubmat(const CSRSubmat<ordinal_t> &submat, int startRow, int locNumRows)
 {
   std::list<int>::const_iterator it;
 
@@ -124,13 +137,14 @@ void printSubmat(const CSRSubmat &submat, int startRow, int locNumRows)
 ////////////////////////////////////////////////////////////////////////////////
 // Sums matrix elements
 ////////////////////////////////////////////////////////////////////////////////
-std::list<int> CSRMat::getSumElements() const
+template<typename ordinal_t>
+std::list<int> CSRMat<ordinal_t>::getSumElements() const
 {
   std::list<int> matList;
 
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    const CSRSubmat &submat = mSubmat[submatNum];
+    const CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
     for(int rownum=0; rownum<mLocNumRows; rownum++)
     {
       int nnz = submat.cols[rownum].size();
@@ -153,25 +167,24 @@ std::list<int> CSRMat::getSumElements() const
 // SpMV1 --
 //        -- y = this * 1 or y = this' * 1
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::SpMV1(bool trans, Vector &y)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::SpMV1(bool trans, Vector &y)
 {
   ///////////////////////////////////////////////////////////////////////////
   // y = this * 1
   ///////////////////////////////////////////////////////////////////////////
   if(trans==false)
   {
+    #pragma omp parallel for schedule(dynamic,ompChunkSize)
     for (int rowID=0; rowID<mLocNumRows; rowID++)
     {
-      y[rowID] = 0;
-    } // end loop over rows
-
-    for(unsigned int submatNum=0; submatNum< mSubmat.size(); submatNum++)
-    {     
-      for (int rowID=0; rowID<mLocNumRows; rowID++)
+      int nnzInRow = 0;
+      for(unsigned int submatNum=0; submatNum< mSubmat.size(); submatNum++)
       {
-        y[rowID] += mSubmat[submatNum].cols[rowID].size();
-      } // end loop over rows
-    }
+        nnzInRow += mSubmat[submatNum].cols[rowID].size();
+      }
+      y[rowID] = nnzInRow;
+    } // end loop over rows
   }
   ///////////////////////////////////////////////////////////////////////////
 
@@ -182,76 +195,178 @@ void CSRMat::SpMV1(bool trans, Vector &y)
   {
 
     //////////////////////////////////////////////////////////////////////
-    // Purely local computation
+    // Choose communication scheme for the partial y elements computed
+    // here for remote processes.  The number of nonzeros in the remote
+    // submatrices bounds the number of (index,count) pairs to be sent.
+    // If the pairs are smaller than the dense partial vectors summed over
+    // all processes, use the sparse encoding.
     //////////////////////////////////////////////////////////////////////
-    const CSRSubmat &submat = mSubmat[mMyRank];
-    int colOffset = mSubmatStartCols[mMyRank];
-
-    for (int rowID=0; rowID<mLocNumRows; rowID++)
+    long long locRemNNZ = 0;
+    for(int submatNum=0; submatNum<mWorldSize; submatNum++)
     {
-      std::vector<int>::const_iterator iter;
-      for(iter=submat.cols[rowID].begin();iter!=submat.cols[rowID].end();++iter)
+      if(submatNum!=mMyRank)
       {
-        y[(*iter)-colOffset]++;
+        for (int rowID=0; rowID<mLocNumRows; rowID++)
+        {
+          locRemNNZ += mSubmat[submatNum].cols[rowID].size();
+        }
       }
-    } // end loop over rows
-    //////////////////////////////////////////////////////////////////////
+    }
 
+    long long globRemNNZ;
+    MPI_Allreduce(&locRemNNZ, &globRemNNZ, 1, MPI_LONG_LONG, MPI_SUM, mComm);
+
+    long long denseVolume = (long long) mWorldSize * (long long) mGlobNumCols;
+    bool useSparse = (2*globRemNNZ < denseVolume);
     //////////////////////////////////////////////////////////////////////
-    // Remote computation
-    //////////////////////////////////////////////////////////////////////
-    MPI_Status status;
 
-    // Contains remote Y values calculated here
-    std::vector<int> sendY;
-    std::vector<int> recvY(y.getSize());
-    for(int phase=1; phase<mWorldSize; phase++)
+    if(useSparse==false)
     {
-      // Will receive data from process src
-      int src = (mMyRank + phase) % mWorldSize;
-      // performing subcalculation for y elements that belows to process dst
-      int dst = (mMyRank + mWorldSize-phase) % mWorldSize;
+      SpMV1TransDense(y);
+    }
+    else
+    {
+      SpMV1TransSparse(y);
+    }
 
-      //////////////////////////////////////////////////////////////
-      // Computation of remote values of y
-      //////////////////////////////////////////////////////////////
+  }
 
-      // Resize vector and initialize to 0
-      sendY.assign(mSubmatNumCols[dst],0);
+  return;
+}
+////////////////////////////////////////////////////////////////////////////////
 
-      const CSRSubmat &submatR = mSubmat[dst];
+////////////////////////////////////////////////////////////////////////////////
+// SpMV1TransDense -- y = this' * 1
+//   -- Partial y elements for all processes are computed into one globally
+//      sized vector and summed/distributed with a single reduce-scatter
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::SpMV1TransDense(Vector &y)
+{
+  std::vector<count_t> sendY(mGlobNumCols,0);
+
+  for(int submatNum=0; submatNum<mWorldSize; submatNum++)
+  {
+    countSubmatCols(mSubmat[submatNum],mLocNumRows,mSubmatStartCols[submatNum],
+                    sendY.data()+mSubmatStartCols[submatNum],mSubmatNumCols[submatNum]);
+  }
 
-      int colOffsetR = mSubmatStartCols[dst];
-      for (int rowID=0; rowID<mLocNumRows; rowID++)
+  MPI_Reduce_scatter(sendY.data(), y.data(), mSubmatNumCols.data(), MPI_INT64_T,
+                     MPI_SUM, mComm);
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// SpMV1TransSparse -- y = this' * 1
+//   -- Nonzero partial y elements for remote processes are sent as
+//      (local index,count) pairs using a single all-to-all exchange
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::SpMV1TransSparse(Vector &y)
+{
+  //////////////////////////////////////////////////////////////////////
+  // Purely local computation
+  //////////////////////////////////////////////////////////////////////
+  y.setScalar(0);
+  countSubmatCols(mSubmat[mMyRank],mLocNumRows,mSubmatStartCols[mMyRank],
+                  y.data(),y.getSize());
+  //////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////
+  // Computation of remote values of y, packed as (index,count) pairs
+  //////////////////////////////////////////////////////////////////////
+  std::vector<int> sendCounts(mWorldSize,0);
+  std::vector<int> sendDispls(mWorldSize,0);
+  std::vector<count_t> sendPairs;
+  std::vector<count_t> partialY;
+
+  for(int dst=0; dst<mWorldSize; dst++)
+  {
+    sendDispls[dst] = sendPairs.size();
+
+    if(dst!=mMyRank)
+    {
+      partialY.assign(mSubmatNumCols[dst],0);
+
+      countSubmatCols(mSubmat[dst],mLocNumRows,mSubmatStartCols[dst],
+                      partialY.data(),partialY.size());
+
+      for(unsigned int i=0; i<partialY.size(); i++)
       {
-        std::vector<int>::const_iterator iter;
-        for(iter=submatR.cols[rowID].begin();iter!=submatR.cols[rowID].end();++iter)
+        if(partialY[i]!=0)
         {
-          sendY[(*iter)-colOffsetR]++;
+          sendPairs.push_back(i);
+          sendPairs.push_back(partialY[i]);
         }
-      } // end loop over rows
-      //////////////////////////////////////////////////////////////
-
-      //////////////////////////////////////////////////////////////
-      // Communication partial y elements to processor that owns those
-      // elements.  Sum into y.
-      //////////////////////////////////////////////////////////////
-      MPI_Sendrecv(sendY.data(), sendY.size(), MPI_INT, dst, 0,
-		   recvY.data(), recvY.size(), MPI_INT, src, 0,
-		   mComm, &status);
-
-      for(unsigned int i=0;i<y.getSize();i++)
-      {
-        y[i] += recvY[i];
       }
-      //////////////////////////////////////////////////////////////
-
     }
-    //////////////////////////////////////////////////////////////////////
 
+    sendCounts[dst] = sendPairs.size() - sendDispls[dst];
   }
+  //////////////////////////////////////////////////////////////////////
 
-  return;
+  //////////////////////////////////////////////////////////////////////
+  // Communicate pairs to processes that own those elements
+  //////////////////////////////////////////////////////////////////////
+  std::vector<int> recvCounts(mWorldSize);
+  std::vector<int> recvDispls(mWorldSize,0);
+
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, mComm);
+
+  for(int src=1; src<mWorldSize; src++)
+  {
+    recvDispls[src] = recvDispls[src-1] + recvCounts[src-1];
+  }
+
+  std::vector<count_t> recvPairs(recvDispls[mWorldSize-1]+recvCounts[mWorldSize-1]);
+
+  MPI_Alltoallv(sendPairs.data(), sendCounts.data(), sendDispls.data(), MPI_INT64_T,
+                recvPairs.data(), recvCounts.data(), recvDispls.data(), MPI_INT64_T,
+                mComm);
+  //////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////
+  // Sum into y
+  //////////////////////////////////////////////////////////////////////
+  unsigned int numPairs = recvPairs.size()/2;
+  for(unsigned int pairIdx=0; pairIdx<numPairs; pairIdx++)
+  {
+    y[recvPairs[2*pairIdx]] += recvPairs[2*pairIdx+1];
+  }
+  //////////////////////////////////////////////////////////////////////
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Counts nonzeros in each column of a submatrix: y[col-colOffset] += 1
+//   -- Each thread counts into a private array that is summed into y
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void countSubmatCols(const CSRSubmat<ordinal_t> &submat, int numRows, ordinal_t colOffset,
+                     count_t *y, int ySize)
+{
+  #pragma omp parallel default(shared)
+  {
+    std::vector<count_t> yloc(ySize,0);
+
+    #pragma omp for schedule(dynamic,ompChunkSize)
+    for (int rowID=0; rowID<numRows; rowID++)
+    {
+      typename std::vector<ordinal_t>::const_iterator iter;
+      for(iter=submat.cols[rowID].begin();iter!=submat.cols[rowID].end();++iter)
+      {
+        yloc[(*iter)-colOffset]++;
+      }
+    } // end loop over rows
+
+    #pragma omp critical
+    {
+      for(int i=0;i<ySize;i++)
+      {
+        y[i] += yloc[i];
+      }
+    }
+  }
 }
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -259,7 +374,8 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 // matmat -- level 3 basic linear algebra subroutine
 //        -- Z = AB where Z = this
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::matmat(const CSRMat<int> &A, const CSRMat &B)
 {
   /////////////////////////////////////////////////////////////////////////
   // set dimensions of matrix, build arrays nnzInRow, vals, cols
@@ -304,57 +420,107 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   ///////////////////////////////////////////////////////////////////////////
   // Structure to hold new nonzeros
   ///////////////////////////////////////////////////////////////////////////
-  std::vector<std::vector<std::map<int,std::list<int> > > > CNZs(mWorldSize);
+  std::vector<std::vector<std::map<ordinal_t,std::list<int> > > > CNZs(mWorldSize);
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Remote submatrices of B are double buffered.  The master thread (the
+  // only thread making MPI calls, MPI_THREAD_FUNNELED) receives the next
+  // submatrix while the other threads multiply the current one.
+  ///////////////////////////////////////////////////////////////////////////
+  int numRemSteps = (mWorldSize-1)*mWorldSize;
+
+  CSRSubmat<ordinal_t> remSubmatB[2];
+  int remStartRowB[2] = {0,0};
+  int remNumRowsB[2] = {0,0};
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
   // Completely local computation
   //       Processor 0's perspective: C(1,*) += A(1,1)*B(1,*)
   ///////////////////////////////////////////////////////////////////////////
-  const CSRSubmat & submatA = A.getSubMatrix(mMyRank);
+  const CSRSubmat<int> & submatA = A.getSubMatrix(mMyRank);
 
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
     CNZs[submatNum].resize(mLocNumRows);
+  }
 
-    const CSRSubmat & submatB = B.getSubMatrix(submatNum);
+  #pragma omp parallel default(shared)
+  {
+    ////////////////////////////////////////////////////////////////////
+    // Master thread communicates submatrix of B for first remote step
+    ////////////////////////////////////////////////////////////////////
+    #pragma omp master
+    {
+      if(numRemSteps>0)
+      {
+        int src = (mMyRank + 1) % mWorldSize;
+        int dst = (mMyRank + mWorldSize-1) % mWorldSize;
 
-    int startRowB = B.getStartRow();
+        sendRecvSubmat(B.getSubMatrix(0),dst,B.getLocNumRows(),B.getStartRow(),
+                       mComm,src,remSubmatB[0],remNumRowsB[0],remStartRowB[0]);
+      }
+    }
+    ////////////////////////////////////////////////////////////////////
 
-    //////////////////////////////////////////////////////////////////////
-    // Updates block: C(myrank,submatNum) += A(myrank,myrank) * B(myrank,submatNum)
-    //////////////////////////////////////////////////////////////////////
-    serialSubmatrixMult(submatA,A.getLocNumRows(),submatB,startRowB,CNZs[submatNum]);
-    //////////////////////////////////////////////////////////////////////
+    for(int submatNum=0; submatNum<mWorldSize; submatNum++)
+    {
+      const CSRSubmat<ordinal_t> & submatB = B.getSubMatrix(submatNum);
+
+      int startRowB = B.getStartRow();
+
+      //////////////////////////////////////////////////////////////////////
+      // Updates block: C(myrank,submatNum) += A(myrank,myrank) * B(myrank,submatNum)
+      //////////////////////////////////////////////////////////////////////
+      serialSubmatrixMult(submatA,A.getLocNumRows(),submatB,startRowB,CNZs[submatNum]);
+      //////////////////////////////////////////////////////////////////////
+    }
   }
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
   // Communication/Partially remote compuation
+  //   -- step enumerates (phase,submatNum) pairs in the original ring order
   ///////////////////////////////////////////////////////////////////////////
-  for(int phase=1; phase<mWorldSize; phase++)
+  for(int step=0; step<numRemSteps; step++)
   {
+    int phase = step/mWorldSize + 1;
+    int submatNum = step%mWorldSize;
     int src = (mMyRank + phase) % mWorldSize;
-    int dst = (mMyRank + mWorldSize-phase) % mWorldSize;
-
-    for(int submatNum=0; submatNum<mWorldSize; submatNum++)
-    {
-      const CSRSubmat & submatBToSend = B.getSubMatrix(submatNum);
 
-      int remStartRowB=0;
-      int remNumRowsB=0;
+    int curBuf = step%2;
+    int nextBuf = (step+1)%2;
 
-      CSRSubmat remSubmatB;
-
-      sendRecvSubmat(submatBToSend,dst,B.getLocNumRows(),B.getStartRow(),
-		     mComm,src,remSubmatB,remNumRowsB,remStartRowB);
+    #pragma omp parallel default(shared)
+    {
+      ////////////////////////////////////////////////////////////////////
+      // Master thread communicates submatrix of B for the next step
+      ////////////////////////////////////////////////////////////////////
+      #pragma omp master
+      {
+        if(step+1<numRemSteps)
+        {
+          int nextPhase = (step+1)/mWorldSize + 1;
+          int nextSubmatNum = (step+1)%mWorldSize;
+          int nextSrc = (mMyRank + nextPhase) % mWorldSize;
+          int nextDst = (mMyRank + mWorldSize-nextPhase) % mWorldSize;
+
+          remSubmatB[nextBuf] = CSRSubmat<ordinal_t>();
+          sendRecvSubmat(B.getSubMatrix(nextSubmatNum),nextDst,B.getLocNumRows(),
+                         B.getStartRow(),mComm,nextSrc,remSubmatB[nextBuf],
+                         remNumRowsB[nextBuf],remStartRowB[nextBuf]);
+        }
+      }
+      ////////////////////////////////////////////////////////////////////
 
-      const CSRSubmat & submatA = A.getSubMatrix(src);
+      const CSRSubmat<int> & submatA = A.getSubMatrix(src);
 
       //////////////////////////////////////////////////////////////////////
       // Updates block: C(myrank,submatNum) += A(myrank,src) * B(src,submatNum)
       //////////////////////////////////////////////////////////////////////
-      serialSubmatrixMult(submatA,A.getLocNumRows(),remSubmatB,remStartRowB,CNZs[submatNum]);
+      serialSubmatrixMult(submatA,A.getLocNumRows(),remSubmatB[curBuf],
+                          remStartRowB[curBuf],CNZs[submatNum]);
       //////////////////////////////////////////////////////////////////////
     }
 
@@ -368,12 +534,12 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   //   This is an optimization for Triangle Enumeration
   //   Algorithm #2
   //////////////////////////////////////////////////////////////////////
-  std::map<int,std::list<int> >::iterator iter;
-
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
+    #pragma omp parallel for schedule(dynamic,ompChunkSize)
     for(int rownum=0;rownum<mLocNumRows;rownum++)
     {
+      typename std::map<ordinal_t,std::list<int> >::iterator iter;
       for (iter=CNZs[submatNum][rownum].begin(); iter!=CNZs[submatNum][rownum].end(); )
       {
         if((*iter).second.size()==1)
@@ -393,14 +559,15 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   ///////////////////////////////////////////////////////////////////////////
   // Copy resulting nonzeros into matrix object
   ///////////////////////////////////////////////////////////////////////////
-  mLocNNZ=0;
+  count_t tmpNNZ=0;
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    CSRSubmat & submatC = mSubmat[submatNum];
+    CSRSubmat<ordinal_t> & submatC = mSubmat[submatNum];
 
+    #pragma omp parallel for schedule(dynamic,ompChunkSize) reduction(+:tmpNNZ)
     for (int rownum=0; rownum<mLocNumRows; rownum++)
     {
-      const std::map<int,std::list<int> > &nzMap = CNZs[submatNum][rownum];
+      const std::map<ordinal_t,std::list<int> > &nzMap = CNZs[submatNum][rownum];
 
       unsigned int nnzInRow = nzMap.size();
 
@@ -417,7 +584,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
        /////////////////////////////////////////
        // Copy new data into row
        /////////////////////////////////////////
-       std::map<int,std::list<int> >::const_iterator iter;
+       typename std::map<ordinal_t,std::list<int> >::const_iterator iter;
        int nzcnt=0;
 
        // Iterate through map
@@ -437,16 +604,17 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 
      /////////////////////////////////////////
 
-     mLocNNZ += nnzInRow;
+     tmpNNZ += nnzInRow;
 
      } // Loop over rows
 
   } // loop over submats
+  mLocNNZ = tmpNNZ;
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ, &mGlobNNZ, 1, MPI_INT, MPI_SUM,mComm);
+  MPI_Allreduce(&mLocNNZ, &mGlobNNZ, 1, MPI_INT64_T, MPI_SUM,mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 
@@ -457,14 +625,18 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 // Multiplies two submatrices together
 // Inserts resulting nonzeros into vector of <col,val> value maps
 ////////////////////////////////////////////////////////////////////////////////
-void serialSubmatrixMult(const CSRSubmat & submatA, int numARows,
-                         const CSRSubmat & submatB, int startRowB,
-                         std::vector<std::map<int,std::list<int> > > & submatCNZs)
+template<typename ordinal_t>
+void serialSubmatrixMult(const CSRSubmat<int> & submatA, int numARows,
+                         const CSRSubmat<ordinal_t> & submatB, int startRowB,
+                         std::vector<std::map<ordinal_t,std::list<int> > > & submatCNZs)
 {
 
   ///////////////////////////////////////////////////////////////////////////
   // Compute matrix entries one row at a time
+  //   -- Orphaned worksharing loop, rows are divided among the threads of the
+  //      enclosing parallel region (runs serially if called outside of one)
   ///////////////////////////////////////////////////////////////////////////
+  #pragma omp for schedule(dynamic,ompChunkSize)
   for (int rownum=0; rownum<numARows; rownum++)
   {
     int nnzInRowA = submatA.cols[rownum].size();
@@ -477,7 +649,7 @@ void serialSubmatrixMult(const CSRSubmat & submatA, int numARows,
 
       for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
       {
-        int colB=submatB.cols[colA-startRowB][nzindxB];
+        ordinal_t colB=submatB.cols[colA-startRowB][nzindxB];
 
 	addNZ(submatCNZs[rownum], colB, colA);
       }
@@ -491,10 +663,11 @@ void serialSubmatrixMult(const CSRSubmat & submatA, int numARows,
 ////////////////////////////////////////////////////////////////////////////////
 // Send/recv submatrix
 ////////////////////////////////////////////////////////////////////////////////
-void sendRecvSubmat(const CSRSubmat &submatToSend, int dst,
+template<typename ordinal_t>
+void sendRecvSubmat(const CSRSubmat<ordinal_t> &submatToSend, int dst,
                     int numRowsSend, int startRowSend,
                     MPI_Comm comm, int src,
-                    CSRSubmat &remSubmat, int &numRowsRecv, int &startRowRecv)
+                    CSRSubmat<ordinal_t> &remSubmat, int &numRowsRecv, int &startRowRecv)
 {
   MPI_Status status;
 
@@ -560,7 +733,7 @@ void sendRecvSubmat(const CSRSubmat &submatToSend, int dst,
     // Is this ok when size==0
     if(nnzInRowRecv[rownum] > 0)
     {
-      MPI_Irecv((remSubmat.cols[rownum].data()),nnzInRowRecv[rownum], MPI_INT,
+      MPI_Irecv((remSubmat.cols[rownum].data()),nnzInRowRecv[rownum], mpiOrdinalType<ordinal_t>(),
 		 src, 0, comm, &(requests[rownum]));
     }
     else
@@ -576,7 +749,7 @@ void sendRecvSubmat(const CSRSubmat &submatToSend, int dst,
     if(nnzInRowSend[rownum] > 0)
     {
       MPI_Send((void *) submatToSend.cols[rownum].data(), nnzInRowSend[rownum],
-	       MPI_INT, dst, 0, comm);
+	       mpiOrdinalType<ordinal_t>(), dst, 0, comm);
     }
   }
 
@@ -620,7 +793,8 @@ void sendRecvSubmat(const CSRSubmat &submatToSend, int dst,
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::readMMMatrix(const char *fname)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::readMMMatrix(const char *fname)
 {
   //////////////////////////////////////////////////////////////
   // Build edge list from MM file                               
@@ -713,7 +887,7 @@ void CSRMat::readMMMatrix(const char *fname)
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
     std::vector< std::map<int,int> > &rowSetsRef = rowSets[submatNum];
-    CSRSubmat &submat = mSubmat[submatNum];
+    CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
 
     for(int rownum=0; rownum<mLocNumRows; rownum++)
     {
@@ -740,7 +914,7 @@ void CSRMat::readMMMatrix(const char *fname)
   ///////////////////////////////////////////////////////////////////////////
   // Sum mLocNNZ over all processes to obtain mGlobNNZ                       
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -748,7 +922,9 @@ void CSRMat::readMMMatrix(const char *fname)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::map<int,int> > & eIndices)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createIncidenceMatrix(const CSRMat<int> &adjMatrix,
+                                                std::map<int,std::map<int,edgeid_t> > & eIndices)
 {
 
    assert(mSubmat.size()==mWorldSize);
@@ -765,15 +941,15 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   // remote processors.  Updating set values is a fairly expensive process, so
   // instead we temporarily use vectors and copy into sets once we have the
   // the edge offsets
-  std::vector<std::vector<int> > tmpColsInRow(mLocNumRows);
+  std::vector<std::vector<ordinal_t> > tmpColsInRow(mLocNumRows);
 
-  std::vector<std::vector<int> > remNZs(mWorldSize);
+  std::vector<std::vector<ordinal_t> > remNZs(mWorldSize);
 
-  int eCnt=0;
+  ordinal_t eCnt=0;
 
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    const CSRSubmat &submat = adjMatrix.getSubMatrix(submatNum);
+    const CSRSubmat<int> &submat = adjMatrix.getSubMatrix(submatNum);
 
     for(int rownum=0; rownum<mLocNumRows; rownum++)
     {
@@ -808,15 +984,15 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   // Determine edge number offset using prefix_sum
   // Determine total number of edges/columns using all_reduce
   ///////////////////////////////////////////////////////////////////////////
-  int eOffset;
-  MPI_Exscan(&eCnt, &eOffset, 1, MPI_INT, MPI_SUM, mComm);
+  ordinal_t eOffset;
+  MPI_Exscan(&eCnt, &eOffset, 1, mpiOrdinalType<ordinal_t>(), MPI_SUM, mComm);
 
   if(mMyRank==0)
   {
     eOffset=0;
   }
 
-  MPI_Allreduce(&eCnt, &mGlobNumCols, 1, MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&eCnt, &mGlobNumCols, 1, mpiOrdinalType<ordinal_t>(), MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
@@ -826,7 +1002,7 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   //////////////////////////////////////////////////////////////////////
   // Adjust vertex pair to edge map
   //////////////////////////////////////////////////////////////////////
-  std::map<int,int>::iterator mapIter;
+  std::map<int,edgeid_t>::iterator mapIter;
 
   for(int rownum=mStartRow; rownum<mStartRow+mLocNumRows; rownum++)
   {
@@ -840,9 +1016,9 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   //////////////////////////////////////////////////////////////////////
   // Adjust edge column ID for local nonzeros
   //////////////////////////////////////////////////////////////////////
-  std::vector<std::set<int> > colsInRow(mLocNumRows);
+  std::vector<std::set<ordinal_t> > colsInRow(mLocNumRows);
 
-  std::vector<int>::const_iterator iter;
+  typename std::vector<ordinal_t>::const_iterator iter;
   for(int rownum=0; rownum<mLocNumRows; rownum++)
   {
     for (iter=tmpColsInRow[rownum].begin();iter!=tmpColsInRow[rownum].end();iter++)
@@ -851,11 +1027,11 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
     }
 
     // free memory of vector
-    std::vector<int>().swap(tmpColsInRow[rownum]);
+    std::vector<ordinal_t>().swap(tmpColsInRow[rownum]);
   }
 
   // free memory of vector
-  std::vector<std::vector<int> >().swap(tmpColsInRow);
+  std::vector<std::vector<ordinal_t> >().swap(tmpColsInRow);
   //////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////
@@ -879,7 +1055,7 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   // Communicate remote nonzeros to process that owns them
   ///////////////////////////////////////////////////////////////////////////
   MPI_Status status;
-  std::vector<int> recvBuffer;
+  std::vector<ordinal_t> recvBuffer;
   for(int phase=1; phase<mWorldSize; phase++)
   {
     int src = (mMyRank + phase) % mWorldSize;
@@ -898,8 +1074,8 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
       if(recvSize!=0)
       {
         recvBuffer.resize(recvSize);
-        MPI_Sendrecv(remNZs[dst].data(), sendSize, MPI_INT, dst, 0, 
-		     recvBuffer.data(), recvSize, MPI_INT, src, 0,
+        MPI_Sendrecv(remNZs[dst].data(), sendSize, mpiOrdinalType<ordinal_t>(), dst, 0, 
+		     recvBuffer.data(), recvSize, mpiOrdinalType<ordinal_t>(), src, 0,
 		     mComm, &status);
 
         unsigned int nnz=recvSize/2;
@@ -907,13 +1083,13 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
         for(unsigned int nzIdx=0; nzIdx<nnz; nzIdx++)
 	{
           int rIdx= recvBuffer[2*nzIdx];
-          int cIdx= recvBuffer[2*nzIdx+1];
+          ordinal_t cIdx= recvBuffer[2*nzIdx+1];
           colsInRow[rIdx-mStartRow].insert(cIdx);
 	}
       }
       else
       {
-        MPI_Send(remNZs[dst].data(), sendSize, MPI_INT, dst, 0, mComm);
+        MPI_Send(remNZs[dst].data(), sendSize, mpiOrdinalType<ordinal_t>(), dst, 0, mComm);
       }
 
     }
@@ -921,14 +1097,14 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
     else if(recvSize!=0)
     {
       recvBuffer.resize(recvSize);
-      MPI_Recv(recvBuffer.data(), recvSize, MPI_INT, src, 0, mComm, &status);
+      MPI_Recv(recvBuffer.data(), recvSize, mpiOrdinalType<ordinal_t>(), src, 0, mComm, &status);
 
       unsigned int nnz=recvSize/2;
 
       for(unsigned int nzIdx=0; nzIdx<nnz; nzIdx++)
       {
         int rIdx= recvBuffer[2*nzIdx];
-        int cIdx= recvBuffer[2*nzIdx+1];
+        ordinal_t cIdx= recvBuffer[2*nzIdx+1];
         colsInRow[rIdx-mStartRow].insert(cIdx);
       }
     }
@@ -976,10 +1152,10 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
 
     mLocNNZ += nnzToAdd;
 
-    std::set<int>::const_iterator iter;
+    typename std::set<ordinal_t>::const_iterator iter;
     for (iter=colsInRow[rownum].begin();iter!=colsInRow[rownum].end();iter++)
     {
-      int col = (*iter);
+      ordinal_t col = (*iter);
 
       int submatNum = whichSubMatrix(col);
 
@@ -993,7 +1169,7 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
   ///////////////////////////////////////////////////////////////////////////
   // Sum mLocNNZ over all processes to obtain mGlobNNZ                       
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -1002,9 +1178,10 @@ void CSRMat::createIncidenceMatrix(const CSRMat &adjMatrix, std::map<int,std::ma
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd)
 {
-  std::map<int,std::list<int> >::iterator it;
+  typename std::map<ordinal_t,std::list<int> >::iterator it;
 
   it = nzMap.find(col);
 
@@ -1019,7 +1196,7 @@ int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
 
   std::list<int> newList;
   newList.push_back(elemToAdd);
-  nzMap.insert(std::pair<int,std::list<int> >(col, newList));
+  nzMap.insert(std::pair<ordinal_t,std::list<int> >(col, newList));
   return 1;
 }
 //////////////////////////////////////////////////////////////////////////////
@@ -1029,17 +1206,18 @@ int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
 // Compute K counts
 //
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
-                            std::map<int,std::map<int,int> > & edgeInds,
-                            std::vector<int> &kCounts)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
+                            std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                            std::vector<count_t> &kCounts)
 {
-  std::vector<int> locKCounts(kCounts.size());
+  std::vector<count_t> locKCounts(kCounts.size());
 
   // Map of vertices in local triangles to vertex triangle degrees
-  std::map<int,int> tvMap;
+  std::map<int,count_t> tvMap;
 
   // Map of pairs of vertices in local triangles to vertex edge degrees
-  std::map<int,std::map<int,int> > teMap;
+  std::map<int,std::map<int,count_t> > teMap;
 
 
   // Vertex triangle degrees for vertices in local triangles that are owned
@@ -1052,7 +1230,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
   ///////////////////////////////////////////////////////////////////////////
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    const CSRSubmat &submat = mSubmat[submatNum];
+    const CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
 
     for (int rownum=0; rownum<mLocNumRows; rownum++)
     {
@@ -1100,7 +1278,8 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
   // Communicate Tv to remote processes that need it
   ///////////////////////////////////////////////////////////////////////////
   std::vector<int> recvV;
-  std::vector<int> recvTv;
+  std::vector<count_t> sendTv;
+  std::vector<count_t> recvTv;
   MPI_Status status;
   for(int phase=1; phase<mWorldSize; phase++)
   {
@@ -1131,9 +1310,10 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         ////////////////////////////////////////////////////////////
         // Fill buffer with Tv corresponding to vertices
         ////////////////////////////////////////////////////////////
+        sendTv.resize(recvSize);
         for(int indx=0; indx<recvSize; indx++)
 	{
-          recvV[indx] = vTriDegrees[recvV[indx]-mStartRow];
+          sendTv[indx] = vTriDegrees[recvV[indx]-mStartRow];
         } 
         ////////////////////////////////////////////////////////////
 
@@ -1142,8 +1322,8 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         ////////////////////////////////////////////////////////////
         recvTv.resize(sendSize);
        
-	MPI_Sendrecv(recvV.data(), recvSize, MPI_INT, src, 0,
-		     recvTv.data(), sendSize, MPI_INT, dst, 0,
+	MPI_Sendrecv(sendTv.data(), recvSize, MPI_INT64_T, src, 0,
+		     recvTv.data(), sendSize, MPI_INT64_T, dst, 0,
 		     mComm, &status);
         ////////////////////////////////////////////////////////////
 
@@ -1168,7 +1348,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         // 2. Insert v/Tv pairs into map
         ////////////////////////////////////////////////////////////
         recvTv.resize(sendSize);
-	MPI_Recv(recvTv.data(), sendSize, MPI_INT, dst, 0,
+	MPI_Recv(recvTv.data(), sendSize, MPI_INT64_T, dst, 0,
 		 mComm, &status);
 
         for(int indx=0; indx<sendSize; indx++)
@@ -1193,11 +1373,12 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       // 1. Fill buffer with Tv corresponding to vertices
       // 2. Send corresponding Tv values to proc that needs them
       ////////////////////////////////////////////////////////////
+      sendTv.resize(recvSize);
       for(int indx=0; indx<recvSize; indx++)
       {
-        recvV[indx] = vTriDegrees[recvV[indx]-mStartRow];
+        sendTv[indx] = vTriDegrees[recvV[indx]-mStartRow];
       } 
-      MPI_Send(recvV.data(), recvSize, MPI_INT, src, 0, mComm);
+      MPI_Send(sendTv.data(), recvSize, MPI_INT64_T, src, 0, mComm);
       ////////////////////////////////////////////////////////////
     }
   }
@@ -1217,12 +1398,12 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
   // Communication needed to find corresponding edge ids
   std::vector<std::vector<int> > eIDtoFind(mWorldSize);
 
-  std::vector<std::vector<int> > remEIDs(mWorldSize);
+  std::vector<std::vector<edgeid_t> > remEIDs(mWorldSize);
   std::vector<std::vector<edge_t> > remEdges(mWorldSize);
 
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    const CSRSubmat &submat = mSubmat[submatNum];
+    const CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
 
     for (int rownum=0; rownum<mLocNumRows; rownum++)
     {
@@ -1249,7 +1430,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	    if(mMyRank==p2) // local vertex
 	    {
               // edge v2,v3
-              int eID1 = edgeInds.find(v2)->second.find(v3)->second;
+              edgeid_t eID1 = edgeInds.find(v2)->second.find(v3)->second;
               int submat1 = whichSubMatrix(eID1);
               if(submat1 == mMyRank)
 	      {
@@ -1266,7 +1447,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	      }
 
               // edge v2,v1
- 	      int eID2 = edgeInds.find(v2)->second.find(v1)->second;
+ 	      edgeid_t eID2 = edgeInds.find(v2)->second.find(v1)->second;
               int submat2 = whichSubMatrix(eID2);
               if(submat2 == mMyRank)
 	      {
@@ -1298,7 +1479,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
             if(p3==mMyRank)
 	    {
               // edge v3,v1
-              int eID3 = edgeInds.find(v3)->second.find(v1)->second;
+              edgeid_t eID3 = edgeInds.find(v3)->second.find(v1)->second;
 
               int submat3 = whichSubMatrix(eID3);
               if(submat3 == mMyRank)
@@ -1333,7 +1514,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	    if(mMyRank==p3) // local vertex
 	    {
               // edge v3,v2
-              int eID1 = edgeInds.find(v3)->second.find(v2)->second;
+              edgeid_t eID1 = edgeInds.find(v3)->second.find(v2)->second;
               int submat1 = whichSubMatrix(eID1);
               if(submat1 == mMyRank)
 	      {
@@ -1350,7 +1531,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	      }
 
               // edge v3,v1
- 	      int eID2 = edgeInds.find(v3)->second.find(v1)->second;
+ 	      edgeid_t eID2 = edgeInds.find(v3)->second.find(v1)->second;
               int submat2 = whichSubMatrix(eID2);
               if(submat2 == mMyRank)
 	      {
@@ -1381,7 +1562,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
             if(p2==mMyRank)
 	    {
               // edge v2,v1
-              int eID3 = edgeInds.find(v2)->second.find(v1)->second;
+              edgeid_t eID3 = edgeInds.find(v2)->second.find(v1)->second;
 
               int submat3 = whichSubMatrix(eID3);
               if(submat3 == mMyRank)
@@ -1419,8 +1600,8 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
   ///////////////////////////////////////////////////////////////////////////
   std::vector<int> recvVPairs;
 
-  std::vector<int> sendEIDs;
-  std::vector<int> recvEIDs;
+  std::vector<edgeid_t> sendEIDs;
+  std::vector<edgeid_t> recvEIDs;
   for(int phase=1; phase<mWorldSize; phase++)
   {
     int src = (mMyRank + phase) % mWorldSize;
@@ -1467,8 +1648,8 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         int recvSize2 = sendSize/2;
         recvEIDs.resize(recvSize2);
        
-	MPI_Sendrecv(sendEIDs.data(), sendSize2, MPI_INT, src, 0,
-		     recvEIDs.data(), recvSize2, MPI_INT, dst, 0,
+	MPI_Sendrecv(sendEIDs.data(), sendSize2, MPI_INT64_T, src, 0,
+		     recvEIDs.data(), recvSize2, MPI_INT64_T, dst, 0,
 		     mComm, &status);
         ////////////////////////////////////////////////////////////
 
@@ -1513,7 +1694,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         int recvSize2 = sendSize/2;
         recvEIDs.resize(recvSize2);
        
-	MPI_Recv(recvEIDs.data(), recvSize2, MPI_INT, dst, 0,
+	MPI_Recv(recvEIDs.data(), recvSize2, MPI_INT64_T, dst, 0,
 		 mComm, &status);
         ////////////////////////////////////////////////////////////
 
@@ -1571,7 +1752,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       ////////////////////////////////////////////////////////////
       // Send corresponding EIDs
       ////////////////////////////////////////////////////////////
-      MPI_Send(sendEIDs.data(), sendSize2, MPI_INT, src, 0,
+      MPI_Send(sendEIDs.data(), sendSize2, MPI_INT64_T, src, 0,
 	       mComm);
       ////////////////////////////////////////////////////////////
 
@@ -1584,8 +1765,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
   ///////////////////////////////////////////////////////////////////////////
   // Communicate edge triangle degrees to remote processes that need it
   ///////////////////////////////////////////////////////////////////////////
-  std::vector<int> sendEDegrees;
-  std::vector<int> recvEDegrees;
+  std::vector<count_t> recvEDegrees;
   for(int phase=1; phase<mWorldSize; phase++)
   {
     int src = (mMyRank + phase) % mWorldSize;
@@ -1608,15 +1788,15 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         // Sendrecv eIDs that belong to remote process
         ////////////////////////////////////////////////////////////
         recvEIDs.resize(recvSize);
-	MPI_Sendrecv(remEIDs[dst].data(), sendSize, MPI_INT, dst, 0,
-		     recvEIDs.data(), recvSize, MPI_INT, src, 0,
+	MPI_Sendrecv(remEIDs[dst].data(), sendSize, MPI_INT64_T, dst, 0,
+		     recvEIDs.data(), recvSize, MPI_INT64_T, src, 0,
 		     mComm, &status);
         ////////////////////////////////////////////////////////////
 
         ////////////////////////////////////////////////////////////
         // Fill buffer with E triangle degrees corresponding to EIDs
         ////////////////////////////////////////////////////////////
-	std::vector<int> &sendEDegrees = recvEIDs; 
+	std::vector<count_t> &sendEDegrees = recvEIDs; 
         int sendSize2 = recvSize;
         for(int indx=0; indx<sendSize2; indx++)
 	{
@@ -1630,8 +1810,8 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         int recvSize2 = sendSize;
         recvEDegrees.resize(recvSize2);
        
-	MPI_Sendrecv(sendEDegrees.data(), sendSize2, MPI_INT, src, 0,
-		     recvEDegrees.data(), recvSize2, MPI_INT, dst, 0,
+	MPI_Sendrecv(sendEDegrees.data(), sendSize2, MPI_INT64_T, src, 0,
+		     recvEDegrees.data(), recvSize2, MPI_INT64_T, dst, 0,
 		     mComm, &status);
         ////////////////////////////////////////////////////////////
 
@@ -1652,7 +1832,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         ////////////////////////////////////////////////////////////
         // Send eIDs that belong to remote process
         ////////////////////////////////////////////////////////////
-	MPI_Send(remEIDs[dst].data(), sendSize, MPI_INT, dst, 0,
+	MPI_Send(remEIDs[dst].data(), sendSize, MPI_INT64_T, dst, 0,
 		 mComm);
         ////////////////////////////////////////////////////////////
 
@@ -1662,7 +1842,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
         int recvSize2 = sendSize;
         recvEDegrees.resize(recvSize2);
        
-	MPI_Recv(recvEDegrees.data(), recvSize2, MPI_INT, dst, 0,
+	MPI_Recv(recvEDegrees.data(), recvSize2, MPI_INT64_T, dst, 0,
 		 mComm, &status);
         ////////////////////////////////////////////////////////////
 
@@ -1687,13 +1867,13 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       // Recv eIDs that belong to remote process
       ////////////////////////////////////////////////////////////
       recvEIDs.resize(recvSize);
-      MPI_Recv(recvEIDs.data(), recvSize, MPI_INT, src, 0, mComm, &status);
+      MPI_Recv(recvEIDs.data(), recvSize, MPI_INT64_T, src, 0, mComm, &status);
       ////////////////////////////////////////////////////////////
 
       ////////////////////////////////////////////////////////////
       // Fill buffer with E triangle degrees corresponding to EIDs
       ////////////////////////////////////////////////////////////
-      std::vector<int> &sendEDegrees = recvEIDs; 
+      std::vector<count_t> &sendEDegrees = recvEIDs; 
       int sendSize2 = recvSize;
       for(int indx=0; indx<sendSize2; indx++)
       {
@@ -1704,7 +1884,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       ////////////////////////////////////////////////////////////
       // Send corresponding E triangle degrees
       ////////////////////////////////////////////////////////////
-      MPI_Send(sendEDegrees.data(), sendSize2, MPI_INT, src, 0, mComm);
+      MPI_Send(sendEDegrees.data(), sendSize2, MPI_INT64_T, src, 0, mComm);
       ////////////////////////////////////////////////////////////
     }
   }
@@ -1712,11 +1892,17 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 
   ///////////////////////////////////////////////////////////////////////////
   // Loop over all triangles on process, compute kcount
+  //   -- tvMap and teMap are complete at this point and only read here
   ///////////////////////////////////////////////////////////////////////////
+  #pragma omp parallel default(shared)
+  {
+  std::vector<count_t> threadKCounts(locKCounts.size(),0);
+
   for(int submatNum=0; submatNum<mWorldSize; submatNum++)
   {
-    const CSRSubmat &submat = mSubmat[submatNum];
+    const CSRSubmat<ordinal_t> &submat = mSubmat[submatNum];
 
+    #pragma omp for schedule(dynamic,ompChunkSize) nowait
     for (int rownum=0; rownum<mLocNumRows; rownum++)
     {
       unsigned int nnz=submat.cols[rownum].size();
@@ -1734,15 +1920,15 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
           ////////////////////////////////////////////////////////////////////
 	  // Find tvMin
 	  ////////////////////////////////////////////////////////////////////
-	  int vDegree1 = tvMap.find(v1)->second;
-	  int vDegree2 = tvMap.find(v2)->second;
-	  int vDegree3 = tvMap.find(v3)->second;
+	  count_t vDegree1 = tvMap.find(v1)->second;
+	  count_t vDegree2 = tvMap.find(v2)->second;
+	  count_t vDegree3 = tvMap.find(v3)->second;
 
 	  // BUG FIX
 // 	  unsigned int tvMin = std::min(std::min(vTriDegrees[v1],vTriDegrees[v2]),
 // 					vTriDegrees[v3]);
-	  unsigned int tvMin = std::min(std::min(vDegree1,vDegree2),
-					vDegree3);
+	  count_t tvMin = std::min(std::min(vDegree1,vDegree2),
+				   vDegree3);
 	  ////////////////////////////////////////////////////////////////////
 
 
@@ -1751,7 +1937,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	  /////////////////////////////////////////////////////////////////////////
 
 	  // I believe that v2<v3 by construction
-	  int eDegree1,eDegree2,eDegree3;
+	  count_t eDegree1,eDegree2,eDegree3;
 	  if(v2<v3)
 	  {
 	    eDegree1 = teMap.find(v2)->second.find(v3)->second;
@@ -1765,14 +1951,14 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	    eDegree3 = teMap.find(v2)->second.find(v1)->second;
 	  }
 
- 	  unsigned int teMin = std::min(std::min(eDegree1,eDegree2),eDegree3);
+ 	  count_t teMin = std::min(std::min(eDegree1,eDegree2),eDegree3);
 	  /////////////////////////////////////////////////////////////////////////
 
 	  /////////////////////////////////////////////////////////////////////////
 	  // Determine k count for triangle                                        
 	  /////////////////////////////////////////////////////////////////////////
 	  unsigned int maxK=3;
-	  for(unsigned int k=3; k<locKCounts.size(); k++)
+	  for(unsigned int k=3; k<threadKCounts.size(); k++)
 	  {
 	    if(tvMin >= choose2(k-1) && teMin >= k-2)
 	    {
@@ -1783,17 +1969,26 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
 	      break;
 	    }
           }
-	  locKCounts[maxK]++;
+	  threadKCounts[maxK]++;
 	  /////////////////////////////////////////////////////////////////////////
 	}
       }
     }
   }
+
+  #pragma omp critical
+  {
+    for(unsigned int j=0;j<locKCounts.size();j++)
+    {
+      locKCounts[j] += threadKCounts[j];
+    }
+  }
+  } // pragma parallel
   ///////////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(locKCounts.data(), kCounts.data(), kCounts.size(), MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(locKCounts.data(), kCounts.data(), kCounts.size(), MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -1817,7 +2012,8 @@ unsigned int choose2(unsigned int k)
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-int CSRMat::whichSubMatrix(int colID)
+template<typename ordinal_t>
+int CSRMat<ordinal_t>::whichSubMatrix(ordinal_t colID)
 {
   for(int i=1; i<mWorldSize; i++)
     {
@@ -1836,7 +2032,8 @@ int CSRMat::whichSubMatrix(int colID)
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-int CSRMat::rowOnWhichProc(int rowID)
+template<typename ordinal_t>
+int CSRMat<ordinal_t>::rowOnWhichProc(int rowID)
 {
   for(int i=1; i<mWorldSize; i++)
     {
@@ -1852,3 +2049,10 @@ int CSRMat::rowOnWhichProc(int rowID)
   return mWorldSize-1;
 }
 //////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex ID (adjacency) and edge ID (incidence, triangle) matrices
+////////////////////////////////////////////////////////////////////////////////
+template class CSRMat<int>;
+template class CSRMat<edgeid_t>;
+////////////////////////////////////////////////////////////////////////////////
@@ -62,41 +62,53 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI} matrixtype;
 #include <mpi.h>
 
 #include "mmUtil.h"
+#include "miniTriDefs.h"
 
 class Vector;
 
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
 struct CSRSubmat
 {
-  std::vector<std::vector<int> > cols;  //columns of nonzeros                                
+  std::vector<std::vector<ordinal_t> > cols;  //columns of nonzeros                          
   std::vector<std::vector<int> > vals;  //values of nonzeros                                 
   std::vector<std::vector<int> > vals2; //values of nonzeros                                 
 };
 //////////////////////////////////////////////////////////////////////////////
 
-
+//////////////////////////////////////////////////////////////////////////////
+// MPI datatype of column IDs
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t> MPI_Datatype mpiOrdinalType();
+template<> inline MPI_Datatype mpiOrdinalType<int>() { return MPI_INT; }
+template<> inline MPI_Datatype mpiOrdinalType<int64_t>() { return MPI_INT64_T; }
+//////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
+//    -- ordinal_t is the column ID type: int for the adjacency matrix and
+//       its triangular parts (vertex IDs), edgeid_t for the incidence
+//       matrix and the triangle matrix (edge IDs)
 //////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
 class CSRMat 
 {
 
  private:
   matrixtype type;
   int mGlobNumRows;   //number of global rows
-  int mGlobNumCols;   //number of global cols
-  int mGlobNNZ;       //number of global nonzeros
+  ordinal_t mGlobNumCols;   //number of global cols
+  count_t mGlobNNZ;   //number of global nonzeros
   int mLocNumRows;
-  int mLocNNZ;
+  count_t mLocNNZ;
   int mStartRow;
   std::vector<int> mStartRowOnProc;
 
-  std::vector<CSRSubmat> mSubmat;
+  std::vector<CSRSubmat<ordinal_t> > mSubmat;
   std::vector<int> mSubmatNumCols;
-  std::vector<int> mSubmatStartCols;
+  std::vector<ordinal_t> mSubmatStartCols;
 
   // MPI info
   MPI_Comm mComm;
@@ -142,7 +154,7 @@ class CSRMat
   //////////////////////////////////////////////////////////////////////////
   // constructor -- allocates memory for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-  CSRMat(int _m, int _n, MPI_Comm _comm, bool allocateVals2=false)
+  CSRMat(int _m, ordinal_t _n, MPI_Comm _comm, bool allocateVals2=false)
     :type(UNDEFINED),mGlobNumRows(_m),mGlobNumCols(_n),mGlobNNZ(0),
      mComm(_comm)
   {
@@ -225,10 +237,10 @@ class CSRMat
   int getGlobNumRows() const { return mGlobNumRows;};
 
   // returns the global number of cols
-  int getGlobNumCols() const { return mGlobNumCols;};
+  ordinal_t getGlobNumCols() const { return mGlobNumCols;};
 
   // returns the global number of cols
-  int getGlobNNZ() const { return mGlobNNZ;};
+  count_t getGlobNNZ() const { return mGlobNNZ;};
 
   // returns the local number of cols
   int getLocNumRows() const { return mLocNumRows;};
@@ -247,10 +259,10 @@ class CSRMat
   {return mSubmat[submatNum].cols[rnum].size();};
 
   // returns column # for nonzero in row rowi at index nzindx
-  inline int getCol(int submatNum, int rowi, int nzindx) const
+  inline ordinal_t getCol(int submatNum, int rowi, int nzindx) const
   {return mSubmat[submatNum].cols[rowi][nzindx];};
 
-  inline const CSRSubmat & getSubMatrix(int submatNum) const
+  inline const CSRSubmat<ordinal_t> & getSubMatrix(int submatNum) const
   { return mSubmat[submatNum]; }
 
 
@@ -264,7 +276,7 @@ class CSRMat
     return false;
   }
 
-  int  whichSubMatrix(int colID);
+  int  whichSubMatrix(ordinal_t colID);
   int  rowOnWhichProc(int rowID);
 
 
@@ -272,20 +284,25 @@ class CSRMat
 
   void SpMV1(bool trans, Vector &y);
 
+  // y = this' * 1 communication schemes used by SpMV1
+  void SpMV1TransDense(Vector &y);
+  void SpMV1TransSparse(Vector &y);
+
   //////////////////////////////////////////////////////////////////
   // level 3 basic linear algebra subroutines
   //////////////////////////////////////////////////////////////////
-  void matmat(const CSRMat &A, const CSRMat &B);
+  void matmat(const CSRMat<int> &A, const CSRMat &B);
   //////////////////////////////////////////////////////////////////
 
   void computeKCounts(const Vector &vTriDegrees, const Vector &eTriDegrees,
-                      std::map<int,std::map<int,int> > & edgeInds,
-                      std::vector<int> &kCounts);
+                      std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                      std::vector<count_t> &kCounts);
 
   void readMMMatrix(const char* fname);
   void readBinMatrix(const char* fname);
 
-  void createIncidenceMatrix(const CSRMat &matrix, std::map<int,std::map<int,int> > & eIndices);
+  void createIncidenceMatrix(const CSRMat<int> &matrix,
+                             std::map<int,std::map<int,edgeid_t> > & eIndices);
   //////////////////////////////////////////////////////////////////////////
 
 };
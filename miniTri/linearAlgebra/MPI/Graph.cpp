@@ -91,7 +91,7 @@ void Graph::triangleEnumerate()
 
   gettimeofday(&t1, NULL);
 
-  CSRMat B(mComm);
+  CSRMat<edgeid_t> B(mComm);
   B.createIncidenceMatrix(mMatrix,mEdgeIndices);
 
   gettimeofday(&t2, NULL);
@@ -123,7 +123,8 @@ void Graph::triangleEnumerate()
     std::cout << "C = A*B: " << std::endl;
   }
 
-  std::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getGlobNumRows(),B.getGlobNumCols(),mComm,true));
+  std::shared_ptr<CSRMat<edgeid_t> > C(new CSRMat<edgeid_t>(mMatrix.getGlobNumRows(),B.getGlobNumCols(),
+                                                            mComm,true));
 
   MPI_Barrier(mComm);
   gettimeofday(&t1, NULL);
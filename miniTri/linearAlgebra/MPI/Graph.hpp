@@ -72,19 +72,19 @@ class Graph
   std::string mFilename;
 
   int mNumVerts;
-  int mNumEdges;
-  CSRMat mMatrix;
+  count_t mNumEdges;
+  CSRMat<int> mMatrix;
 
-  int mNumTriangles;
-  std::shared_ptr<CSRMat> mTriMat;
+  count_t mNumTriangles;
+  std::shared_ptr<CSRMat<edgeid_t> > mTriMat;
 
-  std::map<int,std::map<int,int> > mEdgeIndices;
+  std::map<int,std::map<int,edgeid_t> > mEdgeIndices;
 
   Vector mVTriDegrees;
   Vector mETriDegrees;
 
   // K-count frequency table
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
 
   // MPI info
   MPI_Comm mComm;
@@ -159,7 +159,7 @@ class Graph
   void calculateKCounts();
 
   void printTriangles() const;
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
 
   void printKCounts();
 
@@ -56,6 +56,8 @@
 #include <vector>
 #include <mpi.h>
 
+#include "miniTriDefs.h"
+
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
 //////////////////////////////////////////////////////////////////////////////
@@ -64,7 +66,7 @@ class Vector
 
  private:
 
-  std::vector<int> mElements;                             // elements in vector
+  std::vector<count_t> mElements;                         // elements in vector
   MPI_Comm mComm;
   int mWorldSize;
   int mMyRank;
@@ -85,7 +87,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // constructor -- allocates memory for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-  Vector(int _m, MPI_Comm _comm)
+  Vector(int64_t _m, MPI_Comm _comm)
     :mElements(_m), mComm(_comm)
   {
     MPI_Comm_size(mComm,&mWorldSize);
@@ -115,13 +117,13 @@ class Vector
   //////////////////////////////////////////////////////////////////
 
   // returns the number of rows
-  unsigned int getSize() const { return mElements.size();};
+  int64_t getSize() const { return mElements.size();};
 
 
   //////////////////////////////////////////////////////////////////////////
   // v[i] operator -- accessor for elements in vector
   //////////////////////////////////////////////////////////////////////////
-  int & operator [](int indx)
+  count_t & operator [](int64_t indx)
   {
     return mElements[indx];
   }
@@ -130,15 +132,24 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // v[i] operator -- accessor for elements in vector
   //////////////////////////////////////////////////////////////////////////
-  const int & operator [](int indx) const
+  const count_t & operator [](int64_t indx) const
   {
     return mElements[indx];
   }
   //////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////
+  // pointer to underlying elements, for use in MPI calls
+  //////////////////////////////////////////////////////////////////////////
+  count_t * data()
+  {
+    return mElements.data();
+  }
+  //////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////
-  void resize(int _m)
+  void resize(int64_t _m)
   {
     mElements.resize(_m);
   }
@@ -147,7 +158,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // setVal -- function sets all elements to be alpha
   //////////////////////////////////////////////////////////////////////////
-  void setScalar(int alpha) 
+  void setScalar(count_t alpha) 
   {
     for(unsigned int i=0;i<mElements.size();i++)
     {
@@ -54,6 +54,7 @@
 #include <cassert>
 
 #include <mpi.h>
+#include <omp.h>
 
 #include "Graph.hpp"
 
@@ -61,11 +62,27 @@
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  MPI_Init(&argc,&argv);
+  ///////////////////////////////////////////////////////////////////////
+  // Hybrid MPI+OpenMP: threads only work on local data, all MPI calls are
+  // made by the master thread (number of threads set by OMP_NUM_THREADS)
+  ///////////////////////////////////////////////////////////////////////
+  int provided;
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_FUNNELED,&provided);
 
   int myrank;
   MPI_Comm_rank(MPI_COMM_WORLD,&myrank);
 
+  if(provided < MPI_THREAD_FUNNELED)
+  {
+    if(myrank==0)
+    {
+      std::cerr << "MPI implementation does not support MPI_THREAD_FUNNELED" << std::endl;
+    }
+    MPI_Finalize();
+    return 1;
+  }
+  ///////////////////////////////////////////////////////////////////////
+
   if(argc!=2 && argc!=3)
   {
     std::cerr << "Usage: miniTri matrixFile [fileformat ={MM || Bin}]" << std::endl;
@@ -96,6 +113,14 @@ int main(int argc, char *argv[])
   }
 
 
+  if(myrank==0)
+  {
+    int numRanks;
+    MPI_Comm_size(MPI_COMM_WORLD,&numRanks);
+    std::cout << "Number of MPI ranks: " << numRanks
+              << ", OpenMP threads per rank: " << omp_get_max_threads() << std::endl;
+  }
+
   Graph g(mat,isBinFile,MPI_COMM_WORLD);
 
   g.triangleEnumerate();
@@ -56,25 +56,50 @@
 #include <list>
 #include <map>
 #include <set>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
+#include <omp.h>
+
 #include "CSRMatrix.h"
+#include "CompressedCSRMatrix.h"
 #include "Vector.h"
 #include "mmUtil.h"
 #include "mmio.h"
 #include "binFileReader.h"
+#include "triSinkUtil.h"
 
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd);
 
 unsigned int choose2(unsigned int k);
 
+//////////////////////////////////////////////////////////////////////////////
+// decrementSupport -- lowers support of edge, adds it to next once it
+//                     falls to level
+//////////////////////////////////////////////////////////////////////////////
+inline void decrementSupport(edgeid_t edge, int level, std::vector<int> &support,
+                             std::vector<edgeid_t> &next)
+{
+  int oldSupport;
+#pragma omp atomic capture
+  oldSupport = support[edge]--;
+
+  if(oldSupport==level+1)
+  {
+    next.push_back(edge);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
 
 //////////////////////////////////////////////////////////////////////////////
 // print function -- outputs matrix to file
 //                -- accepts optional filename, "CSRmatrix.out" default name
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::print() const
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::print() const
 {
   std::cout << "Matrix: " << m << " " << n << " " << nnz << std::endl;
 
@@ -99,7 +124,8 @@ void CSRMat::print() const
 // Sums matrix elements
 //    -- All this matrix elementals will be of size 2
 ////////////////////////////////////////////////////////////////////////////////
-std::list<int> CSRMat::getSumElements() const
+template<typename ordinal_t>
+std::list<int> CSRMat<ordinal_t>::getSumElements() const
 {
   std::list<int> matList;
 
@@ -126,7 +152,8 @@ std::list<int> CSRMat::getSumElements() const
 // SpMV1 --                                                                     
 //        -- y = this * 1 or y = this' * 1                                      
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::SpMV1(bool trans, Vector &y)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::SpMV1(bool trans, Vector &y)
 {
   m = this->getM();
 
@@ -152,7 +179,7 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 
 	for(int nzindx=0; nzindx<NNZinRow; nzindx++)
         {
-	  int colA=cols[rowID][nzindx];
+	  ordinal_t colA=cols[rowID][nzindx];
 	  yloc.setVal(colA,yloc[colA]+1);
 	}
       } // end loop over rows
@@ -160,7 +187,7 @@ void CSRMat::SpMV1(bool trans, Vector &y)
       // Atomics might be a more efficient way to go
       #pragma omp critical
       {
-        for(int j=0;j<yloc.getSize();j++)
+        for(int64_t j=0;j<yloc.getSize();j++)
 	{
           y.setVal(j,y[j]+yloc[j]);
 	}
@@ -177,7 +204,9 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 // matmat -- level 3 basic linear algebra subroutine  
 //        -- Z = AB where Z = this
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
+template<typename ordinal_t>
+template<typename MatA>
+void CSRMat<ordinal_t>::matmatImpl(const MatA &A, const CSRMat &B)
 {
   //////////////////////////////////////////////////////////
   // set dimensions of matrix, build arrays nnzInRow, vals, cols
@@ -200,24 +229,26 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   ///////////////////////////////////////////////////////////////////////////
   nnz =0;
 
-  int tmpNNZ =0;
+  count_t tmpNNZ =0;
   #pragma omp parallel for schedule(dynamic,mBlockSize), reduction (+:tmpNNZ)
   for (int rownum=0; rownum<m; rownum++)
   {
     nnzInRow[rownum]=0;
-    std::map<int,std::list<int> > newNZs;
+    std::map<ordinal_t,std::list<int> > newNZs;
 
+    std::vector<int> rowBufA;
     int nnzInRowA = A.getNNZInRow(rownum);
+    const int *colsA = A.getRowCols(rownum, rowBufA);
 
     for(int nzindxA=0; nzindxA<nnzInRowA; nzindxA++)
     {
-      int colA=A.getCol(rownum, nzindxA);
+      int colA=colsA[nzindxA];
 
       int nnzInRowB = B.getNNZInRow(colA);
 
       for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
       {
-        int colB=B.getCol(colA, nzindxB);
+        ordinal_t colB=B.getCol(colA, nzindxB);
 
         nnzInRow[rownum] += addNZ(newNZs,colB, colA);
       }
@@ -228,7 +259,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
     //   This is an optimization for Triangle Enumeration
     //   Algorithm #2
     /////////////////////////////////////////////////
-    std::map<int,std::list<int> >::iterator iter;
+    typename std::map<ordinal_t,std::list<int> >::iterator iter;
 
     for (iter=newNZs.begin(); iter!=newNZs.end(); )
     {
@@ -260,7 +291,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
       /////////////////////////////////////////
       //Copy new data into row
       /////////////////////////////////////////
-      std::map<int,std::list<int> >::iterator iter;
+      typename std::map<ordinal_t,std::list<int> >::iterator iter;
       int nzcnt=0;
 
       // Iterate through list
@@ -291,15 +322,32 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 }
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// C = A*B for the uncompressed and compressed A
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::matmat(const CSRMat<int> &A, const CSRMat &B)
+{
+  matmatImpl(A,B);
+}
+
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::matmat(const CompressedCSRMat &A, const CSRMat &B)
+{
+  matmatImpl(A,B);
+}
+////////////////////////////////////////////////////////////////////////////////
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::readMMMatrix(const char *fname)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::readMMMatrix(const char *fname)
 {
   //////////////////////////////////////////////////////////////
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
@@ -319,7 +367,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -358,16 +406,21 @@ void CSRMat::readMMMatrix(const char *fname)
 
   //////////////////////////////////////////////////////////////
   // copy data from temporary sets to matrix data structures
+  //     -- rows are allocated and first touched in parallel, in
+  //        static blocks of mBlockSize rows, so that their pages
+  //        are spread evenly over the threads' NUMA nodes
   //////////////////////////////////////////////////////////////
-  std::map<int,int>::iterator iter;
+  count_t tmpNNZ = 0;
 
-  nnz = 0;
+  #pragma omp parallel for schedule(static,mBlockSize), reduction (+:tmpNNZ)
   for(int rownum=0; rownum<m; rownum++)
   {
+    std::map<int,int>::iterator iter;
+
     int nnzIndx=0;
     int nnzToAdd = rowSets[rownum].size();
     nnzInRow[rownum] = nnzToAdd;
-    nnz += nnzToAdd;
+    tmpNNZ += nnzToAdd;
 
     cols[rownum].resize(nnzToAdd);
     vals[rownum].resize(nnzToAdd);
@@ -379,6 +432,8 @@ void CSRMat::readMMMatrix(const char *fname)
       nnzIndx++;
     }
   }
+
+  nnz = tmpNNZ;
   //////////////////////////////////////////////////////////////
 
 }
@@ -386,7 +441,8 @@ void CSRMat::readMMMatrix(const char *fname)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::readBinMatrix(const char *fname)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::readBinMatrix(const char *fname)
 {
   //////////////////////////////////////////////////////////////
   // Build edge list from binary file                           
@@ -398,6 +454,8 @@ void CSRMat::readBinMatrix(const char *fname)
 
   readBinEdgeFile(fname, numVerts, numEdges, edgeList);
 
+  checkIDRange(numVerts, "vertices");
+
   m = numVerts;
   n = numVerts;
   //////////////////////////////////////////////////////////////
@@ -414,7 +472,7 @@ void CSRMat::readBinMatrix(const char *fname)
   int base=0;
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -453,17 +511,22 @@ void CSRMat::readBinMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////
-  // copy data from temporary sets to matrix data structures    
+  // copy data from temporary sets to matrix data structures
+  //     -- rows are allocated and first touched in parallel, in
+  //        static blocks of mBlockSize rows, so that their pages
+  //        are spread evenly over the threads' NUMA nodes
   //////////////////////////////////////////////////////////////
-  std::map<int,int>::iterator iter;
+  count_t tmpNNZ = 0;
 
-  nnz = 0;
+  #pragma omp parallel for schedule(static,mBlockSize), reduction (+:tmpNNZ)
   for(int rownum=0; rownum<m; rownum++)
   {
+    std::map<int,int>::iterator iter;
+
     int nnzIndx=0;
     int nnzToAdd = rowSets[rownum].size();
     nnzInRow[rownum] = nnzToAdd;
-    nnz += nnzToAdd;
+    tmpNNZ += nnzToAdd;
 
     cols[rownum].resize(nnzToAdd);
     vals[rownum].resize(nnzToAdd);
@@ -475,6 +538,8 @@ void CSRMat::readBinMatrix(const char *fname)
       nnzIndx++;
     }
   }
+
+  nnz = tmpNNZ;
   //////////////////////////////////////////////////////////////
 
 }
@@ -482,7 +547,8 @@ void CSRMat::readBinMatrix(const char *fname)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
 {
 
   m = matSrc.getM();
@@ -501,54 +567,69 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
   vals.resize(m);
   //////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////
+  // Rows are independent -- built (and first touched) in parallel,
+  // in static blocks of mBlockSize rows as in readMMMatrix
+  //////////////////////////////////////////////////////////////
+  count_t tmpNNZ = 0;
+
+  #pragma omp parallel for schedule(static,mBlockSize), reduction (+:tmpNNZ)
   for(int rownum=0; rownum<m; rownum++)
   {
-    std::map<int,int> nzMap;
-
+    //////////////////////////////////////////////////////////
+    // Rows of matSrc are sorted by column, so the triangular
+    // part of a row is a contiguous range that is copied as is
+    //////////////////////////////////////////////////////////
     int nnzInRowSrc = matSrc.getNNZInRow(rownum);
 
-    for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    int diagIndx=0;
+    while(diagIndx<nnzInRowSrc && matSrc.getCol(rownum, diagIndx)<rownum)
     {
-      int colSrc=matSrc.getCol(rownum, nzindxSrc);
-      int valSrc=matSrc.getVal(rownum, nzindxSrc);
-         
-      // WARNING: assumes there is only 1 element in value for now
-      if(type==LOWERTRI && rownum>colSrc)
-      {
-        nzMap[colSrc]=valSrc;
-      }
-      else if(type==UPPERTRI && rownum<colSrc)
+      diagIndx++;
+    }
+
+    int firstIndx, lastIndx;
+    if(type==LOWERTRI)
+    {
+      firstIndx = 0;
+      lastIndx = diagIndx;
+    }
+    else
+    {
+      firstIndx = diagIndx;
+      if(firstIndx<nnzInRowSrc && matSrc.getCol(rownum, firstIndx)==rownum)
       {
-        nzMap[colSrc]=valSrc;
+        firstIndx++;
       }
-
+      lastIndx = nnzInRowSrc;
     }
 
-    int nnzIndx=0;
-    int nnzToAdd = nzMap.size();
+    // WARNING: assumes there is only 1 element in value for now
+    int nnzToAdd = lastIndx - firstIndx;
     nnzInRow[rownum] = nnzToAdd;
-    nnz += nnzToAdd;
+    tmpNNZ += nnzToAdd;
 
     cols[rownum].resize(nnzToAdd);
     vals[rownum].resize(nnzToAdd);
 
-    std::map<int,int>::const_iterator iter;
-
-    for (iter=nzMap.begin();iter!=nzMap.end();iter++)
+    for(int nnzIndx=0; nnzIndx<nnzToAdd; nnzIndx++)
     {
-      cols[rownum][nnzIndx] = (*iter).first;
-      vals[rownum][nnzIndx] = (*iter).second;
-      nnzIndx++;
+      cols[rownum][nnzIndx] = matSrc.getCol(rownum, firstIndx+nnzIndx);
+      vals[rownum][nnzIndx] = matSrc.getVal(rownum, firstIndx+nnzIndx);
     }
 
   } // end of loop over rows
 
+  nnz = tmpNNZ;
 }
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<int,int> > & eIndices)
+template<typename ordinal_t>
+template<typename MatA>
+void CSRMat<ordinal_t>::createIncidentMatrixImpl(const MatA &matSrc,
+                                                 std::map<int,std::map<int,edgeid_t> > & eIndices)
 {
 
   m = matSrc.getM();
@@ -565,68 +646,148 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<in
   //////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////
-  // Store columns that need nonzeros
+  // Count upper triangular nonzeros (edges) in each row and the
+  // edges that each row is the larger endpoint of
+  //   -- rows of matSrc are sorted by column, so the upper
+  //      nonzeros of a row are the last ones
   //////////////////////////////////////////////////////////////
-  std::vector<std::set<int> > colsInRow(m);
+  std::vector<int> upperStart(m);
+  std::vector<ordinal_t> edgeStart(m+1);
+  std::vector<int> lowerCnt(m,0);
 
-  int eCnt=0;
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
   for(int rownum=0; rownum<m; rownum++)
   {
-
+    std::vector<int> rowBufSrc;
     int nnzInRowSrc = matSrc.getNNZInRow(rownum);
+    const int *colsSrc = matSrc.getRowCols(rownum, rowBufSrc);
 
-    for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    int nzindxSrc=0;
+    while(nzindxSrc<nnzInRowSrc && colsSrc[nzindxSrc]<=rownum)
     {
-      int colnum=matSrc.getCol(rownum, nzindxSrc);
+      nzindxSrc++;
+    }
+    upperStart[rownum] = nzindxSrc;
+    edgeStart[rownum+1] = nnzInRowSrc - nzindxSrc;
 
-      if(rownum < colnum)
-      {
-        colsInRow[rownum].insert(eCnt);
-        colsInRow[colnum].insert(eCnt);
- 
-	eIndices[rownum][colnum]=eCnt;
-        eCnt++;
-      }   
-      
+    for(; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    {
+      int colnum=colsSrc[nzindxSrc];
+
+      #pragma omp atomic
+      lowerCnt[colnum]++;
     }
   }
-  n=eCnt;
   //////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////
-  // Copy data into matrix data structures
-  //     -- Can probably free tmp data structures throughout
+  // Edge IDs -- prefix sum of the upper triangular row counts,
+  // numbered in the same (row, column) order as a serial sweep
   //////////////////////////////////////////////////////////////
+  edgeStart[0] = 0;
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    edgeStart[rownum+1] += edgeStart[rownum];
+  }
+  n=edgeStart[m];
+
+  // Outer map entries are created serially, the inner maps are
+  // then filled by the thread that owns the row
+  std::vector<std::map<int,edgeid_t> *> rowIndices(m,0);
   for(int rownum=0; rownum<m; rownum++)
   {
-    int nnzToAdd = colsInRow[rownum].size();
+    if(edgeStart[rownum+1]>edgeStart[rownum])
+    {
+      rowIndices[rownum] = &(eIndices[rownum]);
+    }
+  }
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Allocate rows of B -- edges of a vertex as the larger
+  // endpoint (smaller IDs) come before its own edges
+  //////////////////////////////////////////////////////////////
+  count_t tmpNNZ = 0;
+
+  #pragma omp parallel for schedule(dynamic,mBlockSize), reduction (+:tmpNNZ)
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    int nnzToAdd = lowerCnt[rownum] + edgeStart[rownum+1] - edgeStart[rownum];
     nnzInRow[rownum] = nnzToAdd;
-    nnz += nnzToAdd;
+    tmpNNZ += nnzToAdd;
 
     cols[rownum].resize(nnzToAdd);
-    vals[rownum].resize(nnzToAdd);
+    vals[rownum].assign(nnzToAdd,1);
+  }
+  nnz = tmpNNZ;
+  //////////////////////////////////////////////////////////////
 
-    std::set<int>::const_iterator iter;
+  //////////////////////////////////////////////////////////////
+  // Scatter edge IDs into rows of both endpoints
+  //////////////////////////////////////////////////////////////
+  std::vector<int> lowerFill(m,0);
 
-    int nnzIndx=0;
-    for (iter=colsInRow[rownum].begin();iter!=colsInRow[rownum].end();iter++)
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    std::vector<int> rowBufSrc;
+    int nnzInRowSrc = matSrc.getNNZInRow(rownum);
+    const int *colsSrc = matSrc.getRowCols(rownum, rowBufSrc);
+    ordinal_t eID = edgeStart[rownum];
+    int nnzIndx = lowerCnt[rownum];
+
+    for(int nzindxSrc=upperStart[rownum]; nzindxSrc<nnzInRowSrc; nzindxSrc++)
     {
-      cols[rownum][nnzIndx] = (*iter);
-      vals[rownum][nnzIndx] = 1;
-      nnzIndx++;
+      int colnum=colsSrc[nzindxSrc];
+
+      cols[rownum][nnzIndx++] = eID;
+
+      int slot;
+      #pragma omp atomic capture
+      slot = lowerFill[colnum]++;
+      cols[colnum][slot] = eID;
+
+      rowIndices[rownum]->insert(rowIndices[rownum]->end(),std::make_pair(colnum,eID));
+      eID++;
     }
   }
+
+  // Scatter order of the larger endpoint edges depends on the threads
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    std::sort(cols[rownum].begin(),cols[rownum].begin()+lowerCnt[rownum]);
+  }
   //////////////////////////////////////////////////////////////
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// Incidence matrix for the uncompressed and compressed adjacency matrix
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createIncidentMatrix(const CSRMat<int> &matSrc,
+                                             std::map<int,std::map<int,edgeid_t> > & eIndices)
+{
+  createIncidentMatrixImpl(matSrc,eIndices);
+}
+
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createIncidentMatrix(const CompressedCSRMat &matSrc,
+                                             std::map<int,std::map<int,edgeid_t> > & eIndices)
+{
+  createIncidentMatrixImpl(matSrc,eIndices);
+}
+////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd)
 {
-  std::map<int,std::list<int> >::iterator it;
+  typename std::map<ordinal_t,std::list<int> >::iterator it;
 
   it = nzMap.find(col);
 
@@ -641,23 +802,82 @@ int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
 
   std::list<int> newList;
   newList.push_back(elemToAdd);
-  nzMap.insert(std::pair<int,std::list<int> >(col, newList));
+  nzMap.insert(std::pair<ordinal_t,std::list<int> >(col, newList));
   return 1;
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// K-count bound of triangle (v1,v2,v3) -- largest k < numKCounts for which
+// the triangle vertex and edge degrees allow the triangle in a k-clique
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+unsigned int CSRMat<ordinal_t>::triangleK(int v1, int v2, int v3,
+                                          const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                          const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                          unsigned int numKCounts) const
+{
+  /////////////////////////////////////////////////////////////////////////
+  // Find tvMin                                                  
+  /////////////////////////////////////////////////////////////////////////
+  count_t tvMin = std::min(std::min(vTriDegrees[v1],vTriDegrees[v2]),vTriDegrees[v3]);
+  /////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////
+  // Find teMin                                                            
+  /////////////////////////////////////////////////////////////////////////
+
+  // I believe that v2<v3 by construction                                 
+  edgeid_t e1,e2,e3;
+  if(v2<v3)
+  {
+    e1 = edgeInds.find(v2)->second.find(v3)->second;
+    e2 = edgeInds.find(v2)->second.find(v1)->second;
+    e3 = edgeInds.find(v3)->second.find(v1)->second;
+  }
+  else
+  {
+    e1 = edgeInds.find(v3)->second.find(v2)->second;
+    e2 = edgeInds.find(v3)->second.find(v1)->second;
+    e3 = edgeInds.find(v2)->second.find(v1)->second;
+  }
+
+  count_t teMin = std::min(std::min(eTriDegrees[e1],eTriDegrees[e2]),eTriDegrees[e3]);
+  /////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////
+  // Determine k count for triangle                                        
+  /////////////////////////////////////////////////////////////////////////
+  unsigned int maxK=3;
+  for(unsigned int k=3; k<numKCounts; k++)
+  {
+    if(tvMin >= choose2(k-1) && teMin >= k-2)
+    {
+      maxK = k;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return maxK;
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Compute K counts                                                           
 //
 // Currently using critical section to summ kcounts across threads
 // Might be more efficient to use atomics for such as small array
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
-			    const std::map<int,std::map<int,int> > & edgeInds,
-			    std::vector<int> &kCounts)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                       const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                       std::vector<count_t> &kCounts)
 {
 
-  std::vector<int> localK;
+  std::vector<count_t> localK;
 
   //#pragma omp parallel private(localK) shared(kCounts)
 #pragma omp parallel private(localK) default(shared)
@@ -677,50 +897,7 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       // Removes redundant triangles
       if(v1>v2 && v1>v3)
       {
-
-        /////////////////////////////////////////////////////////////////////////
-	// Find tvMin                                                  
-	/////////////////////////////////////////////////////////////////////////
-	unsigned int tvMin = std::min(std::min(vTriDegrees[v1],vTriDegrees[v2]),vTriDegrees[v3]);
-        /////////////////////////////////////////////////////////////////////////
-
-	/////////////////////////////////////////////////////////////////////////
-	// Find teMin                                                            
-	/////////////////////////////////////////////////////////////////////////
-
-	// I believe that v2<v3 by construction                                 
-	int e1,e2,e3;
-	if(v2<v3)
-	{
-	  e1 = edgeInds.find(v2)->second.find(v3)->second;
-	  e2 = edgeInds.find(v2)->second.find(v1)->second;
-	  e3 = edgeInds.find(v3)->second.find(v1)->second;
-	}
-	else
-	{
-	  e1 = edgeInds.find(v3)->second.find(v2)->second;
-	  e2 = edgeInds.find(v3)->second.find(v1)->second;
-	  e3 = edgeInds.find(v2)->second.find(v1)->second;
-	}
-
-        unsigned int teMin = std::min(std::min(eTriDegrees[e1],eTriDegrees[e2]),eTriDegrees[e3]);
-	/////////////////////////////////////////////////////////////////////////
-
-	/////////////////////////////////////////////////////////////////////////
-        // Determine k count for triangle                                        
-	/////////////////////////////////////////////////////////////////////////
-	unsigned int maxK=3;
-	for(unsigned int k=3; k<kCounts.size(); k++)
-	{
-	  if(tvMin >= choose2(k-1) && teMin >= k-2)
-	  {
-	    maxK = k;
-	  }
-	  else
-	  {
-	    break;
-	  }
-	}
+	unsigned int maxK = triangleK(v1,v2,v3,vTriDegrees,eTriDegrees,edgeInds,kCounts.size());
         localK[maxK]++;
 	/////////////////////////////////////////////////////////////////////////
       }
@@ -741,7 +918,260 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
                        
 }
 //////////////////////////////////////////////////////////////////////////////
+// Export triangles
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::exportTriangles(triangleSink &sink, unsigned int kMin,
+                                        const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                        const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                        unsigned int numKCounts) const
+{
+  bool computeK = (vTriDegrees.getSize()>0 && eTriDegrees.getSize()>0);
+
+  if(kMin>3 && computeK==false)
+  {
+    std::cerr << "Triangle degrees required to filter triangles by k" << std::endl;
+    exit(1);
+  }
+
+  sink.open(omp_get_max_threads());
+
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    int thread = omp_get_thread_num();
+
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      sinkTri_t tri;
+      int v1 = rownum;
+      int v2 = vals[rownum][nzIdx];
+      int v3 = vals2[rownum][nzIdx];
+
+      // Removes redundant triangles
+      if(v1>v2 && v1>v3)
+      {
+        tri.k = 0;
+        if(computeK)
+        {
+          tri.k = triangleK(v1,v2,v3,vTriDegrees,eTriDegrees,edgeInds,numKCounts);
+          if(tri.k<kMin)
+          {
+            continue;
+          }
+        }
+
+        tri.v1 = v1+1;
+        tri.v2 = v2+1;
+        tri.v3 = v3+1;
+        sink.write(thread,tri);
+      }
+    }
+  } // end loop over rows
+
+  sink.close();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Compute trussness -- k-truss decomposition of the graph
+//
+// Triangle matrix C = this.  The trussness of an edge is the largest k such
+// that the edge is in the k-truss (every edge of the subgraph is in at
+// least k-2 of its triangles).  Edges are peeled level by level, starting
+// from the edge triangle degrees: at level l all remaining edges with
+// support <= l are removed (trussness l+2), and each triangle they close
+// lowers the support of its other two remaining edges.
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::computeTrussness(const Vector &eTriDegrees,
+                                         const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                         std::vector<int> &trussness) const
+{
+  edgeid_t numEdges = eTriDegrees.getSize();
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Build edge list of each triangle
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<count_t> triStart(m+1,0);
+
+#pragma omp parallel for schedule(dynamic,mBlockSize)
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      if(rownum>vals[rownum][nzIdx] && rownum>vals2[rownum][nzIdx])
+      {
+        triStart[rownum+1]++;
+      }
+    }
+  }
+
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    triStart[rownum+1] += triStart[rownum];
+  }
+
+  count_t numTris = triStart[m];
+  std::vector<edgeid_t> triEdges(3*numTris);
+
+#pragma omp parallel for schedule(dynamic,mBlockSize)
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    count_t triIdx = triStart[rownum];
+
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      int v1 = rownum;
+      int v2 = std::min(vals[rownum][nzIdx],vals2[rownum][nzIdx]);
+      int v3 = std::max(vals[rownum][nzIdx],vals2[rownum][nzIdx]);
+
+      // Removes redundant triangles
+      if(v1>v3)
+      {
+        triEdges[3*triIdx]   = cols[rownum][nzIdx];
+        triEdges[3*triIdx+1] = edgeInds.find(v2)->second.find(v1)->second;
+        triEdges[3*triIdx+2] = edgeInds.find(v3)->second.find(v1)->second;
+        triIdx++;
+      }
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Build triangle list of each edge
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<count_t> edgeStart(numEdges+1,0);
+  for (edgeid_t e=0; e<numEdges; e++)
+  {
+    edgeStart[e+1] = edgeStart[e] + eTriDegrees[e];
+  }
+
+  std::vector<count_t> edgeFill(edgeStart.begin(), edgeStart.end()-1);
+  std::vector<count_t> edgeTris(3*numTris);
+
+#pragma omp parallel for schedule(static)
+  for (count_t t=0; t<numTris; t++)
+  {
+    for(int i=0; i<3; i++)
+    {
+      count_t pos;
+#pragma omp atomic capture
+      pos = edgeFill[triEdges[3*t+i]]++;
+      edgeTris[pos] = t;
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Peel edges
+  //    -- curr holds the edges removed in this round.  A triangle with two
+  //       edges in curr is handled by the lower numbered one, a triangle
+  //       with three is not counted against anything.
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> support(numEdges);
+  std::vector<char> removed(numEdges,0);
+  std::vector<char> inCurr(numEdges,0);
+
+  for (edgeid_t e=0; e<numEdges; e++)
+  {
+    support[e] = eTriDegrees[e];
+  }
+
+  trussness.assign(numEdges,0);
+
+  std::vector<edgeid_t> curr;
+  std::vector<edgeid_t> next;
+
+  edgeid_t numLeft = numEdges;
+  for(int level=0; numLeft>0; level++)
+  {
+    curr.clear();
+    for (edgeid_t e=0; e<numEdges; e++)
+    {
+      if(removed[e]==0 && support[e]<=level)
+      {
+        curr.push_back(e);
+      }
+    }
+
+    while(curr.size()>0)
+    {
+      edgeid_t numCurr = curr.size();
+      numLeft -= numCurr;
+
+      for(edgeid_t i=0; i<numCurr; i++)
+      {
+        inCurr[curr[i]] = 1;
+        trussness[curr[i]] = level+2;
+      }
+
+      next.clear();
+
+#pragma omp parallel
+      {
+        std::vector<edgeid_t> localNext;
 
+#pragma omp for schedule(dynamic,mBlockSize)
+        for(edgeid_t i=0; i<numCurr; i++)
+        {
+          edgeid_t e = curr[i];
+
+          for(count_t pos=edgeStart[e]; pos<edgeStart[e+1]; pos++)
+          {
+            count_t t = edgeTris[pos];
+
+            edgeid_t f = (triEdges[3*t]==e) ? triEdges[3*t+1] : triEdges[3*t];
+            edgeid_t g = (triEdges[3*t+2]==e) ? triEdges[3*t+1] : triEdges[3*t+2];
+
+            if(removed[f] || removed[g] || (inCurr[f] && inCurr[g]))
+            {
+              continue;
+            }
+
+            if(inCurr[f])
+            {
+              if(e<f)
+              {
+                decrementSupport(g, level, support, localNext);
+              }
+            }
+            else if(inCurr[g])
+            {
+              if(e<g)
+              {
+                decrementSupport(f, level, support, localNext);
+              }
+            }
+            else
+            {
+              decrementSupport(f, level, support, localNext);
+              decrementSupport(g, level, support, localNext);
+            }
+          }
+        }
+
+#pragma omp critical
+        {
+          next.insert(next.end(), localNext.begin(), localNext.end());
+        }
+      }
+
+      for(edgeid_t i=0; i<numCurr; i++)
+      {
+        inCurr[curr[i]] = 0;
+        removed[curr[i]] = 1;
+      }
+
+      curr.swap(next);
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -758,3 +1188,10 @@ unsigned int choose2(unsigned int k)
   return 0;
 }
 ////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex ID (adjacency) and edge ID (incidence, triangle) matrices
+////////////////////////////////////////////////////////////////////////////////
+template class CSRMat<int>;
+template class CSRMat<edgeid_t>;
+////////////////////////////////////////////////////////////////////////////////
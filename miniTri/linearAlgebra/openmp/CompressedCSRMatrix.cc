@@ -0,0 +1,151 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      CompressedCSRMatrix.cc                                        //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for compressed CSR pattern matrix class.        //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <cstdlib>
+
+#include "CompressedCSRMatrix.h"
+#include "CSRMatrix.h"
+
+namespace
+{
+  //////////////////////////////////////////////////////////////////////////
+  // Number of bytes of varint encoding of val
+  //////////////////////////////////////////////////////////////////////////
+  inline int varintSize(unsigned int val)
+  {
+    int size=1;
+    while(val>=0x80)
+    {
+      val >>= 7;
+      size++;
+    }
+    return size;
+  }
+  //////////////////////////////////////////////////////////////////////////
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Builds compressed pattern of A
+//    -- encoded size of each row is computed first, row offsets are a
+//       prefix sum of these sizes and the rows are then encoded in parallel
+//////////////////////////////////////////////////////////////////////////////
+void CompressedCSRMat::compress(const CSRMat<int> &A)
+{
+  m = A.getM();
+  n = A.getN();
+  nnz = A.getNNZ();
+
+  nnzInRow.resize(m);
+  rowStart.resize(m+1);
+
+  //////////////////////////////////////////////////////////////
+  // Encoded size of each row
+  //////////////////////////////////////////////////////////////
+  rowStart[0] = 0;
+
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    int rowNNZ = A.getNNZInRow(rownum);
+    nnzInRow[rownum] = rowNNZ;
+
+    count_t rowBytes = 0;
+    int prevCol = 0;
+    for(int nzIdx=0; nzIdx<rowNNZ; nzIdx++)
+    {
+      int col = A.getCol(rownum,nzIdx);
+      if(col<prevCol || (nzIdx>0 && col==prevCol))
+      {
+        std::cerr << "Compressed matrix requires sorted rows (row " << rownum << ")" << std::endl;
+        exit(1);
+      }
+      rowBytes += varintSize(col-prevCol);
+      prevCol = col;
+    }
+    rowStart[rownum+1] = rowBytes;
+  }
+
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    rowStart[rownum+1] += rowStart[rownum];
+  }
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Encode rows
+  //////////////////////////////////////////////////////////////
+  data.resize(rowStart[m]);
+
+  #pragma omp parallel for schedule(dynamic,mBlockSize)
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    unsigned char *p = data.data() + rowStart[rownum];
+    int prevCol = 0;
+
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      int col = A.getCol(rownum,nzIdx);
+      unsigned int gap = col-prevCol;
+
+      while(gap>=0x80)
+      {
+        *p++ = (gap & 0x7f) | 0x80;
+        gap >>= 7;
+      }
+      *p++ = gap;
+
+      prevCol = col;
+    }
+  }
+  //////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
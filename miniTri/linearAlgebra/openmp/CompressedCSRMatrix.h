@@ -0,0 +1,154 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      CompressedCSRMatrix.h                                         //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for compressed (delta + varint) CSR pattern     //
+//              matrix class.                                               //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef COMPRESSEDCSRMATRIX_H
+#define COMPRESSEDCSRMATRIX_H
+
+#include <vector>
+
+#include "miniTriDefs.h"
+
+template<typename ordinal_t> class CSRMat;
+
+//////////////////////////////////////////////////////////////////////////////
+// Compressed sparse row pattern matrix -- read only
+//
+// Columns of each row are sorted and stored as the gaps between
+// consecutive columns (the first relative to 0), each gap as a varint
+// (7 bits per byte, high bit set if more bytes follow).  Values are all 1.
+// Rows are decoded into a caller provided buffer; gaps < 128 (the common
+// case for sorted rows) take one byte and the fast path of the decoder.
+//////////////////////////////////////////////////////////////////////////////
+class CompressedCSRMat 
+{
+
+ private:
+  int m;
+  int n;
+  count_t nnz;
+
+  std::vector<int> nnzInRow;
+  std::vector<count_t> rowStart;
+  std::vector<unsigned char> data;
+
+  int mBlockSize;
+
+ public:
+  //////////////////////////////////////////////////////////////////////////
+  // default constructor -- builds empty matrix
+  //////////////////////////////////////////////////////////////////////////
+  CompressedCSRMat(int blocksize=1) 
+    :m(0),n(0),nnz(0),nnzInRow(),rowStart(),data(),mBlockSize(blocksize)
+  {
+  };
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Builds compressed pattern of A (rows of A must be sorted)
+  //////////////////////////////////////////////////////////////////////////
+  void compress(const CSRMat<int> &A);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // accessors
+  //////////////////////////////////////////////////////////////////
+  int getM() const { return m;};
+  int getN() const { return n;};
+  count_t getNNZ() const { return nnz;};
+
+  inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
+
+  // bytes used for the columns (encoded data and row offsets)
+  count_t getColumnBytes() const 
+    {return data.size() + rowStart.size()*sizeof(count_t);};
+
+  //////////////////////////////////////////////////////////////////
+  // Decodes columns of row rowi into buf, returns pointer to them
+  //////////////////////////////////////////////////////////////////
+  inline const int *getRowCols(int rowi, std::vector<int> &buf) const
+  {
+    int rowNNZ = nnzInRow[rowi];
+    buf.resize(rowNNZ);
+
+    const unsigned char *p = data.data() + rowStart[rowi];
+    int *out = buf.data();
+    unsigned int col = 0;
+
+    for(int i=0; i<rowNNZ; i++)
+    {
+      unsigned int gap = *p++;
+
+      if(gap & 0x80)
+      {
+        gap &= 0x7f;
+        int shift = 7;
+        unsigned int byte;
+        do
+        {
+          byte = *p++;
+          gap |= (byte & 0x7f) << shift;
+          shift += 7;
+        } while(byte & 0x80);
+      }
+
+      col += gap;
+      out[i] = col;
+    }
+
+    return out;
+  };
+  //////////////////////////////////////////////////////////////////
+
+};
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -64,6 +64,37 @@
 #include "mmio.h"
 
 
+//////////////////////////////////////////////////////////////////////////////
+// Compress adjacency matrix
+//////////////////////////////////////////////////////////////////////////////
+void Graph::compressAdjacency()
+{
+  struct timeval t1, t2;
+
+  if(mCompressed)
+  {
+    return;
+  }
+
+  gettimeofday(&t1, NULL);
+
+  mCMatrix.compress(mMatrix);
+
+  // Free the uncompressed matrix
+  count_t rawBytes = mMatrix.getNNZ()*sizeof(int);
+  mMatrix = CSRMat<int>(UNDEFINED,mBlockSize);
+  mCompressed = true;
+
+  gettimeofday(&t2, NULL);
+
+  double eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+
+  std::cout << "Compressed adjacency columns: " << rawBytes << " -> "
+            << mCMatrix.getColumnBytes() << " bytes" << std::endl;
+  std::cout << "TIME - Time to compress adjacency: " << eTime << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Enumerate triangles in graph
 //////////////////////////////////////////////////////////////////////////////
@@ -103,8 +134,15 @@ void Graph::triangleEnumerate()
 
   gettimeofday(&t1, NULL);
 
-  CSRMat B(INCIDENCE,mBlockSize);
-  B.createIncidentMatrix(mMatrix,mEdgeIndices);
+  CSRMat<edgeid_t> B(INCIDENCE,mBlockSize);
+  if(mCompressed)
+  {
+    B.createIncidentMatrix(mCMatrix,mEdgeIndices);
+  }
+  else
+  {
+    B.createIncidentMatrix(mMatrix,mEdgeIndices);
+  }
 
   gettimeofday(&t2, NULL);
 
@@ -125,12 +163,19 @@ void Graph::triangleEnumerate()
   std::cout << "--------------------" << std::endl;
 
 
-  std::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getM(),B.getN(),mBlockSize,true));
+  std::shared_ptr<CSRMat<edgeid_t> > C(new CSRMat<edgeid_t>(mNumVerts,B.getN(),mBlockSize,true));
 
   std::cout << "C = L*B: " << std::endl;
 
   gettimeofday(&t1, NULL);
-  C->matmat(mMatrix,B);
+  if(mCompressed)
+  {
+    C->matmat(mCMatrix,B);
+  }
+  else
+  {
+    C->matmat(mMatrix,B);
+  }
   gettimeofday(&t2, NULL);
 
   //C.print();
@@ -235,25 +280,17 @@ void Graph::printTriangles() const
 {
   std::cout << "Triangles: " << std::endl;
 
-  std::list<int> triangles = mTriMat->getSumElements();
+  textTriangleSink sink(std::cout);
+  exportTriangles(sink);
+}
+//////////////////////////////////////////////////////////////////////////////
 
-  //Iterate through list and output triangles                                                                                                                                                             
-  std::list<int>::const_iterator iter;
-  for (iter=triangles.begin(); iter!=triangles.end(); iter++)
-    {
-      int v1 = *iter+1;
-      iter++;
-      int v2 = *iter+1;
-      iter++;
-      int v3 = *iter+1;
-
-      if(v1>v2 && v1>v3)
-	{
-	  std::cout << "(" << v1;
-	  std::cout << ", " << v2;
-	  std::cout << ", " << v3 << ")" << std::endl;
-	}
-    }
+//////////////////////////////////////////////////////////////////////////////
+// Writes triangles in graph to sink
+//////////////////////////////////////////////////////////////////////////////
+void Graph::exportTriangles(triangleSink &sink, unsigned int kMin) const
+{
+  mTriMat->exportTriangles(sink,kMin,mVTriDegrees,mETriDegrees,mEdgeIndices,mKCounts.size());
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -291,3 +328,99 @@ void Graph::printKCounts()
   }
 }
 //////////////////////////////////////////////////////////////////////////////     
+
+//////////////////////////////////////////////////////////////////////////////
+// Approximate triangle count, triangle degrees and k-counts by sampling
+//////////////////////////////////////////////////////////////////////////////
+void Graph::approximateCount(const approxParams &params)
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Estimating triangles ....." << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  if(mCompressed)
+  {
+    std::cerr << "Approximate mode requires the uncompressed adjacency matrix" << std::endl;
+    exit(1);
+  }
+
+  gettimeofday(&t1, NULL);
+
+  approxResult result;
+  approxTriangleCount(mMatrix, params, mKCounts.size(), result);
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to estimate triangles: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished triangle estimation" << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  printApproxResult(params, result);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Calculate k-truss decomposition
+//     -- requires triangle edge degrees
+//////////////////////////////////////////////////////////////////////////////
+void Graph::calculateKTruss()
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Calculating k-truss decomposition ....." << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  mTriMat->computeTrussness(mETriDegrees,mEdgeIndices,mTrussness);
+
+  mTrussCounts.assign(3,0);
+  for(unsigned int e=0; e<mTrussness.size(); e++)
+  {
+    if(mTrussness[e]>=(int)mTrussCounts.size())
+    {
+      mTrussCounts.resize(mTrussness[e]+1,0);
+    }
+    mTrussCounts[mTrussness[e]]++;
+  }
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to compute k-truss decomposition: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished calculating k-truss decomposition" << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Print number of edges with each trussness
+//////////////////////////////////////////////////////////////////////////////
+void Graph::printTrussCounts()
+{
+  std::cout << "Truss-Counts (edges): " << std::endl;
+  for(unsigned int i=2; i<mTrussCounts.size(); i++)
+  {
+    std::cout << "Truss[" << i << "] = " << mTrussCounts[i] << std::endl;
+  }
+  std::cout << "Maximum truss: " << mTrussCounts.size()-1 << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
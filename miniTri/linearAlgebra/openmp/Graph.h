@@ -60,7 +60,11 @@
 #include <memory>
 
 #include "CSRMatrix.h"
+#include "CompressedCSRMatrix.h"
 #include "Vector.h"
+#include "mmUtil.h"
+#include "sampleUtil.h"
+#include "triSinkUtil.h"
 
 
 
@@ -74,24 +78,32 @@ class Graph
   std::string mFilename;
 
   int mNumVerts;
-  int mNumEdges;
-  CSRMat mMatrix;
+  count_t mNumEdges;
+  CSRMat<int> mMatrix;
 
+  // Compressed adjacency, replaces mMatrix after compressAdjacency
+  CompressedCSRMat mCMatrix;
+  bool mCompressed;
 
-  std::shared_ptr<CSRMat> mTriMat;
+
+  std::shared_ptr<CSRMat<edgeid_t> > mTriMat;
  
-  std::map<int,std::map<int,int> > mEdgeIndices;
+  std::map<int,std::map<int,edgeid_t> > mEdgeIndices;
 
 
   Vector mVTriDegrees;
   Vector mETriDegrees;
 
-  int mNumTriangles;
+  count_t mNumTriangles;
 
   int mBlockSize;
 
   // K-count frequency table
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
+
+  // Trussness of each edge, number of edges with each trussness
+  std::vector<int> mTrussness;
+  std::vector<count_t> mTrussCounts;
 
 
  public:
@@ -99,7 +111,8 @@ class Graph
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mNumTriangles(0),mBlockSize(1)
+    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(),mCMatrix(),mCompressed(false),
+     mNumTriangles(0),mBlockSize(1)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -108,7 +121,8 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
  Graph(std::string _fname, bool binFile, int blocksize=1) 
-    :mFilename(_fname),mMatrix(), mNumTriangles(0), mBlockSize(blocksize)
+    :mFilename(_fname),mMatrix(UNDEFINED,blocksize),mCMatrix(blocksize),mCompressed(false),
+     mNumTriangles(0), mBlockSize(blocksize)
   {
     if(binFile==false)
     {
@@ -141,6 +155,14 @@ class Graph
   //////////////////////////////////////////////////////////////////////////
 
 
+  //////////////////////////////////////////////////////////////////////////
+  // Replaces the adjacency matrix by its compressed (delta + varint)
+  // pattern, used as the read only operand of B and C = L*B.  Not
+  // supported by approximateCount.
+  //////////////////////////////////////////////////////////////////////////
+  void compressAdjacency();
+  //////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////
   // Enumerate triangles
   //////////////////////////////////////////////////////////////////////////
@@ -155,10 +177,30 @@ class Graph
 
   void printTriangles() const;
 
-  int getNumTriangles() const {return mNumTriangles;};
+  //////////////////////////////////////////////////////////////////////////
+  // Writes the triangles (each once) to sink, keeping only triangles with
+  // k-count bound >= kMin (kMin > 3 requires calculateTriangleDegrees)
+  //////////////////////////////////////////////////////////////////////////
+  void exportTriangles(triangleSink &sink, unsigned int kMin=0) const;
+  //////////////////////////////////////////////////////////////////////////
+
+
+  count_t getNumTriangles() const {return mNumTriangles;};
 
   void printKCounts();
 
+  // K-truss decomposition
+  void calculateKTruss();
+
+  void printTrussCounts();
+
+  //////////////////////////////////////////////////////////////////////////
+  // Approximate mode -- estimates the triangle count, triangle degrees and
+  // k-counts by sampling the adjacency matrix, without forming B or C
+  //////////////////////////////////////////////////////////////////////////
+  void approximateCount(const approxParams &params);
+  //////////////////////////////////////////////////////////////////////////
+
 
 
 };
@@ -53,6 +53,8 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include "miniTriDefs.h"
+
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
 //////////////////////////////////////////////////////////////////////////////
@@ -61,7 +63,7 @@ class Vector
 
  private:
 
-  std::vector<int> mElements;                             // elements in vector
+  std::vector<count_t> mElements;                         // elements in vector
 
  public:
 
@@ -77,7 +79,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // constructor -- allocates memory for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-  Vector(int _m, int _bs=1)
+  Vector(int64_t _m, int _bs=1)
     :mElements(_m)
   {
   };
@@ -105,13 +107,13 @@ class Vector
   //////////////////////////////////////////////////////////////////
 
   // returns the number of rows
-  int getSize() const { return mElements.size();};
+  int64_t getSize() const { return mElements.size();};
 
 
   //////////////////////////////////////////////////////////////////////////
   // v[i] operator -- accessor for elements in vector
   //////////////////////////////////////////////////////////////////////////
-  int operator [](int indx) const
+  count_t operator [](int64_t indx) const
   {
     return mElements[indx];
   }
@@ -119,7 +121,7 @@ class Vector
 
   //////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////
-  void resize(int _m)
+  void resize(int64_t _m)
   {
     mElements.resize(_m);
   }
@@ -128,7 +130,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // setVal -- function sets element indx to be alpha
   //////////////////////////////////////////////////////////////////////////
-  void setVal(int indx,int alpha) 
+  void setVal(int64_t indx,count_t alpha) 
   {
     mElements[indx]=alpha;
   }
@@ -137,7 +139,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // setVal -- function sets all elements to be alpha
   //////////////////////////////////////////////////////////////////////////
-  void setScalar(int alpha) 
+  void setScalar(count_t alpha) 
   {
     for(unsigned int i=0;i<mElements.size();i++)
     {
@@ -59,6 +59,7 @@
 #include <sys/time.h>
 
 #include "Graph.h"
+#include "numaUtil.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Main
@@ -67,10 +68,49 @@ int main(int argc, char *argv[])
 {
   struct timeval t1, t2;
 
- 
-  if(argc!=4 && argc!=5)
+  // NUMA placement options, removed from argv before the other parsing
+  numaParams numa;
+  parseNumaOptions(argc, argv, numa);
+
+  // Triangle export options, removed from argv before the other parsing
+  exportParams exportOpts;
+  parseExportOptions(argc, argv, exportOpts);
+
+  // Compressed adjacency matrix, k-truss decomposition
+  bool compress = false;
+  bool truss = false;
+  int newArgc = 0;
+  for(int i=0; i<argc; i++)
+  {
+    if(std::string(argv[i])=="--compress")
+    {
+      compress = true;
+    }
+    else if(std::string(argv[i])=="--truss")
+    {
+      truss = true;
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+  argc = newArgc;
+  argv[argc] = 0;
+
+  // Approximate mode options follow the positional arguments
+  approxParams params;
+  int numArgs = parseApproxOptions(argc, argv, params);
+
+  if(numArgs!=4 && numArgs!=5)
   {
-    std::cerr << "Usage: miniTri.exe matrixFile blockSize numThreads [fileformat ={MM || Bin}]" << std::endl;
+    std::cerr << "Usage: miniTri.exe matrixFile blockSize numThreads [fileformat ={MM || Bin}]"
+              << " [--approx method[:param] [--reps R] [--seed S] [--error e]]"
+              << " [--bind {none|close|spread}] [--places {threads|cores|sockets}] [--interleave]"
+              << " [--export file [--export-format {text|bin|delta}] [--kmin k]]"
+              << " [--compress] [--truss]"
+              << std::endl;
+    printApproxUsage();
     exit(1);
   }
 
@@ -79,7 +119,7 @@ int main(int argc, char *argv[])
   int numThreads = atoi(argv[3]);
   bool isBinFile = false;
 
-  if(argc==5)
+  if(numArgs==5)
   {
     std::string fileFormat = std::string(argv[4]);
 
@@ -99,12 +139,30 @@ int main(int argc, char *argv[])
   }
 
   omp_set_num_threads(numThreads);
+  applyNumaOptions(numa);
 
   gettimeofday(&t1, NULL);
 
 
   Graph g(mat,isBinFile,blockSize);
 
+  if(params.method!=EXACT_METHOD)
+  {
+    if(compress)
+    {
+      std::cerr << "--compress is not supported in approximate mode" << std::endl;
+      exit(1);
+    }
+
+    g.approximateCount(params);
+    return 0;
+  }
+
+  if(compress)
+  {
+    g.compressAdjacency();
+  }
+
   g.triangleEnumerate();
   g.calculateTriangleDegrees();
   g.calculateKCounts();
@@ -123,6 +181,31 @@ int main(int argc, char *argv[])
 
   std::cout << "TIME - Time to compute miniTri: " << eTime << std::endl;
 
+  ////////////////////////////////////////////////////////////////////////
+  // Triangle listing export
+  ////////////////////////////////////////////////////////////////////////
+  if(!exportOpts.file.empty())
+  {
+    struct timeval te1, te2;
+    triangleSink *sink = createTriangleSink(exportOpts);
+
+    gettimeofday(&te1, NULL);
+    g.exportTriangles(*sink,exportOpts.kMin);
+    gettimeofday(&te2, NULL);
+
+    delete sink;
+
+    double exTime = te2.tv_sec - te1.tv_sec + ((te2.tv_usec-te1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to export triangles (" << exportOpts.format
+              << ", k >= " << exportOpts.kMin << "): " << exTime << std::endl;
+  }
+
+  if(truss)
+  {
+    g.calculateKTruss();
+    g.printTrussCounts();
+  }
+
 
   //MMW need to unpermute matrix
 
@@ -58,23 +58,41 @@
 #include <map>
 #include <set>
 #include <cassert>
+#include <algorithm>
 #include <cstdlib>
 
 #include "CSRmatrix.hpp"
 #include "Vector.hpp"
 #include "mmUtil.h"
 #include "binFileReader.h"
+#include "triSinkUtil.h"
 
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd);
 
 unsigned int choose2(unsigned int k);
 
+//////////////////////////////////////////////////////////////////////////////
+// decrementSupport -- lowers support of edge, adds it to next once it
+//                     falls to level
+//////////////////////////////////////////////////////////////////////////////
+inline void decrementSupport(edgeid_t edge, int level, std::vector<int> &support,
+                             std::vector<edgeid_t> &next)
+{
+  if(support[edge]--==level+1)
+  {
+    next.push_back(edge);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
 
 //////////////////////////////////////////////////////////////////////////////
 // print function -- outputs matrix to file
 //                -- accepts optional filename, "CSRmatrix.out" default name
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::print() const
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::print() const
 {
   std::cout << "Matrix: " << m << " " << n << " " << nnz << std::endl;
 
@@ -98,7 +116,8 @@ void CSRMat::print() const
 ////////////////////////////////////////////////////////////////////////////////
 // Sums matrix elements
 ////////////////////////////////////////////////////////////////////////////////
-std::list<int> CSRMat::getSumElements() const
+template<typename ordinal_t>
+std::list<int> CSRMat<ordinal_t>::getSumElements() const
 {
   std::list<int> matList;
 
@@ -126,7 +145,8 @@ std::list<int> CSRMat::getSumElements() const
 // SpMV1 --
 //        -- y = this * 1 or y = this' * 1
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::SpMV1(bool trans, Vector &y)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::SpMV1(bool trans, Vector &y)
 {
   m = this->getM();
 
@@ -145,7 +165,7 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 
       for(int nzindx=0; nzindx<NNZinRow; nzindx++)
       {
-        int colA=cols[rowID][nzindx];
+        ordinal_t colA=cols[rowID][nzindx];
 	y.setVal(colA,y[colA]+1);
       }
     } // end loop over rows                                                                                                                                          
@@ -159,7 +179,8 @@ void CSRMat::SpMV1(bool trans, Vector &y)
 // matmat -- level 3 basic linear algebra subroutine  
 //        -- Z = AB where Z = this
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::matmat(const CSRMat<int> &A, const CSRMat &B)
 {
   //////////////////////////////////////////////////////////
   // set dimensions of matrix, build arrays nnzInRow, vals, cols
@@ -182,12 +203,12 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   ///////////////////////////////////////////////////////////////////////////
   nnz =0;
 
-  int tmpNNZ =0;
+  count_t tmpNNZ =0;
 
   for (int rownum=0; rownum<m; rownum++)
   {
     nnzInRow[rownum]=0;
-    std::map<int,std::list<int> > newNZs;
+    std::map<ordinal_t,std::list<int> > newNZs;
 
     int nnzInRowA = A.getNNZInRow(rownum);
 
@@ -199,7 +220,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 
       for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
       {
-        int colB=B.getCol(colA, nzindxB);
+        ordinal_t colB=B.getCol(colA, nzindxB);
 
         nnzInRow[rownum] += addNZ(newNZs,colB, colA);
       }
@@ -210,7 +231,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
     //   This is an optimization for Triangle Enumeration
     //   Algorithm #2                                
     /////////////////////////////////////////////////
-    std::map<int,std::list<int> >::iterator iter;
+    typename std::map<ordinal_t,std::list<int> >::iterator iter;
 
     for (iter=newNZs.begin(); iter!=newNZs.end(); )
     {
@@ -243,7 +264,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
       /////////////////////////////////////////
       //Copy new data into row
       /////////////////////////////////////////
-      std::map<int,std::list<int> >::iterator iter;
+      typename std::map<ordinal_t,std::list<int> >::iterator iter;
       int nzcnt=0;
 
       // Iterate through list
@@ -274,13 +295,14 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::readMMMatrix(const char *fname)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::readMMMatrix(const char *fname)
 {
   //////////////////////////////////////////////////////////////
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
@@ -300,7 +322,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -368,7 +390,8 @@ void CSRMat::readMMMatrix(const char *fname)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::readBinMatrix(const char *fname)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::readBinMatrix(const char *fname)
 {
   //////////////////////////////////////////////////////////////
   // Build edge list from MM file                               
@@ -380,6 +403,8 @@ void CSRMat::readBinMatrix(const char *fname)
 
   readBinEdgeFile(fname, numVerts, numEdges, edgeList);
 
+  checkIDRange(numVerts, "vertices");
+
   m = numVerts;
   n = numVerts;
   //////////////////////////////////////////////////////////////
@@ -396,7 +421,7 @@ void CSRMat::readBinMatrix(const char *fname)
   int base=0;
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -464,7 +489,8 @@ void CSRMat::readBinMatrix(const char *fname)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
 {
 
   m = matSrc.getM();
@@ -485,13 +511,13 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
 
   for(int rownum=0; rownum<m; rownum++)
   {
-    std::map<int,int> nzMap;
+    std::map<ordinal_t,int> nzMap;
 
     int nnzInRowSrc = matSrc.getNNZInRow(rownum);
 
     for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
     {
-      int colSrc=matSrc.getCol(rownum, nzindxSrc);
+      ordinal_t colSrc=matSrc.getCol(rownum, nzindxSrc);
       int valSrc=matSrc.getVal(rownum, nzindxSrc);
          
       // WARNING: assumes there is only 1 element in value for now
@@ -514,7 +540,7 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
     cols[rownum].resize(nnzToAdd);
     vals[rownum].resize(nnzToAdd);
 
-    std::map<int,int>::const_iterator iter;
+    typename std::map<ordinal_t,int>::const_iterator iter;
 
     for (iter=nzMap.begin();iter!=nzMap.end();iter++)
     {
@@ -530,7 +556,9 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<int,int> > & eIndices)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::createIncidentMatrix(const CSRMat<int> &matSrc,
+                                             std::map<int,std::map<int,edgeid_t> > & eIndices)
 {
 
   m = matSrc.getM();
@@ -549,9 +577,9 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<in
   //////////////////////////////////////////////////////////////
   // Store columns that need nonzeros
   //////////////////////////////////////////////////////////////
-  std::vector<std::set<int> > colsInRow(m);
+  std::vector<std::set<ordinal_t> > colsInRow(m);
 
-  int eCnt=0;
+  ordinal_t eCnt=0;
   for(int rownum=0; rownum<m; rownum++)
   {
 
@@ -588,7 +616,7 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<in
     cols[rownum].resize(nnzToAdd);
     vals[rownum].resize(nnzToAdd);
 
-    std::set<int>::const_iterator iter;
+    typename std::set<ordinal_t>::const_iterator iter;
 
     int nnzIndx=0;
     for (iter=colsInRow[rownum].begin();iter!=colsInRow[rownum].end();iter++)
@@ -606,9 +634,10 @@ void CSRMat::createIncidentMatrix(const CSRMat &matSrc, std::map<int,std::map<in
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
-int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
+template<typename ordinal_t>
+int addNZ(std::map<ordinal_t,std::list<int> > &nzMap,ordinal_t col, int elemToAdd)
 {
-  std::map<int,std::list<int> >::iterator it;
+  typename std::map<ordinal_t,std::list<int> >::iterator it;
 
   it = nzMap.find(col);
 
@@ -623,20 +652,79 @@ int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd)
 
   std::list<int> newList;
   newList.push_back(elemToAdd);
-  nzMap.insert(std::pair<int,std::list<int> >(col, newList));
+  nzMap.insert(std::pair<ordinal_t,std::list<int> >(col, newList));
   return 1;
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// K-count bound of triangle (v1,v2,v3) -- largest k < numKCounts for which
+// the triangle vertex and edge degrees allow the triangle in a k-clique
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+unsigned int CSRMat<ordinal_t>::triangleK(int v1, int v2, int v3,
+                                          const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                          const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                          unsigned int numKCounts) const
+{
+  /////////////////////////////////////////////////////////////////////////
+  // Find tvMin
+  /////////////////////////////////////////////////////////////////////////
+  count_t tvMin = std::min(std::min(vTriDegrees[v1],vTriDegrees[v2]),vTriDegrees[v3]);
+  /////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////
+  // Find teMin                                                            
+  /////////////////////////////////////////////////////////////////////////
+
+  // I believe that v2<v3 by construction
+  edgeid_t e1,e2,e3;
+  if(v2<v3)
+  {
+    e1 = edgeInds.find(v2)->second.find(v3)->second;
+    e2 = edgeInds.find(v2)->second.find(v1)->second;
+    e3 = edgeInds.find(v3)->second.find(v1)->second;
+  }
+  else
+  {
+    e1 = edgeInds.find(v3)->second.find(v2)->second;
+    e2 = edgeInds.find(v3)->second.find(v1)->second;
+    e3 = edgeInds.find(v2)->second.find(v1)->second;
+  }
+
+  count_t teMin = std::min(std::min(eTriDegrees[e1],eTriDegrees[e2]),eTriDegrees[e3]);
+  /////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////
+  // Determine k count for triangle                                        
+  /////////////////////////////////////////////////////////////////////////
+  unsigned int maxK=3;
+  for(unsigned int k=3; k<numKCounts; k++)
+  {
+    if(tvMin >= choose2(k-1) && teMin >= k-2)
+    {
+      maxK = k;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return maxK;
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Compute K counts
 //
 // Currently using critical section to summ kcounts across threads
 // Might be more efficient to use atomics for such as small array
 //////////////////////////////////////////////////////////////////////////////
-void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
-                            const std::map<int,std::map<int,int> > & edgeInds,
-                            std::vector<int> &kCounts)
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                       const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                       std::vector<count_t> &kCounts)
 {
   for (int rownum=0; rownum<m; rownum++)
   {
@@ -649,60 +737,316 @@ void CSRMat::computeKCounts(const Vector &vTriDegrees,const Vector &eTriDegrees,
       // Removes redundant triangles
       if(v1>v2 && v1>v3)
       {
-        /////////////////////////////////////////////////////////////////////////
-	// Find tvMin
-	/////////////////////////////////////////////////////////////////////////
-	unsigned int tvMin = std::min(std::min(vTriDegrees[v1],vTriDegrees[v2]),vTriDegrees[v3]);
+	unsigned int maxK = triangleK(v1,v2,v3,vTriDegrees,eTriDegrees,edgeInds,kCounts.size());
+        kCounts[maxK]++;
 	/////////////////////////////////////////////////////////////////////////
 
-	/////////////////////////////////////////////////////////////////////////
-	// Find teMin                                                            
-	/////////////////////////////////////////////////////////////////////////
+      }
+    }
+  } // end loop over rows                                                            
+  ///////////////////////////////////////////////////////////////////////////
 
-	// I believe that v2<v3 by construction
-	int e1,e2,e3;
-	if(v2<v3)
-	{
-	  e1 = edgeInds.find(v2)->second.find(v3)->second;
-	  e2 = edgeInds.find(v2)->second.find(v1)->second;
-	  e3 = edgeInds.find(v3)->second.find(v1)->second;
-	}
-	else
-	{
-	  e1 = edgeInds.find(v3)->second.find(v2)->second;
-	  e2 = edgeInds.find(v3)->second.find(v1)->second;
-	  e3 = edgeInds.find(v2)->second.find(v1)->second;
-	}
+}
+//////////////////////////////////////////////////////////////////////////////
+// Export triangles
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::exportTriangles(triangleSink &sink, unsigned int kMin,
+                                        const Vector &vTriDegrees,const Vector &eTriDegrees,
+                                        const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                        unsigned int numKCounts) const
+{
+  bool computeK = (vTriDegrees.getSize()>0 && eTriDegrees.getSize()>0);
 
-	unsigned int teMin = std::min(std::min(eTriDegrees[e1],eTriDegrees[e2]),eTriDegrees[e3]);
-	/////////////////////////////////////////////////////////////////////////
+  if(kMin>3 && computeK==false)
+  {
+    std::cerr << "Triangle degrees required to filter triangles by k" << std::endl;
+    exit(1);
+  }
 
-	/////////////////////////////////////////////////////////////////////////
-	// Determine k count for triangle                                        
-	/////////////////////////////////////////////////////////////////////////
-	unsigned int maxK=3;
-	for(unsigned int k=3; k<kCounts.size(); k++)
-	{
-	  if(tvMin >= choose2(k-1) && teMin >= k-2)
-	  {
-	    maxK = k;
-	  }
-	  else
-	  {
-	    break;
-	  }
+  sink.open(1);
+
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    int thread = 0;
+
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      sinkTri_t tri;
+      int v1 = rownum;
+      int v2 = vals[rownum][nzIdx];
+      int v3 = vals2[rownum][nzIdx];
+
+      // Removes redundant triangles
+      if(v1>v2 && v1>v3)
+      {
+        tri.k = 0;
+        if(computeK)
+        {
+          tri.k = triangleK(v1,v2,v3,vTriDegrees,eTriDegrees,edgeInds,numKCounts);
+          if(tri.k<kMin)
+          {
+            continue;
+          }
         }
-	kCounts[maxK]++;
-	/////////////////////////////////////////////////////////////////////////
 
+        tri.v1 = v1+1;
+        tri.v2 = v2+1;
+        tri.v3 = v3+1;
+        sink.write(thread,tri);
       }
     }
-  } // end loop over rows                                                            
+  } // end loop over rows
+
+  sink.close();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Compute trussness -- k-truss decomposition of the graph
+//
+// Triangle matrix C = this.  The trussness of an edge is the largest k such
+// that the edge is in the k-truss (every edge of the subgraph is in at
+// least k-2 of its triangles).  Edges are peeled level by level, starting
+// from the edge triangle degrees: at level l all remaining edges with
+// support <= l are removed (trussness l+2), and each triangle they close
+// lowers the support of its other two remaining edges.
+//////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+void CSRMat<ordinal_t>::computeTrussness(const Vector &eTriDegrees,
+                                         const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                                         std::vector<int> &trussness) const
+{
+  edgeid_t numEdges = eTriDegrees.getSize();
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Build edge list of each triangle
   ///////////////////////////////////////////////////////////////////////////
+  std::vector<count_t> triStart(m+1,0);
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      if(rownum>vals[rownum][nzIdx] && rownum>vals2[rownum][nzIdx])
+      {
+        triStart[rownum+1]++;
+      }
+    }
+  }
 
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    triStart[rownum+1] += triStart[rownum];
+  }
+
+  count_t numTris = triStart[m];
+  std::vector<edgeid_t> triEdges(3*numTris);
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    count_t triIdx = triStart[rownum];
+
+    for(int nzIdx=0; nzIdx<nnzInRow[rownum]; nzIdx++)
+    {
+      int v1 = rownum;
+      int v2 = std::min(vals[rownum][nzIdx],vals2[rownum][nzIdx]);
+      int v3 = std::max(vals[rownum][nzIdx],vals2[rownum][nzIdx]);
+
+      // Removes redundant triangles
+      if(v1>v3)
+      {
+        triEdges[3*triIdx]   = cols[rownum][nzIdx];
+        triEdges[3*triIdx+1] = edgeInds.find(v2)->second.find(v1)->second;
+        triEdges[3*triIdx+2] = edgeInds.find(v3)->second.find(v1)->second;
+        triIdx++;
+      }
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Build triangle list of each edge
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<count_t> edgeStart(numEdges+1,0);
+  for (edgeid_t e=0; e<numEdges; e++)
+  {
+    edgeStart[e+1] = edgeStart[e] + eTriDegrees[e];
+  }
+
+  std::vector<count_t> edgeFill(edgeStart.begin(), edgeStart.end()-1);
+  std::vector<count_t> edgeTris(3*numTris);
+  for (count_t t=0; t<numTris; t++)
+  {
+    for(int i=0; i<3; i++)
+    {
+      count_t pos;
+      pos = edgeFill[triEdges[3*t+i]]++;
+      edgeTris[pos] = t;
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Peel edges
+  //    -- curr holds the edges removed in this round.  A triangle with two
+  //       edges in curr is handled by the lower numbered one, a triangle
+  //       with three is not counted against anything.
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> support(numEdges);
+  std::vector<char> removed(numEdges,0);
+  std::vector<char> inCurr(numEdges,0);
+
+  for (edgeid_t e=0; e<numEdges; e++)
+  {
+    support[e] = eTriDegrees[e];
+  }
+
+  trussness.assign(numEdges,0);
+
+  std::vector<edgeid_t> curr;
+  std::vector<edgeid_t> next;
+
+  edgeid_t numLeft = numEdges;
+  for(int level=0; numLeft>0; level++)
+  {
+    curr.clear();
+    for (edgeid_t e=0; e<numEdges; e++)
+    {
+      if(removed[e]==0 && support[e]<=level)
+      {
+        curr.push_back(e);
+      }
+    }
+
+    while(curr.size()>0)
+    {
+      edgeid_t numCurr = curr.size();
+      numLeft -= numCurr;
+
+      for(edgeid_t i=0; i<numCurr; i++)
+      {
+        inCurr[curr[i]] = 1;
+        trussness[curr[i]] = level+2;
+      }
+
+      next.clear();
+      {
+        std::vector<edgeid_t> localNext;
+        for(edgeid_t i=0; i<numCurr; i++)
+        {
+          edgeid_t e = curr[i];
+
+          for(count_t pos=edgeStart[e]; pos<edgeStart[e+1]; pos++)
+          {
+            count_t t = edgeTris[pos];
+
+            edgeid_t f = (triEdges[3*t]==e) ? triEdges[3*t+1] : triEdges[3*t];
+            edgeid_t g = (triEdges[3*t+2]==e) ? triEdges[3*t+1] : triEdges[3*t+2];
+
+            if(removed[f] || removed[g] || (inCurr[f] && inCurr[g]))
+            {
+              continue;
+            }
+
+            if(inCurr[f])
+            {
+              if(e<f)
+              {
+                decrementSupport(g, level, support, localNext);
+              }
+            }
+            else if(inCurr[g])
+            {
+              if(e<g)
+              {
+                decrementSupport(f, level, support, localNext);
+              }
+            }
+            else
+            {
+              decrementSupport(f, level, support, localNext);
+              decrementSupport(g, level, support, localNext);
+            }
+          }
+        }
+
+        next.insert(next.end(), localNext.begin(), localNext.end());
+      }
+
+      for(edgeid_t i=0; i<numCurr; i++)
+      {
+        inCurr[curr[i]] = 0;
+        removed[curr[i]] = 1;
+      }
+
+      curr.swap(next);
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
 }
 //////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// isNZ -- true if (row,col) is a nonzero
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+bool CSRMat<ordinal_t>::isNZ(int row, ordinal_t col) const
+{
+  return std::binary_search(cols[row].begin(), cols[row].end(), col);
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// insertNZ -- inserts nonzero (row,col) with value val
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+bool CSRMat<ordinal_t>::insertNZ(int row, ordinal_t col, int val)
+{
+  typename std::vector<ordinal_t>::iterator it = std::lower_bound(cols[row].begin(), cols[row].end(), col);
+
+  if(it!=cols[row].end() && *it==col)
+  {
+    return false;
+  }
+
+  int nzIndx = it - cols[row].begin();
+
+  cols[row].insert(it, col);
+  vals[row].insert(vals[row].begin()+nzIndx, val);
+
+  nnzInRow[row]++;
+  nnz++;
+
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// deleteNZ -- removes nonzero (row,col)
+////////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
+bool CSRMat<ordinal_t>::deleteNZ(int row, ordinal_t col)
+{
+  typename std::vector<ordinal_t>::iterator it = std::lower_bound(cols[row].begin(), cols[row].end(), col);
+
+  if(it==cols[row].end() || *it!=col)
+  {
+    return false;
+  }
+
+  int nzIndx = it - cols[row].begin();
+
+  cols[row].erase(it);
+  vals[row].erase(vals[row].begin()+nzIndx);
+
+  nnzInRow[row]--;
+  nnz--;
+
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 unsigned int choose2(unsigned int k)
@@ -718,3 +1062,10 @@ unsigned int choose2(unsigned int k)
   return 0;
 }
 ////////////////////////////////////////////////////////////////////////////////  
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex ID (adjacency) and edge ID (incidence, triangle) matrices
+////////////////////////////////////////////////////////////////////////////////
+template class CSRMat<int>;
+template class CSRMat<edgeid_t>;
+////////////////////////////////////////////////////////////////////////////////
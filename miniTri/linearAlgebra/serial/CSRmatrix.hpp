@@ -59,22 +59,29 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI,INCIDENCE} matrixtype;
 #include <vector>
 #include <map>
 
+#include "miniTriDefs.h"
+
 class Vector;
+class triangleSink;
 
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
+//    -- ordinal_t is the column ID type: int for the adjacency matrix and
+//       its triangular parts (vertex IDs), edgeid_t for the incidence
+//       matrix and the triangle matrix (edge IDs)
 //////////////////////////////////////////////////////////////////////////////
+template<typename ordinal_t>
 class CSRMat 
 {
 
  private:
   matrixtype type;
   int m;   //number of rows
-  int n;   //number of cols
-  int nnz; //number of nonzeros
+  ordinal_t n;   //number of cols
+  count_t nnz; //number of nonzeros
 
   std::vector<int> nnzInRow;                             // nnz in each row
-  std::vector<std::vector<int> > cols;           //columns of nonzeros
+  std::vector<std::vector<ordinal_t> > cols;     //columns of nonzeros
   std::vector<std::vector<int> > vals; //values of nonzeros
   std::vector<std::vector<int> > vals2; //values of nonzeros
 
@@ -100,7 +107,7 @@ class CSRMat
   //////////////////////////////////////////////////////////////////////////
   // constructor -- allocates memory for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-  CSRMat(int _m, int _n,bool allocateVals2=false)
+  CSRMat(int _m, ordinal_t _n,bool allocateVals2=false)
     :type(UNDEFINED),m(_m),n(_n),
      nnzInRow(m),cols(m),
      vals(m)
@@ -144,16 +151,16 @@ class CSRMat
   int getM() const { return m;};
 
   // returns the number of cols
-  int getN() const { return n;};
+  ordinal_t getN() const { return n;};
 
   // returns the number of cols
-  int getNNZ() const { return nnz;};
+  count_t getNNZ() const { return nnz;};
 
   // returns NNZ in row rnum
   inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
 
   // returns column # for nonzero in row rowi at index nzindx
-  inline int getCol(int rowi, int nzindx) const {return cols[rowi][nzindx];};
+  inline ordinal_t getCol(int rowi, int nzindx) const {return cols[rowi][nzindx];};
 
 
   // returns value for nonzero at inddex nzindx
@@ -167,18 +174,55 @@ class CSRMat
   //////////////////////////////////////////////////////////////////
   // level 3 basic linear algebra subroutines
   //////////////////////////////////////////////////////////////////
-  void matmat(const CSRMat &A, const CSRMat &B);
+  void matmat(const CSRMat<int> &A, const CSRMat &B);
   //////////////////////////////////////////////////////////////////
 
+  // K-count bound of a triangle, from triangle vertex and edge degrees
+  unsigned int triangleK(int v1, int v2, int v3,
+                         const Vector &vTriDegrees, const Vector &eTriDegrees,
+                         const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                         unsigned int numKCounts) const;
+
   void computeKCounts(const Vector &vTriDegrees, const Vector &eTriDegrees,
-                      const std::map<int,std::map<int,int> > & edgeInds,
-                      std::vector<int> &kCounts);
+                      const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                      std::vector<count_t> &kCounts);
+
+  //////////////////////////////////////////////////////////////////
+  // Triangle listing -- writes each triangle once (v1 > v2, v3) to
+  // sink, skipping triangles with k-count bound < kMin.  The k-count
+  // bound is only computed (and kMin > 3 only allowed) if triangle
+  // degrees are given.
+  //////////////////////////////////////////////////////////////////
+  void exportTriangles(triangleSink &sink, unsigned int kMin,
+                       const Vector &vTriDegrees, const Vector &eTriDegrees,
+                       const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                       unsigned int numKCounts) const;
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // K-truss decomposition -- trussness of each edge
+  //////////////////////////////////////////////////////////////////
+  void computeTrussness(const Vector &eTriDegrees,
+                        const std::map<int,std::map<int,edgeid_t> > & edgeInds,
+                        std::vector<int> &trussness) const;
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Dynamic updates -- columns of each row are kept sorted
+  //     -- insertNZ returns false if nonzero already exists
+  //     -- deleteNZ returns false if nonzero does not exist
+  //////////////////////////////////////////////////////////////////
+  bool isNZ(int row, ordinal_t col) const;
+  bool insertNZ(int row, ordinal_t col, int val);
+  bool deleteNZ(int row, ordinal_t col);
+  //////////////////////////////////////////////////////////////////
 
   void readMMMatrix(const char* fname);
   void readBinMatrix(const char* fname);
 
   void createTriMatrix(const CSRMat &matrix, matrixtype mtype);
-  void createIncidentMatrix(const CSRMat &matrix, std::map<int,std::map<int,int> > & eIndices);
+  void createIncidentMatrix(const CSRMat<int> &matrix,
+                            std::map<int,std::map<int,edgeid_t> > & eIndices);
 
   void permute();
 
@@ -62,6 +62,8 @@
 #include "Graph.hpp"
 #include "mmio.h"
 
+unsigned int choose2(unsigned int k);
+
 
 //////////////////////////////////////////////////////////////////////////////
 // Enumerate triangles in graph
@@ -102,7 +104,7 @@ void Graph::triangleEnumerate()
 
   gettimeofday(&t1, NULL);
 
-  CSRMat B(INCIDENCE);
+  CSRMat<edgeid_t> B(INCIDENCE);
   B.createIncidentMatrix(mMatrix,mEdgeIndices);
 
   gettimeofday(&t2, NULL);
@@ -126,7 +128,7 @@ void Graph::triangleEnumerate()
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
 
-  std::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getM(),B.getN(),true));
+  std::shared_ptr<CSRMat<edgeid_t> > C(new CSRMat<edgeid_t>(mMatrix.getM(),B.getN(),true));
 
   std::cout << "C = A*B: " << std::endl;
 
@@ -230,26 +232,17 @@ void Graph::printTriangles() const
 {
   std::cout << "Triangles: " << std::endl;
 
-  std::list<int> triangles = mTriMat->getSumElements();
-
-  //Iterate through list and output triangles
-  std::list<int>::const_iterator iter;
-  for (iter=triangles.begin(); iter!=triangles.end(); iter++)
-    {
-      int v1 = *iter+1;
-      iter++;
-      int v2 = *iter+1;
-      iter++;
-      int v3 = *iter+1;
-
-      if(v1>v2 && v1>v3)
-        {
-	  std::cout << "(" << v1;
-	  std::cout << ", " << v2;
-	  std::cout << ", " << v3 << ")" << std::endl;
-        }
-    }
+  textTriangleSink sink(std::cout);
+  exportTriangles(sink);
+}
+//////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Writes triangles in graph to sink
+//////////////////////////////////////////////////////////////////////////////
+void Graph::exportTriangles(triangleSink &sink, unsigned int kMin) const
+{
+  mTriMat->exportTriangles(sink,kMin,mVTriDegrees,mETriDegrees,mEdgeIndices,mKCounts.size());
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -288,3 +281,425 @@ void Graph::printKCounts()
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Approximate triangle count, triangle degrees and k-counts by sampling
+//////////////////////////////////////////////////////////////////////////////
+void Graph::approximateCount(const approxParams &params)
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Estimating triangles ....." << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  approxResult result;
+  approxTriangleCount(mMatrix, params, mKCounts.size(), result);
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to estimate triangles: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished triangle estimation" << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  printApproxResult(params, result);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Calculate k-truss decomposition
+//     -- requires triangle edge degrees
+//////////////////////////////////////////////////////////////////////////////
+void Graph::calculateKTruss()
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Calculating k-truss decomposition ....." << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  mTriMat->computeTrussness(mETriDegrees,mEdgeIndices,mTrussness);
+
+  mTrussCounts.assign(3,0);
+  for(unsigned int e=0; e<mTrussness.size(); e++)
+  {
+    if(mTrussness[e]>=(int)mTrussCounts.size())
+    {
+      mTrussCounts.resize(mTrussness[e]+1,0);
+    }
+    mTrussCounts[mTrussness[e]]++;
+  }
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to compute k-truss decomposition: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished calculating k-truss decomposition" << std::endl;
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Print number of edges with each trussness
+//////////////////////////////////////////////////////////////////////////////
+void Graph::printTrussCounts()
+{
+  std::cout << "Truss-Counts (edges): " << std::endl;
+  for(unsigned int i=2; i<mTrussCounts.size(); i++)
+  {
+    std::cout << "Truss[" << i << "] = " << mTrussCounts[i] << std::endl;
+  }
+  std::cout << "Maximum truss: " << mTrussCounts.size()-1 << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Apply batch of edge insertions and deletions
+//
+// Only triangles with a vertex that is an endpoint or common neighbor of an
+// updated edge can appear, disappear, or change k.  The k-counts of the
+// triangles on these vertices are removed before the batch and added back
+// afterwards.  The common neighbors are taken over the current graph plus
+// the inserted edges, which covers every intermediate graph of the batch.
+//////////////////////////////////////////////////////////////////////////////
+void Graph::applyEdgeUpdates(const std::vector<edgeUpdate_t> &updates)
+{
+  ///////////////////////////////////////////////////////////////////////
+  // Mark affected vertices
+  ///////////////////////////////////////////////////////////////////////
+  std::map<int,std::set<int> > insertedNbrs;
+
+  for(unsigned int i=0; i<updates.size(); i++)
+  {
+    if(updates[i].insert && updates[i].v0!=updates[i].v1)
+    {
+      insertedNbrs[updates[i].v0].insert(updates[i].v1);
+      insertedNbrs[updates[i].v1].insert(updates[i].v0);
+    }
+  }
+
+  std::vector<char> isMarked(mNumVerts,0);
+  std::vector<int> verts;
+
+  for(unsigned int i=0; i<updates.size(); i++)
+  {
+    int v0 = updates[i].v0;
+    int v1 = updates[i].v1;
+
+    if(v0==v1)
+    {
+      continue;
+    }
+
+    std::vector<int> candidates;
+    candidates.push_back(v0);
+    candidates.push_back(v1);
+
+    const std::set<int> &ins0 = insertedNbrs[v0];
+    const std::set<int> &ins1 = insertedNbrs[v1];
+
+    for(int nzIndx=0; nzIndx<mMatrix.getNNZInRow(v0); nzIndx++)
+    {
+      int w = mMatrix.getCol(v0,nzIndx);
+      if(mMatrix.isNZ(v1,w) || ins1.count(w)>0)
+      {
+        candidates.push_back(w);
+      }
+    }
+
+    std::set<int>::const_iterator iter;
+    for(iter=ins0.begin(); iter!=ins0.end(); iter++)
+    {
+      if(mMatrix.isNZ(v1,*iter) || ins1.count(*iter)>0)
+      {
+        candidates.push_back(*iter);
+      }
+    }
+
+    for(unsigned int j=0; j<candidates.size(); j++)
+    {
+      if(isMarked[candidates[j]]==0)
+      {
+        isMarked[candidates[j]] = 1;
+        verts.push_back(candidates[j]);
+      }
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////
+
+  updateKCounts(verts, isMarked, -1);
+
+  ///////////////////////////////////////////////////////////////////////
+  // Apply updates one at a time
+  ///////////////////////////////////////////////////////////////////////
+  std::vector<int> common;
+
+  for(unsigned int i=0; i<updates.size(); i++)
+  {
+    int v0 = updates[i].v0;
+    int v1 = updates[i].v1;
+
+    if(v0==v1)
+    {
+      continue;
+    }
+
+    getCommonNeighbors(v0, v1, common);
+
+    int sign;
+    if(updates[i].insert)
+    {
+      if(mMatrix.insertNZ(v0,v1,1)==false)
+      {
+        continue;
+      }
+      mMatrix.insertNZ(v1,v0,1);
+
+      edgeid_t eID = mETriDegrees.getSize();
+
+      mETriDegrees.resize(eID+1);
+      mETriDegrees.setVal(eID, common.size());
+      mEdgeIndices[std::min(v0,v1)][std::max(v0,v1)] = eID;
+
+      mNumEdges++;
+      sign = 1;
+    }
+    else
+    {
+      if(mMatrix.deleteNZ(v0,v1)==false)
+      {
+        continue;
+      }
+      mMatrix.deleteNZ(v1,v0);
+
+      // Edge ID is retired, its triangle degree stays 0
+      mETriDegrees.setVal(getEdgeID(v0,v1), 0);
+      mEdgeIndices[std::min(v0,v1)].erase(std::max(v0,v1));
+
+      mNumEdges--;
+      sign = -1;
+    }
+
+    int numCommon = common.size();
+
+    mNumTriangles += sign*numCommon;
+    mVTriDegrees.setVal(v0, mVTriDegrees[v0] + sign*numCommon);
+    mVTriDegrees.setVal(v1, mVTriDegrees[v1] + sign*numCommon);
+
+    for(int j=0; j<numCommon; j++)
+    {
+      int w = common[j];
+      edgeid_t e0 = getEdgeID(v0,w);
+      edgeid_t e1 = getEdgeID(v1,w);
+
+      mVTriDegrees.setVal(w, mVTriDegrees[w] + sign);
+      mETriDegrees.setVal(e0, mETriDegrees[e0] + sign);
+      mETriDegrees.setVal(e1, mETriDegrees[e1] + sign);
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////
+
+  updateKCounts(verts, isMarked, 1);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Verify incremental counts against full recompute
+//////////////////////////////////////////////////////////////////////////////
+bool Graph::verifyCounts() const
+{
+  bool passed = true;
+
+  std::map<int,std::map<int,edgeid_t> > edgeInds;
+
+  CSRMat<edgeid_t> B(INCIDENCE);
+  B.createIncidentMatrix(mMatrix,edgeInds);
+
+  CSRMat<edgeid_t> C(mMatrix.getM(),B.getN(),true);
+  C.matmat(mMatrix,B);
+
+  Vector vTriDegrees(mNumVerts);
+  Vector eTriDegrees(B.getN());
+  C.SpMV1(false, vTriDegrees);
+  C.SpMV1(true, eTriDegrees);
+
+  std::vector<count_t> kCounts(mKCounts.size(),0);
+  C.computeKCounts(vTriDegrees,eTriDegrees,edgeInds,kCounts);
+
+  if(C.getNNZ()/3 != mNumTriangles || B.getN() != mNumEdges)
+  {
+    std::cout << "VERIFY - |T|, |E| = " << mNumTriangles << ", " << mNumEdges
+              << ", expected " << C.getNNZ()/3 << ", " << B.getN() << std::endl;
+    passed = false;
+  }
+
+  for(int v=0; v<mNumVerts; v++)
+  {
+    if(vTriDegrees[v] != mVTriDegrees[v])
+    {
+      std::cout << "VERIFY - triangle degree of vertex " << v+1 << " = " 
+                << mVTriDegrees[v] << ", expected " << vTriDegrees[v] << std::endl;
+      passed = false;
+      break;
+    }
+  }
+
+  std::map<int,std::map<int,edgeid_t> >::const_iterator rowIter;
+  std::map<int,edgeid_t>::const_iterator colIter;
+
+  for(rowIter=edgeInds.begin(); rowIter!=edgeInds.end(); rowIter++)
+  {
+    for(colIter=rowIter->second.begin(); colIter!=rowIter->second.end(); colIter++)
+    {
+      count_t degree = mETriDegrees[getEdgeID(rowIter->first,colIter->first)];
+
+      if(eTriDegrees[colIter->second] != degree)
+      {
+        std::cout << "VERIFY - triangle degree of edge (" << rowIter->first+1 
+                  << "," << colIter->first+1 << ") = " << degree << ", expected " 
+                  << eTriDegrees[colIter->second] << std::endl;
+        passed = false;
+        break;
+      }
+    }
+  }
+
+  for(unsigned int k=3; k<kCounts.size(); k++)
+  {
+    if(kCounts[k] != mKCounts[k])
+    {
+      std::cout << "VERIFY - K[" << k << "] = " << mKCounts[k] << ", expected " 
+                << kCounts[k] << std::endl;
+      passed = false;
+    }
+  }
+
+  return passed;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Returns edge ID of existing edge (v0,v1)
+//////////////////////////////////////////////////////////////////////////////
+edgeid_t Graph::getEdgeID(int v0, int v1) const
+{
+  return mEdgeIndices.find(std::min(v0,v1))->second.find(std::max(v0,v1))->second;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Common neighbors of v0 and v1, by merging their sorted rows
+//////////////////////////////////////////////////////////////////////////////
+void Graph::getCommonNeighbors(int v0, int v1, std::vector<int> &common) const
+{
+  common.clear();
+
+  int nz0=0;
+  int nz1=0;
+
+  while(nz0<mMatrix.getNNZInRow(v0) && nz1<mMatrix.getNNZInRow(v1))
+  {
+    int col0 = mMatrix.getCol(v0,nz0);
+    int col1 = mMatrix.getCol(v1,nz1);
+
+    if(col0<col1)
+    {
+      nz0++;
+    }
+    else if(col1<col0)
+    {
+      nz1++;
+    }
+    else
+    {
+      common.push_back(col0);
+      nz0++;
+      nz1++;
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// k of triangle (v0,v1,v2) -- same bound as CSRMat::computeKCounts
+//////////////////////////////////////////////////////////////////////////////
+unsigned int Graph::getTriangleK(int v0, int v1, int v2) const
+{
+  count_t tvMin = std::min(std::min(mVTriDegrees[v0],mVTriDegrees[v1]),
+                           mVTriDegrees[v2]);
+
+  count_t teMin = std::min(std::min(mETriDegrees[getEdgeID(v0,v1)],
+                                    mETriDegrees[getEdgeID(v0,v2)]),
+                           mETriDegrees[getEdgeID(v1,v2)]);
+
+  unsigned int maxK=3;
+  for(unsigned int k=3; k<mKCounts.size(); k++)
+  {
+    if(tvMin >= choose2(k-1) && teMin >= k-2)
+    {
+      maxK = k;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return maxK;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Adds (sign=1) or removes (sign=-1) the k-counts of all triangles with a
+// marked vertex.  Each triangle is counted from its lowest marked vertex.
+//////////////////////////////////////////////////////////////////////////////
+void Graph::updateKCounts(const std::vector<int> &verts, 
+                          const std::vector<char> &isMarked, int sign)
+{
+  for(unsigned int i=0; i<verts.size(); i++)
+  {
+    int v0 = verts[i];
+    int nnzInRow = mMatrix.getNNZInRow(v0);
+
+    for(int nz1=0; nz1<nnzInRow; nz1++)
+    {
+      int v1 = mMatrix.getCol(v0,nz1);
+
+      if(isMarked[v1] && v1<v0)
+      {
+        continue;
+      }
+
+      for(int nz2=nz1+1; nz2<nnzInRow; nz2++)
+      {
+        int v2 = mMatrix.getCol(v0,nz2);
+
+        if((isMarked[v2] && v2<v0) || mMatrix.isNZ(v1,v2)==false)
+        {
+          continue;
+        }
+
+        mKCounts[getTriangleK(v0,v1,v2)] += sign;
+      }
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
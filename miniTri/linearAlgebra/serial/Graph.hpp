@@ -61,6 +61,10 @@
 
 #include "CSRmatrix.hpp"
 #include "Vector.hpp"
+#include "mmUtil.h"
+#include "sampleUtil.h"
+#include "triSinkUtil.h"
+#include "updateUtil.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Graph class
@@ -72,13 +76,13 @@ class Graph
   std::string mFilename;
 
   int mNumVerts;
-  int mNumEdges;
-  CSRMat mMatrix;
+  count_t mNumEdges;
+  CSRMat<int> mMatrix;
 
-  int mNumTriangles;
-  std::shared_ptr<CSRMat> mTriMat;
+  count_t mNumTriangles;
+  std::shared_ptr<CSRMat<edgeid_t> > mTriMat;
 
-  std::map<int,std::map<int,int> > mEdgeIndices;
+  std::map<int,std::map<int,edgeid_t> > mEdgeIndices;
 
 
   Vector mVTriDegrees;
@@ -86,7 +90,21 @@ class Graph
 
 
   // K-count frequency table
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
+
+  // Trussness of each edge, number of edges with each trussness
+  std::vector<int> mTrussness;
+  std::vector<count_t> mTrussCounts;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Helpers for dynamic updates
+  //////////////////////////////////////////////////////////////////////////
+  edgeid_t getEdgeID(int v0, int v1) const;
+  void getCommonNeighbors(int v0, int v1, std::vector<int> &common) const;
+  unsigned int getTriangleK(int v0, int v1, int v2) const;
+  void updateKCounts(const std::vector<int> &verts, const std::vector<char> &isMarked,
+                     int sign);
+  //////////////////////////////////////////////////////////////////////////
 
  public:
   //////////////////////////////////////////////////////////////////////////
@@ -147,10 +165,48 @@ class Graph
   void calculateKCounts();
 
   void printTriangles() const;
-  int getNumTriangles() const {return mNumTriangles;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Writes the triangles (each once) to sink, keeping only triangles with
+  // k-count bound >= kMin (kMin > 3 requires calculateTriangleDegrees)
+  //////////////////////////////////////////////////////////////////////////
+  void exportTriangles(triangleSink &sink, unsigned int kMin=0) const;
+  //////////////////////////////////////////////////////////////////////////
+
+  count_t getNumTriangles() const {return mNumTriangles;};
+  int getNumVerts() const {return mNumVerts;};
 
   void printKCounts();
 
+  // K-truss decomposition
+  void calculateKTruss();
+
+  void printTrussCounts();
+
+  //////////////////////////////////////////////////////////////////////////
+  // Approximate mode -- estimates the triangle count, triangle degrees and
+  // k-counts by sampling the adjacency matrix, without forming B or C
+  //////////////////////////////////////////////////////////////////////////
+  void approximateCount(const approxParams &params);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Dynamic mode -- applies a batch of edge insertions and deletions and
+  // updates the triangle count, triangle degrees and k-counts, visiting
+  // only the neighborhoods of the changed edges.  Requires the triangle
+  // degrees and k-counts of the snapshot; the triangle matrix (and hence
+  // printTriangles, exportTriangles and calculateKTruss) is not updated.
+  //////////////////////////////////////////////////////////////////////////
+  void applyEdgeUpdates(const std::vector<edgeUpdate_t> &updates);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Checks triangle count, triangle degrees and k-counts against a full
+  // recompute of the current graph
+  //////////////////////////////////////////////////////////////////////////
+  bool verifyCounts() const;
+  //////////////////////////////////////////////////////////////////////////
+
 };
 //////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,849 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      OOCGraph.cpp                                                  //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for out-of-core graph class.                    //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "OOCGraph.hpp"
+#include "mmUtil.h"
+#include "mmio.h"
+
+unsigned int choose2(unsigned int k);
+
+namespace
+{
+  // Entries buffered per bucket/spill file before they are written
+  const size_t OOC_FILE_BUFFER = 4096;
+
+  // Bucket files open at the same time while the CSR is built
+  const int OOC_MAX_OPEN_BUCKETS = 256;
+
+  //////////////////////////////////////////////////////////////////////////
+  // File helpers -- exit on I/O errors
+  //////////////////////////////////////////////////////////////////////////
+  FILE *openFile(const std::string &fname, const char *mode)
+  {
+    FILE *fp = fopen(fname.c_str(),mode);
+    if(fp==0)
+    {
+      std::cerr << "Unable to open out-of-core file " << fname << std::endl;
+      exit(1);
+    }
+    return fp;
+  }
+
+  template<typename T>
+  void writeData(FILE *fp, const T *data, size_t count)
+  {
+    if(count>0 && fwrite(data,sizeof(T),count,fp)!=count)
+    {
+      std::cerr << "Error writing out-of-core file" << std::endl;
+      exit(1);
+    }
+  }
+
+  template<typename T>
+  void readData(FILE *fp, T *data, size_t count)
+  {
+    if(count>0 && fread(data,sizeof(T),count,fp)!=count)
+    {
+      std::cerr << "Error reading out-of-core file" << std::endl;
+      exit(1);
+    }
+  }
+
+  void seekFile(FILE *fp, count_t offset)
+  {
+    if(fseeko(fp,(off_t) offset,SEEK_SET)!=0)
+    {
+      std::cerr << "Error seeking out-of-core file" << std::endl;
+      exit(1);
+    }
+  }
+
+  double elapsed(const struct timeval &t1, const struct timeval &t2)
+  {
+    return t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  }
+  //////////////////////////////////////////////////////////////////////////
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes out-of-core options
+//////////////////////////////////////////////////////////////////////////////
+void parseOOCOptions(int &argc, char *argv[], oocParams &params)
+{
+  int newArgc=0;
+
+  for(int i=0; i<argc; i++)
+  {
+    std::string arg(argv[i]);
+
+    if(arg=="--ooc" || arg=="--ooc-dir")
+    {
+      if(i+1>=argc)
+      {
+        std::cerr << "Missing value for " << arg << std::endl;
+        exit(1);
+      }
+
+      std::string val(argv[++i]);
+
+      if(arg=="--ooc" && atoi(val.c_str())>0)
+      {
+        params.memMB = atoi(val.c_str());
+      }
+      else if(arg=="--ooc-dir")
+      {
+        params.tmpDir = val;
+      }
+      else
+      {
+        std::cerr << "Invalid value for " << arg << ": " << val << std::endl;
+        exit(1);
+      }
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+
+  argc = newArgc;
+  argv[argc] = 0;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Constructor -- preprocessing
+//    1. stream the matrix market file to an edge file, counting degrees
+//    2. orient edges by (degree, ID) and count nonzeros per row of L
+//    3. partition rows into blocks, scatter edges into a file per block
+//    4. sort and deduplicate each block, append it to the on-disk CSR
+//////////////////////////////////////////////////////////////////////////////
+OOCGraph::OOCGraph(std::string _fname, const oocParams &params)
+  :mFilename(_fname),mParams(params),mNumVerts(0),mNumEdges(0),mNumTriangles(0),
+   mRowPtr(),mBlockStart(),mBlockNNZ(0),mPoolSize(4),mVTriDegrees(),mKCounts(),
+   mAdjFile(),mDegFile(),mTmpFiles(),mBlocksRead(0),mSpilled(0)
+{
+  struct timeval t1, t2;
+
+  gettimeofday(&t1, NULL);
+
+  //////////////////////////////////////////////////////////////
+  // Per nonzero of the current row block: column, triangle
+  // degree and bucket entry (row, position) -- 16 bytes; per
+  // nonzero of a buffer pool block: column and degree
+  //////////////////////////////////////////////////////////////
+  mBlockNNZ = (((count_t) mParams.memMB)<<20) / (16 + 8*mPoolSize);
+  if(mBlockNNZ < (count_t) OOC_FILE_BUFFER)
+  {
+    mBlockNNZ = OOC_FILE_BUFFER;
+  }
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Stream matrix market file to edge file
+  //////////////////////////////////////////////////////////////
+  MM_typecode matcode;
+  FILE *fp = openFile(mFilename,"r");
+
+  if (mm_read_banner(fp, &matcode) != 0)
+  {
+    std::cerr << "Cannot process MM banner" << std::endl;
+    exit(1);
+  }
+  checkMatrixType(matcode);
+
+  int numRows,numCols;
+  int64_t nnzToRead;
+  if (mm_read_mtx_crd_size(fp, &numRows, &numCols, &nnzToRead) !=0 )
+  {
+    std::cerr << "Cannot read in matrix dimensions" << std::endl;
+    exit(1);
+  }
+  if(numRows!=numCols)
+  {
+    std::cerr << "Invalid graph: Rows must equal Columns" << std::endl;
+    exit(1);
+  }
+  mNumVerts = numRows;
+
+  // Degrees include duplicate entries -- only used for the ordering
+  std::vector<unsigned int> degree(mNumVerts,0);
+
+  std::string edgeFile = tmpName("edges");
+  FILE *efp = openFile(edgeFile,"wb");
+  std::vector<int> ebuf;
+  ebuf.reserve(2*OOC_FILE_BUFFER);
+  count_t numEntries=0;
+
+  for (int64_t i=0; i<nnzToRead; i++)
+  {
+    int tmprow,tmpcol;
+
+    // Values (if any) are skipped
+    if(fscanf(fp, "%d %d%*[^\n]", &tmprow, &tmpcol)!=2 ||
+       tmprow<1 || tmprow>mNumVerts || tmpcol<1 || tmpcol>mNumVerts)
+    {
+      std::cerr << "Invalid entry " << i << " in " << mFilename << std::endl;
+      exit(1);
+    }
+
+    if(tmprow==tmpcol)
+    {
+      continue;
+    }
+
+    degree[tmprow-1]++;
+    degree[tmpcol-1]++;
+    ebuf.push_back(tmprow-1);
+    ebuf.push_back(tmpcol-1);
+    numEntries++;
+
+    if(ebuf.size()>=2*OOC_FILE_BUFFER)
+    {
+      writeData(efp,&(ebuf[0]),ebuf.size());
+      ebuf.clear();
+    }
+  }
+  writeData(efp,ebuf.data(),ebuf.size());
+  fclose(efp);
+  fclose(fp);
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Orient edges from lower to higher (degree, ID) and count
+  // (upper bound on) nonzeros of each row of L
+  //////////////////////////////////////////////////////////////
+  std::vector<int> rank(mNumVerts);
+  {
+    std::vector<int> order(mNumVerts);
+    for(int v=0; v<mNumVerts; v++)
+    {
+      order[v] = v;
+    }
+    std::sort(order.begin(),order.end(),
+              [&degree](int a, int b)
+              {return degree[a]<degree[b] || (degree[a]==degree[b] && a<b);});
+    for(int i=0; i<mNumVerts; i++)
+    {
+      rank[order[i]] = i;
+    }
+  }
+
+  std::fill(degree.begin(),degree.end(),0);
+  std::vector<unsigned int> &rowCnt = degree;
+
+  efp = openFile(edgeFile,"rb");
+  for(count_t e=0; e<numEntries; e+=OOC_FILE_BUFFER)
+  {
+    size_t cnt = std::min((count_t) OOC_FILE_BUFFER,numEntries-e);
+    ebuf.resize(2*cnt);
+    readData(efp,&(ebuf[0]),ebuf.size());
+
+    for(size_t i=0; i<cnt; i++)
+    {
+      int u=ebuf[2*i], v=ebuf[2*i+1];
+      rowCnt[rank[u]<rank[v] ? u : v]++;
+    }
+  }
+  fclose(efp);
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Partition rows into blocks
+  //////////////////////////////////////////////////////////////
+  mBlockStart.push_back(0);
+  count_t blockCnt=0;
+  for(int row=0; row<mNumVerts; row++)
+  {
+    if(blockCnt>0 && blockCnt+rowCnt[row]>mBlockNNZ)
+    {
+      mBlockStart.push_back(row);
+      blockCnt=0;
+    }
+    blockCnt += rowCnt[row];
+  }
+  mBlockStart.push_back(mNumVerts);
+  int numBlocks = mBlockStart.size()-1;
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Scatter oriented edges into a bucket file per block
+  //    -- at most OOC_MAX_OPEN_BUCKETS buckets per pass over
+  //       the edge file
+  //////////////////////////////////////////////////////////////
+  for(int firstBlock=0; firstBlock<numBlocks; firstBlock+=OOC_MAX_OPEN_BUCKETS)
+  {
+    int lastBlock = std::min(numBlocks,firstBlock+OOC_MAX_OPEN_BUCKETS);
+
+    std::vector<FILE *> bfps(lastBlock-firstBlock);
+    std::vector<std::vector<int> > bbufs(lastBlock-firstBlock);
+    for(int b=firstBlock; b<lastBlock; b++)
+    {
+      bfps[b-firstBlock] = openFile(tmpName("bucket",b),"wb");
+      mTmpFiles.push_back(tmpName("bucket",b));
+    }
+
+    efp = openFile(edgeFile,"rb");
+    for(count_t e=0; e<numEntries; e+=OOC_FILE_BUFFER)
+    {
+      size_t cnt = std::min((count_t) OOC_FILE_BUFFER,numEntries-e);
+      ebuf.resize(2*cnt);
+      readData(efp,&(ebuf[0]),ebuf.size());
+
+      for(size_t i=0; i<cnt; i++)
+      {
+        int u=ebuf[2*i], v=ebuf[2*i+1];
+        if(rank[v]<rank[u])
+        {
+          std::swap(u,v);
+        }
+
+        int b = blockOf(u);
+        if(b>=firstBlock && b<lastBlock)
+        {
+          std::vector<int> &bbuf = bbufs[b-firstBlock];
+          bbuf.push_back(u);
+          bbuf.push_back(v);
+          if(bbuf.size()>=2*OOC_FILE_BUFFER)
+          {
+            writeData(bfps[b-firstBlock],&(bbuf[0]),bbuf.size());
+            bbuf.clear();
+          }
+        }
+      }
+    }
+    fclose(efp);
+
+    for(int b=firstBlock; b<lastBlock; b++)
+    {
+      writeData(bfps[b-firstBlock],bbufs[b-firstBlock].data(),bbufs[b-firstBlock].size());
+      fclose(bfps[b-firstBlock]);
+    }
+  }
+
+  remove(edgeFile.c_str());
+  std::vector<int>().swap(rank);
+  std::vector<unsigned int>().swap(degree);
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Sort and deduplicate each block, append to on-disk CSR
+  //////////////////////////////////////////////////////////////
+  mAdjFile = tmpName("adj");
+  mTmpFiles.push_back(mAdjFile);
+  FILE *afp = openFile(mAdjFile,"wb");
+
+  mRowPtr.assign(mNumVerts+1,0);
+
+  for(int b=0; b<numBlocks; b++)
+  {
+    std::string bucketFile = tmpName("bucket",b);
+    FILE *bfp = openFile(bucketFile,"rb");
+    fseeko(bfp,0,SEEK_END);
+    count_t numPairs = ftello(bfp) / (2*sizeof(int));
+    seekFile(bfp,0);
+
+    std::vector<std::pair<int,int> > pairs(numPairs);
+    std::vector<int> tmp(2*numPairs);
+    readData(bfp,tmp.data(),tmp.size());
+    fclose(bfp);
+    remove(bucketFile.c_str());
+
+    for(count_t i=0; i<numPairs; i++)
+    {
+      pairs[i] = std::make_pair(tmp[2*i],tmp[2*i+1]);
+    }
+    std::vector<int>().swap(tmp);
+
+    std::sort(pairs.begin(),pairs.end());
+    pairs.erase(std::unique(pairs.begin(),pairs.end()),pairs.end());
+
+    std::vector<int> cols(pairs.size());
+    for(size_t i=0; i<pairs.size(); i++)
+    {
+      mRowPtr[pairs[i].first+1]++;
+      cols[i] = pairs[i].second;
+    }
+    writeData(afp,cols.data(),cols.size());
+
+    for(int row=mBlockStart[b]; row<mBlockStart[b+1]; row++)
+    {
+      mRowPtr[row+1] += mRowPtr[row];
+    }
+  }
+  fclose(afp);
+
+  mNumEdges = mRowPtr[mNumVerts];
+  //////////////////////////////////////////////////////////////
+
+  int countSize = (int) sqrt(mNumVerts);
+  if(countSize < 10)
+  {
+    countSize = 10;
+  }
+  mKCounts.resize(countSize,0);
+
+  gettimeofday(&t2, NULL);
+
+  std::cout << "OOC - vertices: " << mNumVerts << ", edges: " << mNumEdges
+            << ", blocks: " << numBlocks << ", block nnz: " << mBlockNNZ
+            << ", pool: " << mPoolSize << " blocks" << std::endl;
+  std::cout << "TIME - Time to build on-disk CSR: " << elapsed(t1,t2) << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// destructor -- removes temporary files
+//////////////////////////////////////////////////////////////////////////////
+OOCGraph::~OOCGraph()
+{
+  for(unsigned int i=0; i<mTmpFiles.size(); i++)
+  {
+    remove(mTmpFiles[i].c_str());
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Name of temporary file
+//////////////////////////////////////////////////////////////////////////////
+std::string OOCGraph::tmpName(const std::string &kind, int block)
+{
+  std::ostringstream oss;
+  oss << mParams.tmpDir << "/miniTri_ooc." << getpid() << "." << kind;
+  if(block>=0)
+  {
+    oss << "." << block;
+  }
+  return oss.str();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Block containing row
+//////////////////////////////////////////////////////////////////////////////
+int OOCGraph::blockOf(int row) const
+{
+  return std::upper_bound(mBlockStart.begin(),mBlockStart.end(),row) - mBlockStart.begin() - 1;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads columns (and edge triangle degrees) of a row block
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::readBlock(int block, bool withDegrees, oocBlock &blk)
+{
+  count_t first = mRowPtr[mBlockStart[block]];
+  count_t nnz = mRowPtr[mBlockStart[block+1]] - first;
+
+  blk.block = block;
+  blk.cols.resize(nnz);
+
+  FILE *fp = openFile(mAdjFile,"rb");
+  seekFile(fp,first*sizeof(int));
+  readData(fp,blk.cols.data(),nnz);
+  fclose(fp);
+
+  if(withDegrees)
+  {
+    blk.degs.resize(nnz);
+
+    fp = openFile(mDegFile,"rb");
+    seekFile(fp,first*sizeof(unsigned int));
+    readData(fp,blk.degs.data(),nnz);
+    fclose(fp);
+  }
+
+  mBlocksRead++;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Returns block from buffer pool, reading it in place of the least
+// recently used block if it is not there
+//////////////////////////////////////////////////////////////////////////////
+const OOCGraph::oocBlock & OOCGraph::getPoolBlock(std::vector<oocBlock> &pool, int block,
+                                                  bool withDegrees, count_t useCount)
+{
+  int lru=0;
+  for(unsigned int i=0; i<pool.size(); i++)
+  {
+    if(pool[i].block==block)
+    {
+      pool[i].lastUse = useCount;
+      return pool[i];
+    }
+    if(pool[i].lastUse<pool[lru].lastUse)
+    {
+      lru=i;
+    }
+  }
+
+  readBlock(block,withDegrees,pool[lru]);
+  pool[lru].lastUse = useCount;
+  return pool[lru];
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Enumerates triangles block by block
+//    kPass == false -- count triangles, accumulate vertex triangle degrees
+//                      and write/spill edge triangle degrees
+//    kPass == true  -- compute k-counts from the merged triangle degrees
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::enumerateBlocks(bool kPass)
+{
+  int numBlocks = mBlockStart.size()-1;
+
+  std::vector<oocBlock> pool(mPoolSize);
+  for(int i=0; i<mPoolSize; i++)
+  {
+    pool[i].block = -1;
+    pool[i].lastUse = -1;
+  }
+  count_t useCount=0;
+
+  FILE *degfp = 0;
+  std::vector<std::vector<unsigned int> > spillBufs;
+  std::vector<bool> spillUsed;
+  if(!kPass)
+  {
+    degfp = openFile(mDegFile,"wb");
+    spillBufs.resize(numBlocks);
+    spillUsed.resize(numBlocks,false);
+  }
+
+  for(int b=0; b<numBlocks; b++)
+  {
+    oocBlock R;
+    readBlock(b,kPass,R);
+    if(!kPass)
+    {
+      R.degs.assign(R.cols.size(),0);
+    }
+    count_t base = mRowPtr[mBlockStart[b]];
+
+    //////////////////////////////////////////////////////////
+    // Group nonzeros (u,v) of the block by the block of v
+    //////////////////////////////////////////////////////////
+    std::vector<count_t> bucketStart(numBlocks+1,0);
+    std::vector<int> colBlock(R.cols.size());
+    for(size_t p=0; p<R.cols.size(); p++)
+    {
+      colBlock[p] = blockOf(R.cols[p]);
+      bucketStart[colBlock[p]+1]++;
+    }
+    for(int cb=0; cb<numBlocks; cb++)
+    {
+      bucketStart[cb+1] += bucketStart[cb];
+    }
+
+    std::vector<std::pair<int,unsigned int> > buckets(R.cols.size());
+    {
+      std::vector<count_t> fill(bucketStart.begin(),bucketStart.end()-1);
+      for(int u=mBlockStart[b]; u<mBlockStart[b+1]; u++)
+      {
+        for(count_t p=mRowPtr[u]-base; p<mRowPtr[u+1]-base; p++)
+        {
+          buckets[fill[colBlock[p]]++] = std::make_pair(u,(unsigned int) p);
+        }
+      }
+    }
+    std::vector<int>().swap(colBlock);
+    //////////////////////////////////////////////////////////
+
+    //////////////////////////////////////////////////////////
+    // Intersect rows u and v for each column block
+    //////////////////////////////////////////////////////////
+    for(int cb=0; cb<numBlocks; cb++)
+    {
+      if(bucketStart[cb]==bucketStart[cb+1])
+      {
+        continue;
+      }
+
+      const oocBlock &C = (cb==b) ? R : getPoolBlock(pool,cb,kPass,useCount++);
+      count_t cbase = mRowPtr[mBlockStart[cb]];
+
+      for(count_t i=bucketStart[cb]; i<bucketStart[cb+1]; i++)
+      {
+        int u = buckets[i].first;
+        count_t p = buckets[i].second;
+        int v = R.cols[p];
+
+        count_t iU = mRowPtr[u]-base, endU = mRowPtr[u+1]-base;
+        count_t iV = mRowPtr[v]-cbase, endV = mRowPtr[v+1]-cbase;
+
+        while(iU<endU && iV<endV)
+        {
+          if(R.cols[iU]<C.cols[iV])
+          {
+            iU++;
+          }
+          else if(R.cols[iU]>C.cols[iV])
+          {
+            iV++;
+          }
+          else
+          {
+            int w = R.cols[iU];
+
+            if(!kPass)
+            {
+              mNumTriangles++;
+              mVTriDegrees[u]++;
+              mVTriDegrees[v]++;
+              mVTriDegrees[w]++;
+
+              R.degs[p]++;
+              R.degs[iU]++;
+              if(cb==b)
+              {
+                R.degs[iV]++;
+              }
+              else
+              {
+                spillBufs[cb].push_back((unsigned int) iV);
+                if(spillBufs[cb].size()>=OOC_FILE_BUFFER)
+                {
+                  FILE *sfp = openFile(tmpName("spill",cb),spillUsed[cb] ? "ab" : "wb");
+                  writeData(sfp,spillBufs[cb].data(),spillBufs[cb].size());
+                  fclose(sfp);
+                  mSpilled += spillBufs[cb].size();
+                  spillBufs[cb].clear();
+                  spillUsed[cb] = true;
+                }
+              }
+            }
+            else
+            {
+              count_t tvMin = std::min(std::min(mVTriDegrees[u],mVTriDegrees[v]),mVTriDegrees[w]);
+              unsigned int teMin = std::min(std::min(R.degs[p],R.degs[iU]),C.degs[iV]);
+
+              unsigned int maxK=3;
+              for(unsigned int k=3; k<mKCounts.size(); k++)
+              {
+                if(tvMin >= choose2(k-1) && teMin >= k-2)
+                {
+                  maxK = k;
+                }
+                else
+                {
+                  break;
+                }
+              }
+              mKCounts[maxK]++;
+            }
+
+            iU++;
+            iV++;
+          }
+        }
+      }
+    }
+    //////////////////////////////////////////////////////////
+
+    if(!kPass)
+    {
+      writeData(degfp,R.degs.data(),R.degs.size());
+    }
+  }
+
+  //////////////////////////////////////////////////////////////
+  // Write remaining spilled degrees
+  //////////////////////////////////////////////////////////////
+  if(!kPass)
+  {
+    fclose(degfp);
+
+    for(int cb=0; cb<numBlocks; cb++)
+    {
+      if(spillBufs[cb].size()>0)
+      {
+        FILE *sfp = openFile(tmpName("spill",cb),spillUsed[cb] ? "ab" : "wb");
+        writeData(sfp,spillBufs[cb].data(),spillBufs[cb].size());
+        fclose(sfp);
+        mSpilled += spillBufs[cb].size();
+        spillUsed[cb] = true;
+      }
+      if(spillUsed[cb])
+      {
+        mTmpFiles.push_back(tmpName("spill",cb));
+      }
+    }
+  }
+  //////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Enumerate triangles
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::triangleEnumerate()
+{
+  struct timeval t1, t2;
+
+  gettimeofday(&t1, NULL);
+
+  mDegFile = tmpName("deg");
+  mTmpFiles.push_back(mDegFile);
+
+  mNumTriangles = 0;
+  mVTriDegrees.assign(mNumVerts,0);
+  mBlocksRead = 0;
+  mSpilled = 0;
+
+  enumerateBlocks(false);
+
+  gettimeofday(&t2, NULL);
+
+  std::cout << "OOC - blocks read: " << mBlocksRead
+            << ", spilled edge degree updates: " << mSpilled << std::endl;
+  std::cout << "TIME - Time to enumerate triangles: " << elapsed(t1,t2) << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Merge spilled edge triangle degrees into degree file
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::calculateTriangleDegrees()
+{
+  struct timeval t1, t2;
+
+  gettimeofday(&t1, NULL);
+
+  int numBlocks = mBlockStart.size()-1;
+
+  FILE *degfp = openFile(mDegFile,"r+b");
+
+  for(int b=0; b<numBlocks; b++)
+  {
+    std::string spillFile = tmpName("spill",b);
+    FILE *sfp = fopen(spillFile.c_str(),"rb");
+    if(sfp==0)
+    {
+      continue;
+    }
+
+    count_t first = mRowPtr[mBlockStart[b]];
+    count_t nnz = mRowPtr[mBlockStart[b+1]] - first;
+
+    std::vector<unsigned int> degs(nnz);
+    seekFile(degfp,first*sizeof(unsigned int));
+    readData(degfp,degs.data(),nnz);
+
+    std::vector<unsigned int> sbuf(OOC_FILE_BUFFER);
+    size_t cnt;
+    while((cnt=fread(sbuf.data(),sizeof(unsigned int),sbuf.size(),sfp))>0)
+    {
+      for(size_t i=0; i<cnt; i++)
+      {
+        degs[sbuf[i]]++;
+      }
+    }
+    fclose(sfp);
+    remove(spillFile.c_str());
+
+    seekFile(degfp,first*sizeof(unsigned int));
+    writeData(degfp,degs.data(),nnz);
+  }
+
+  fclose(degfp);
+
+  gettimeofday(&t2, NULL);
+
+  std::cout << "TIME - Time to merge edge triangle degrees: " << elapsed(t1,t2) << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Calculate Kcounts
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::calculateKCounts()
+{
+  struct timeval t1, t2;
+
+  gettimeofday(&t1, NULL);
+
+  std::fill(mKCounts.begin(),mKCounts.end(),0);
+  mBlocksRead = 0;
+
+  enumerateBlocks(true);
+
+  gettimeofday(&t2, NULL);
+
+  std::cout << "OOC - blocks read: " << mBlocksRead << std::endl;
+  std::cout << "TIME - Time to compute K-counts: " << elapsed(t1,t2) << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Print kcounts
+//////////////////////////////////////////////////////////////////////////////
+void OOCGraph::printKCounts()
+{
+  std::cout << "K-Counts: " << std::endl;
+  for(unsigned int i=3; i<mKCounts.size(); i++)
+  {
+    std::cout << "K[" << i << "] = " <<mKCounts[i] << std::endl;
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,182 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      OOCGraph.hpp                                                  //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for out-of-core graph class.                    //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef OOCGRAPH_H
+#define OOCGRAPH_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "miniTriDefs.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Out-of-core settings, set from the command line by parseOOCOptions
+//    memMB  -- memory budget (MB) for the adjacency, edge triangle degree
+//              and buffer pool blocks; vertex arrays are kept in memory
+//              in addition to this
+//    tmpDir -- directory for the on-disk CSR, degree and spill files
+//////////////////////////////////////////////////////////////////////////////
+struct oocParams
+{
+  int memMB;
+  std::string tmpDir;
+
+  oocParams()
+    :memMB(0),tmpDir(".")
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes "--ooc memMB" and "--ooc-dir dir" from argv
+//////////////////////////////////////////////////////////////////////////////
+void parseOOCOptions(int &argc, char *argv[], oocParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Out-of-core graph class
+//
+// Edges are oriented from lower to higher (degree, ID) and the oriented
+// adjacency L is written to disk as CSR, partitioned into blocks of rows
+// whose nonzeros (and triangle degrees of these edges) fit the budget.
+// Only the row pointers and per vertex data stay in memory.
+//
+// A triangle (u,v,w) is found once, from u: v and w are in row u and w is
+// in row v.  Row blocks of L are processed in order; the rows of v are
+// read from column blocks through a small LRU buffer pool, visiting the
+// nonzeros of the row block grouped by the block of v.  Triangle degrees
+// of edges (u,v) and (u,w) are accumulated for the row block, those of
+// (v,w) are spilled to a file per block and merged after enumeration.
+// The k-count pass repeats the enumeration with the merged degrees.
+//////////////////////////////////////////////////////////////////////////////
+class OOCGraph
+{
+
+ private:
+  std::string mFilename;
+  oocParams mParams;
+
+  int mNumVerts;
+  count_t mNumEdges;
+  count_t mNumTriangles;
+
+  // Row pointers of L (vertex IDs unchanged) and row blocks
+  std::vector<count_t> mRowPtr;
+  std::vector<int> mBlockStart;
+  count_t mBlockNNZ;
+  int mPoolSize;
+
+  std::vector<count_t> mVTriDegrees;
+
+  // K-count frequency table
+  std::vector<count_t> mKCounts;
+
+  // Temporary files
+  std::string mAdjFile;
+  std::string mDegFile;
+  std::vector<std::string> mTmpFiles;
+
+  // I/O statistics
+  count_t mBlocksRead;
+  count_t mSpilled;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Buffer pool block -- columns (and triangle degrees) of a row block
+  //////////////////////////////////////////////////////////////////////////
+  struct oocBlock
+  {
+    int block;
+    count_t lastUse;
+    std::vector<int> cols;
+    std::vector<unsigned int> degs;
+  };
+  //////////////////////////////////////////////////////////////////////////
+
+  std::string tmpName(const std::string &kind, int block=-1);
+  int blockOf(int row) const;
+  void readBlock(int block, bool withDegrees, oocBlock &blk);
+  const oocBlock & getPoolBlock(std::vector<oocBlock> &pool, int block,
+                                bool withDegrees, count_t useCount);
+  void enumerateBlocks(bool kPass);
+
+ public:
+  //////////////////////////////////////////////////////////////////////////
+  // Constructor -- builds on-disk CSR of L from matrix market file
+  //////////////////////////////////////////////////////////////////////////
+  OOCGraph(std::string _fname, const oocParams &params);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // destructor -- removes temporary files
+  //////////////////////////////////////////////////////////////////////////
+  ~OOCGraph();
+  //////////////////////////////////////////////////////////////////////////
+
+  // Enumerate triangles, accumulating triangle degrees
+  void triangleEnumerate();
+
+  // Merge spilled edge triangle degrees
+  void calculateTriangleDegrees();
+
+  // Calculate kcounts
+  void calculateKCounts();
+
+  count_t getNumTriangles() const {return mNumTriangles;};
+
+  void printKCounts();
+
+};
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -55,6 +55,8 @@
 
 #include <vector>
 
+#include "miniTriDefs.h"
+
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
 //////////////////////////////////////////////////////////////////////////////
@@ -63,7 +65,7 @@ class Vector
 
  private:
 
-  std::vector<int> mElements;                             // elements in vector
+  std::vector<count_t> mElements;                         // elements in vector
 
  public:
 
@@ -79,7 +81,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // constructor -- allocates memory for CSR sparse matrix
   //////////////////////////////////////////////////////////////////////////
-  Vector(int _m, int _bs=1)
+  Vector(int64_t _m, int _bs=1)
     :mElements(_m)
   {
   };
@@ -107,13 +109,13 @@ class Vector
   //////////////////////////////////////////////////////////////////
 
   // returns the number of rows
-  int getSize() const { return mElements.size();};
+  int64_t getSize() const { return mElements.size();};
 
 
   //////////////////////////////////////////////////////////////////////////
   // v[i] operator -- accessor for elements in vector
   //////////////////////////////////////////////////////////////////////////
-  int operator [](int indx) const
+  count_t operator [](int64_t indx) const
   {
     return mElements[indx];
   }
@@ -121,7 +123,7 @@ class Vector
 
   //////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////
-  void resize(int _m)
+  void resize(int64_t _m)
   {
     mElements.resize(_m);
   }
@@ -130,7 +132,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // setVal -- function sets element indx to be alpha
   //////////////////////////////////////////////////////////////////////////
-  void setVal(int indx,int alpha) 
+  void setVal(int64_t indx,count_t alpha) 
   {
     mElements[indx]=alpha;
   }
@@ -139,7 +141,7 @@ class Vector
   //////////////////////////////////////////////////////////////////////////
   // setVal -- function sets all elements to be alpha
   //////////////////////////////////////////////////////////////////////////
-  void setScalar(int alpha) 
+  void setScalar(count_t alpha) 
   {
     for(unsigned int i=0;i<mElements.size();i++)
     {
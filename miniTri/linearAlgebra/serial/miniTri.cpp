@@ -53,23 +53,59 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <sys/time.h>
 
 #include "Graph.hpp"
+#include "OOCGraph.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  if(argc!=2 && argc!=3)
+  // Triangle export options, removed from argv before the other parsing
+  exportParams exportOpts;
+  parseExportOptions(argc, argv, exportOpts);
+
+  // Out-of-core options
+  oocParams ooc;
+  parseOOCOptions(argc, argv, ooc);
+
+  // K-truss decomposition
+  bool truss = false;
+  int newArgc = 0;
+  for(int i=0; i<argc; i++)
+  {
+    if(std::string(argv[i])=="--truss")
+    {
+      truss = true;
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+  argc = newArgc;
+  argv[argc] = 0;
+
+  // Approximate mode options follow the positional arguments
+  approxParams params;
+  int numArgs = parseApproxOptions(argc, argv, params);
+
+  if(numArgs<2 || numArgs>5 || (numArgs==5 && std::string(argv[4])!="verify"))
   {
-    std::cerr << "Usage: miniTri matrixFile [fileformat ={MM || Bin}]" << std::endl;
+    std::cerr << "Usage: miniTri matrixFile [fileformat ={MM || Bin} [updateFile [verify]]]"
+              << " [--approx method[:param] [--reps R] [--seed S] [--error e]]" 
+              << " [--export file [--export-format {text|bin|delta}] [--kmin k]]"
+              << " [--ooc memMB [--ooc-dir dir]] [--truss]"
+              << std::endl;
+    printApproxUsage();
     exit(1);
   }
 
   std::string mat = argv[1];
   bool isBinFile = false;
 
-  if(argc==3)
+  if(numArgs>=3)
   {
     std::string fileFormat = std::string(argv[2]);
     if(fileFormat == "MM")
@@ -88,7 +124,44 @@ int main(int argc, char *argv[])
   }
 
 
+  ////////////////////////////////////////////////////////////////////////
+  // Out-of-core mode -- triangles and K-counts from an on-disk CSR
+  ////////////////////////////////////////////////////////////////////////
+  if(ooc.memMB>0)
+  {
+    if(isBinFile || numArgs>=4 || params.method!=EXACT_METHOD || !exportOpts.file.empty())
+    {
+      std::cerr << "Out-of-core mode supports MM files only, without edge updates,"
+                << " approximation or export" << std::endl;
+      exit(1);
+    }
+
+    OOCGraph og(mat,ooc);
+
+    og.triangleEnumerate();
+    std::cout << "Number of Triangles: " << og.getNumTriangles() << std::endl;
+
+    og.calculateTriangleDegrees();
+    og.calculateKCounts();
+    og.printKCounts();
+
+    return 0;
+  }
+
   Graph g(mat,isBinFile);
+
+  if(params.method!=EXACT_METHOD)
+  {
+    if(numArgs>=4)
+    {
+      std::cerr << "Edge updates are not supported in approximate mode" << std::endl;
+      exit(1);
+    }
+
+    g.approximateCount(params);
+    return 0;
+  }
+
   g.triangleEnumerate();
   std::cout << "Number of Triangles: " << g.getNumTriangles() << std::endl;
   //   g.printTriangles();
@@ -97,6 +170,74 @@ int main(int argc, char *argv[])
   g.calculateKCounts();
   g.printKCounts();
 
+  ////////////////////////////////////////////////////////////////////////
+  // Triangle listing export
+  ////////////////////////////////////////////////////////////////////////
+  if(!exportOpts.file.empty())
+  {
+    struct timeval te1, te2;
+    triangleSink *sink = createTriangleSink(exportOpts);
+
+    gettimeofday(&te1, NULL);
+    g.exportTriangles(*sink,exportOpts.kMin);
+    gettimeofday(&te2, NULL);
+
+    delete sink;
+
+    double exTime = te2.tv_sec - te1.tv_sec + ((te2.tv_usec-te1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to export triangles (" << exportOpts.format
+              << ", k >= " << exportOpts.kMin << "): " << exTime << std::endl;
+  }
+
+  if(truss)
+  {
+    g.calculateKTruss();
+    g.printTrussCounts();
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Dynamic mode -- apply batches of edge updates to the snapshot
+  ////////////////////////////////////////////////////////////////////////
+  if(numArgs>=4)
+  {
+    bool verify = (numArgs==5);
+    bool passed = true;
+
+    std::vector<std::vector<edgeUpdate_t> > batches;
+    readEdgeUpdates(argv[3], g.getNumVerts(), batches);
+
+    for(unsigned int b=0; b<batches.size(); b++)
+    {
+      struct timeval t1, t2;
+
+      gettimeofday(&t1, NULL);
+      g.applyEdgeUpdates(batches[b]);
+      gettimeofday(&t2, NULL);
+
+      double eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+
+      std::cout << "Batch " << b << ": " << batches[b].size() << " updates, "
+                << "Number of Triangles: " << g.getNumTriangles() << std::endl;
+      std::cout << "TIME - Time to apply batch: " << eTime << std::endl;
+
+      if(verify)
+      {
+        bool batchPassed = g.verifyCounts();
+        std::cout << "VERIFY - Batch " << b << (batchPassed ? ": PASSED" : ": FAILED")
+                  << std::endl;
+        passed = passed && batchPassed;
+      }
+    }
+
+    g.printKCounts();
+
+    if(!passed)
+    {
+      exit(1);
+    }
+  }
+  ////////////////////////////////////////////////////////////////////////
+
 
 }
 //////////////////////////////////////////////////////////////////////////////
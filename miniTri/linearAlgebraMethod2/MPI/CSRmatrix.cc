@@ -57,6 +57,7 @@
 #include <list>
 #include <map>
 #include <set>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
@@ -68,6 +69,8 @@ void printSubmat(const CSRSubmat &submat, int startRow,int locNumRows);
 
 int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
 
+void sortTriangle(triangle_t &tri);
+
 void createPermutation(int *degree, std::vector<int> &perm, std::vector<int> &iperm);
 void formDegreeMultiMap(int *degree, int size, std::multimap<int,int> &degreeMap);
 
@@ -76,6 +79,11 @@ void serialSubmatrixMult(const CSRSubmat & submatA, int numRows,
 			 const CSRSubmat & submatB, int startRowB,
 			 std::vector<std::map<int,std::list<int> > > & submatCNZs);
 
+void serialSubmatrixMaskedMult(const CSRSubmat & submatA, int numRows,
+                               const CSRSubmat & submatB, int startRowB,
+                               const CSRSubmat & submatM, int startRowM,
+                               std::vector<triangle_t> &triangles);
+
 void sendRecvSubmat(const CSRSubmat &submatToSend, int dst, int numRowsSend, int startRowSend, 
 		    MPI_Comm comm,int src, CSRSubmat &remSubmat,int &numRowsRecv,int &recvSubmatStartRow);
 
@@ -130,11 +138,14 @@ void printSubmat(const CSRSubmat &submat, int startRow, int locNumRows)
 
 ////////////////////////////////////////////////////////////////////////////////
 // Sums matrix elements -- Each processor calculates their share, no reduction.
+//    -- Each element list holds the 3 vertices of each of its triangles
 ////////////////////////////////////////////////////////////////////////////////
-std::list<int> CSRMat::getSumElements() const
+void CSRMat::getSumElements(std::vector<triangle_t> &triangles) const
 {
-  std::list<int> matList;
   std::list<int>::const_iterator it;
+  triangle_t tri;
+
+  triangles.clear();
 
   ///////////////////////////////////////////////////////////////////////////
   // Local operation
@@ -148,16 +159,19 @@ std::list<int> CSRMat::getSumElements() const
       int nrows = submat.nnzInRow[rownum];
       for(int nzIdx=0; nzIdx<nrows; nzIdx++)
       {
-        for (it = submat.vals[rownum][nzIdx].begin(); it != submat.vals[rownum][nzIdx].end(); ++it) 
+        for (it = submat.vals[rownum][nzIdx].begin(); it != submat.vals[rownum][nzIdx].end(); ) 
         {
-          matList.push_back(*it);
+          tri[0] = *it++;
+          tri[1] = *it++;
+          tri[2] = *it++;
+
+          sortTriangle(tri);
+          triangles.push_back(tri);
         }
       }
     }
   }
   ///////////////////////////////////////////////////////////////////////////
-
-  return matList;
 }
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -325,7 +339,75 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   } // loop over submats
   ///////////////////////////////////////////////////////////////////////////
 
-  MPI_Allreduce(&mLocNNZ, &mGlobNNZ, 1, MPI_INT, MPI_SUM,mComm);
+  MPI_Allreduce(&mLocNNZ, &mGlobNNZ, 1, MPI_INT64_T, MPI_SUM,mComm);
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// maskedMatmat -- triangles of (A*B) .* M, where M = this
+//              -- same communication pattern as matmat, but each wedge is
+//                 tested against M's local rows as it is formed and only
+//                 closing wedges are kept, so memory is O(triangles)
+//////////////////////////////////////////////////////////////////////////////
+void CSRMat::maskedMatmat(const CSRMat &A, const CSRMat &B,
+                          std::vector<triangle_t> &triangles) const
+{
+  assert(mLocNumRows == A.getLocNumRows());
+
+  triangles.clear();
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Completely local computation
+  //       Processor 0's perspective: C(1,*) += A(1,1)*B(1,*)
+  ///////////////////////////////////////////////////////////////////////////
+  const CSRSubmat & submatA = A.getSubMatrix(mMyRank);
+
+  for(int submatNum=0; submatNum<mWorldSize; submatNum++)
+  {
+    //////////////////////////////////////////////////////////////////////
+    // Block: (A(myrank,myrank) * B(myrank,submatNum)) .* M(myrank,submatNum)
+    //////////////////////////////////////////////////////////////////////
+    serialSubmatrixMaskedMult(submatA,A.getLocNumRows(),
+                              B.getSubMatrix(submatNum),B.getStartRow(),
+                              mSubmat[submatNum],mStartRow,triangles);
+    //////////////////////////////////////////////////////////////////////
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Communication/Partially remote compuation
+  ///////////////////////////////////////////////////////////////////////////
+  for(int phase=1; phase<mWorldSize; phase++)
+  {
+    int src = (mMyRank + phase) % mWorldSize;
+    int dst = (mMyRank + mWorldSize-phase) % mWorldSize;
+
+    for(int submatNum=0; submatNum<mWorldSize; submatNum++)
+    {
+      const CSRSubmat & submatBToSend = B.getSubMatrix(submatNum);
+
+      int remStartRowB=0;
+      int remNumRowsB=0;
+
+      CSRSubmat remSubmatB; 
+
+      sendRecvSubmat(submatBToSend,dst,B.getLocNumRows(),B.getStartRow(),
+		     mComm,src,remSubmatB,remNumRowsB,remStartRowB);
+
+      //////////////////////////////////////////////////////////////////////
+      // Block: (A(myrank,src) * B(src,submatNum)) .* M(myrank,submatNum)
+      //////////////////////////////////////////////////////////////////////
+      serialSubmatrixMaskedMult(A.getSubMatrix(src),A.getLocNumRows(),
+                                remSubmatB,remStartRowB,
+                                mSubmat[submatNum],mStartRow,triangles);
+
+      freeSubmat(remSubmatB,remNumRowsB);
+      //////////////////////////////////////////////////////////////////////
+    }
+
+  }
+  ///////////////////////////////////////////////////////////////////////////
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,7 +554,7 @@ void CSRMat::EWMult(const CSRMat &W)
   ///////////////////////////////////////////////////////////////////////////
   // Sum mLocNNZ over all processes to obtain mGlobNNZ
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -614,7 +696,7 @@ void CSRMat::readMMMatrix(const char *fname)
   ///////////////////////////////////////////////////////////////////////////
   // Sum mLocNNZ over all processes to obtain mGlobNNZ
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -705,7 +787,7 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
   ///////////////////////////////////////////////////////////////////////////
   // Sum mLocNNZ over all processes to obtain mGlobNNZ
   ///////////////////////////////////////////////////////////////////////////
-  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNNZ,&mGlobNNZ,1,MPI_INT64_T, MPI_SUM, mComm);
   ///////////////////////////////////////////////////////////////////////////
 
 }
@@ -835,6 +917,59 @@ void serialSubmatrixMult(const CSRSubmat & submatA, int numARows,
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Masked serial submatrix multiply -- appends triangles of
+//    (A*B) .* M for one block, where M's rows are sorted
+//////////////////////////////////////////////////////////////////////////////
+void serialSubmatrixMaskedMult(const CSRSubmat & submatA, int numARows,
+                               const CSRSubmat & submatB, int startRowB,
+                               const CSRSubmat & submatM, int startRowM,
+                               std::vector<triangle_t> &triangles)
+{
+  triangle_t tri;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Compute masked entries one row at a time
+  ///////////////////////////////////////////////////////////////////////////
+  for (int rownum=0; rownum<numARows; rownum++)
+  {
+    const int *colsM = submatM.cols[rownum];
+    const int *endColsM = colsM + submatM.nnzInRow[rownum];
+
+    if(colsM==endColsM)
+    {
+      continue;
+    }
+
+    int nnzInRowA = submatA.nnzInRow[rownum];
+
+    for(int nzindxA=0; nzindxA<nnzInRowA; nzindxA++)
+    {
+      int colA = submatA.cols[rownum][nzindxA];
+
+      int nnzInRowB = submatB.nnzInRow[colA-startRowB];
+
+      for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
+      {
+        int colB=submatB.cols[colA-startRowB][nzindxB];
+
+        if(std::binary_search(colsM,endColsM,colB))
+        {
+          tri[0] = startRowM+rownum;
+          tri[1] = colA;
+          tri[2] = colB;
+
+          sortTriangle(tri);
+          triangles.push_back(tri);
+        }
+      }
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Send/recv submatrix
 //////////////////////////////////////////////////////////////////////////////
@@ -1031,6 +1166,26 @@ void sendRecvSubmat(const CSRSubmat &submatToSend, int dst,
 //////////////////////////////////////////////////////////////////////////////
 
 
+//////////////////////////////////////////////////////////////////////////////
+// sortTriangle -- orders the vertices of a triangle in increasing order
+//////////////////////////////////////////////////////////////////////////////
+void sortTriangle(triangle_t &tri)
+{
+  if(tri[0]>tri[1])
+  {
+    std::swap(tri[0],tri[1]);
+  }
+  if(tri[1]>tri[2])
+  {
+    std::swap(tri[1],tri[2]);
+  }
+  if(tri[0]>tri[1])
+  {
+    std::swap(tri[0],tri[1]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
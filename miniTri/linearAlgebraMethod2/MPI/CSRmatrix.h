@@ -61,6 +61,7 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI} matrixtype;
 #include <mpi.h>
 
 #include "mmUtil.h"
+#include "miniTriDefs.h"
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -84,9 +85,9 @@ class CSRMat
   matrixtype type;
   int mGlobNumRows;   //number of global rows
   int mGlobNumCols;   //number of global cols
-  int mGlobNNZ;       //number of global nonzeros
+  count_t mGlobNNZ;   //number of global nonzeros
   int mLocNumRows;
-  int mLocNNZ;
+  count_t mLocNNZ;
   int mStartRow;
 
   std::vector<CSRSubmat> mSubmat;
@@ -196,9 +197,10 @@ class CSRMat
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
-  // Sums matrix elements
+  // Sums matrix elements into flat triangle buffer, with the
+  // vertices of each triangle in increasing order
   //////////////////////////////////////////////////////////////////
-  std::list<int> getSumElements() const;
+  void getSumElements(std::vector<triangle_t> &triangles) const;
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
@@ -211,7 +213,7 @@ class CSRMat
   int getGlobNumCols() const { return mGlobNumCols;};
 
   // returns the global number of nonzeros
-  int getGlobNNZ() const { return mGlobNNZ;};
+  count_t getGlobNNZ() const { return mGlobNNZ;};
 
   // returns the local number of cols
   int getLocNumRows() const { return mLocNumRows;};
@@ -256,6 +258,14 @@ class CSRMat
   void EWMult(const CSRMat &W);
   //////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////
+  // Fused (A*B) .* M, where M = this -- emits the local triangles of
+  // the masked product without forming A*B
+  //////////////////////////////////////////////////////////////////
+  void maskedMatmat(const CSRMat &A, const CSRMat &B,
+                    std::vector<triangle_t> &triangles) const;
+  //////////////////////////////////////////////////////////////////
+
 
   void readMMMatrix(const char* fname);
 
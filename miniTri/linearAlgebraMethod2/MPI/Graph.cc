@@ -145,82 +145,30 @@ void Graph::triangleEnumerate()
   ///////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////
-  // B = L*U
+  // Enumerate triangles, B = (L*U) .* L, fused
   ///////////////////////////////////////////////////////////////////////
   if(mMyRank==0)
   {
     std::cout << "--------------------" << std::endl;
-    std::cout << "B = L*U: " << std::endl;
+    std::cout << "B = (L*U) .* L: " << std::endl;
   }
 
-  CSRMat B(L.getGlobNumRows(),U.getGlobNumCols(),mComm);
-
-  MPI_Barrier(mComm);
-  gettimeofday(&t1, NULL);
-  B.matmat(L,U);
-
-  MPI_Barrier(mComm);
-  gettimeofday(&t2, NULL);
-
-  //B.print();
-
-  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-
-  if(mMyRank==0)
-  {
-    std::cout << "TIME - Time to compute B = L*U: " << eTime << std::endl;
-
-    std::cout << "--------------------" << std::endl;
-  }
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // B = B .* L
-  ///////////////////////////////////////////////////////////////////////
-  if(mMyRank==0)
-  {
-    std::cout << "--------------------" << std::endl;
-    std::cout << "B = B .* L: " << std::endl;
-  }
   MPI_Barrier(mComm);
   gettimeofday(&t1, NULL);
-  B.EWMult(L);
-  MPI_Barrier(mComm);
-  gettimeofday(&t2, NULL);
-
-  //  B.print();
-
-  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-
-
-  if(mMyRank==0)
-  {
-    std::cout << "TIME - Time to compute B = B .* L: " << eTime << std::endl;
-    std::cout << "--------------------" << std::endl;
-  }
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // Enumerate triangles
-  ///////////////////////////////////////////////////////////////////////
-  if(mMyRank==0)
-    std::cout << "--------------------" << std::endl;
+  L.maskedMatmat(L,U,mTriangles);
 
   MPI_Barrier(mComm);
-  gettimeofday(&t1, NULL);
-  mTriangles = B.getSumElements();
   gettimeofday(&t2, NULL);
 
-  assert(mTriangles.size() % 3 == 0);
-  mLocNumTriangles = mTriangles.size() / 3;
+  mLocNumTriangles = mTriangles.size();
 
-  MPI_Allreduce(&mLocNumTriangles,&mGlobNumTriangles,1,MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&mLocNumTriangles,&mGlobNumTriangles,1,MPI_INT64_T, MPI_SUM, mComm);
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
 
   if(mMyRank==0)
   {
-    std::cout << "TIME - Time to sum up triangles: " << eTime << std::endl;
+    std::cout << "TIME - Time to compute triangles of B = (L*U) .* L: " << eTime << std::endl;
 
     std::cout << "--------------------" << std::endl;
   }
@@ -245,14 +193,12 @@ void Graph::printTriangles() const
   std::cout << "Triangles: " << std::endl;
 
   //Iterate through list and output triangles
-  std::list<int>::const_iterator iter;
+  std::vector<triangle_t>::const_iterator iter;
   for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
   {
-    std::cout << "(" << *iter+1;
-    iter++;
-    std::cout << ", " << *iter+1;
-    iter++;
-    std::cout << ", " << *iter+1 << ")" << std::endl;
+    std::cout << "(" << (*iter)[0]+1;
+    std::cout << ", " << (*iter)[1]+1;
+    std::cout << ", " << (*iter)[2]+1 << ")" << std::endl;
   }
 }
 //////////////////////////////////////////////////////////////////////////////
@@ -263,22 +209,20 @@ void Graph::printTriangles() const
 //////////////////////////////////////////////////////////////////////////////
 void Graph::calculateTriangleDegrees()
 {
-  std::map<int,int>::iterator vdIter;
+  std::map<int,count_t>::iterator vdIter;
 
-  std::map<int,std::map<int,int> >::iterator edIter1;
-  std::map<int,int>::iterator edIter2;
+  std::map<int,std::map<int,count_t> >::iterator edIter1;
+  std::map<int,count_t>::iterator edIter2;
 
 
   //Iterate through list of triangles
-  std::list<int>::const_iterator iter;
+  std::vector<triangle_t>::const_iterator iter;
   int numEdgesInTriangles=0;
   for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
   {
-    int v1 = *iter;
-    iter++;
-    int v2 = *iter;
-    iter++;
-    int v3 = *iter;
+    int v1 = (*iter)[0];
+    int v2 = (*iter)[1];
+    int v3 = (*iter)[2];
     /////////////////////////////////
     // Increment triangle degree of v1
     /////////////////////////////////
@@ -407,7 +351,7 @@ void Graph::calculateTriangleDegrees()
   ////////////////////////////////////////////////////////
   // Pack vertex degrees to send
   ////////////////////////////////////////////////////////
-  std::vector<int> sendPacked(2*mVDegrees.size());
+  std::vector<count_t> sendPacked(2*mVDegrees.size());
 
   unsigned int indx=0;
   for (vdIter=mVDegrees.begin(); vdIter!=mVDegrees.end(); vdIter++)
@@ -435,11 +379,11 @@ void Graph::calculateTriangleDegrees()
                  &recvSize, 1, MPI_INT, src, 0, mComm, &status);
 
 
-    std::vector<int> recvPacked(recvSize);
+    std::vector<count_t> recvPacked(recvSize);
 
 
-    MPI_Sendrecv(&(sendPacked[0]), sendSize, MPI_INT, dst, 0,
-                 &(recvPacked[0]), recvSize, MPI_INT, src, 0, mComm, &status);
+    MPI_Sendrecv(&(sendPacked[0]), sendSize, MPI_INT64_T, dst, 0,
+                 &(recvPacked[0]), recvSize, MPI_INT64_T, src, 0, mComm, &status);
 
     // Sum counts if vertex exists in this process's triangles
     for(int i=0;i<recvSize/2;i++)
@@ -488,10 +432,10 @@ void Graph::calculateTriangleDegrees()
     MPI_Sendrecv(&sendSize, 1, MPI_INT, dst, 0,
                  &recvSize, 1, MPI_INT, src, 0, mComm, &status);
 
-    std::vector<int> recvPacked(recvSize);
+    std::vector<count_t> recvPacked(recvSize);
 
-    MPI_Sendrecv(&(sendPacked[0]), sendSize, MPI_INT, dst, 0,
-                 &(recvPacked[0]), recvSize, MPI_INT, src, 0, mComm, &status);
+    MPI_Sendrecv(&(sendPacked[0]), sendSize, MPI_INT64_T, dst, 0,
+                 &(recvPacked[0]), recvSize, MPI_INT64_T, src, 0, mComm, &status);
 
     // Sum counts if edge exists in this process's triangles
     for(int i=0;i<recvSize/3;i++)
@@ -531,99 +475,21 @@ void Graph::calculateTriangleDegrees()
 }
 //////////////////////////////////////////////////////////////////////////////
 
-//////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////////////////////////////////////////////////
-void Graph::orderTriangles()
-{
-  int tmpV1, tmpV2, tmpV3;
-
-  //Iterate through list of triangles
-  std::list<int>::iterator iter1,iter2,iter3;
-  for (iter1=mTriangles.begin(); iter1!=mTriangles.end(); iter1++)
-  {
-    iter2=iter1; iter2++;
-    iter3=iter2; iter3++;
-
-    tmpV1 = *iter1;
-    tmpV2 = *iter2;
-    tmpV3 = *iter3;
-
-    /////////////////////////////////
-    // order triangles
-    /////////////////////////////////
-    if(tmpV1 < tmpV2)
-    {
-      if (tmpV1 < tmpV3)
-      {
-        *iter1 = tmpV1;
-        if(tmpV2<tmpV3)
-	{
-          *iter2 = tmpV2;
-          *iter3 = tmpV3;
-	}
-        else
-	{
-          *iter2 = tmpV3;
-          *iter3 = tmpV2;
-	}
-      }
-      else
-      {
-        *iter1 = tmpV3;
-        *iter2 = tmpV1;
-        *iter3 = tmpV2;
-      }
-
-    }
-    else 
-    {
-      if (tmpV1 < tmpV3)
-      {
-        *iter1 = tmpV2;
-        *iter2 = tmpV1;
-        *iter3 = tmpV3;
-      }
-      else 
-      {
-        *iter3 = tmpV1;
-        if(tmpV2<tmpV3)
-	{
-          *iter1 = tmpV2;
-          *iter2 = tmpV3;
-	}
-        else
-	{
-          *iter1 = tmpV3;
-          *iter2 = tmpV2;
-	}
-      }
-    }
-    /////////////////////////////////
-
-    iter1++;
-    iter1++;
-  }
-
-}
-//////////////////////////////////////////////////////////////////////////////
-
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 void Graph::calculateKCounts()
 {
-  std::vector<int> locKCounts(mKCounts.size());
+  std::vector<count_t> locKCounts(mKCounts.size());
 
 
-  std::list<int>::const_iterator iter;
+  std::vector<triangle_t>::const_iterator iter;
   for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
   {
-    int v1=*iter;
-    iter++;
-    int v2=*iter;
-    iter++;
-    int v3=*iter;
+    int v1 = (*iter)[0];
+    int v2 = (*iter)[1];
+    int v3 = (*iter)[2];
 
-    unsigned int tvMin, teMin;
+    count_t tvMin, teMin;
 
     findMinTriDegrees(v1,v2,v3,tvMin,teMin);
 
@@ -645,7 +511,7 @@ void Graph::calculateKCounts()
 
   // Reduce frequency table across processors
   // not sure if src/dst buffs can be same.
-  MPI_Allreduce(&(locKCounts[0]),&(mKCounts[0]),locKCounts.size(), MPI_INT, MPI_SUM, mComm);
+  MPI_Allreduce(&(locKCounts[0]),&(mKCounts[0]),locKCounts.size(), MPI_INT64_T, MPI_SUM, mComm);
 
 
 }
@@ -665,18 +531,18 @@ void Graph::printKCounts()
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-void Graph::findMinTriDegrees(int v1, int v2, int v3, unsigned int &tvMin, unsigned int &teMin)
+void Graph::findMinTriDegrees(int v1, int v2, int v3, count_t &tvMin, count_t &teMin)
 {
 
   /////////////////////////////////////////////////////////////////////////
   // Find tvMin
   /////////////////////////////////////////////////////////////////////////
   tvMin = mVDegrees[v1];
-  if(mVDegrees[v2] < (int) tvMin)
+  if(mVDegrees[v2] < tvMin)
   {
     tvMin=mVDegrees[v2];
   }
-  if(mVDegrees[v3] < (int) tvMin)
+  if(mVDegrees[v3] < tvMin)
   {
     tvMin=mVDegrees[v3];
   }
@@ -685,11 +551,11 @@ void Graph::findMinTriDegrees(int v1, int v2, int v3, unsigned int &tvMin, unsig
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
   teMin = mEDegrees[v1][v2];
-  if(mEDegrees[v1][v3] < (int) teMin)
+  if(mEDegrees[v1][v3] < teMin)
   {
     teMin=mEDegrees[v1][v3];
   }
-  if(mEDegrees[v2][v3] < (int) teMin)
+  if(mEDegrees[v2][v3] < teMin)
   {
     teMin=mEDegrees[v2][v3];
   }
@@ -74,16 +74,16 @@ class Graph
   int mNumVerts;
   CSRMat mMatrix;
 
-  int mGlobNumTriangles;
-  int mLocNumTriangles;
-  std::list<int> mTriangles; //contains triangles in graph
+  count_t mGlobNumTriangles;
+  count_t mLocNumTriangles;
+  std::vector<triangle_t> mTriangles; //contains triangles in graph
 
   // Degree info
-  std::map<int,int> mVDegrees;
-  std::map<int,std::map<int,int> > mEDegrees;
+  std::map<int,count_t> mVDegrees;
+  std::map<int,std::map<int,count_t> > mEDegrees;
 
   // K-count frequency table
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
 
   // MPI info
   MPI_Comm mComm;
@@ -96,7 +96,7 @@ class Graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
     :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), 
-    mGlobNumTriangles(0), mLocNumTriangles(0), mTriangles(0),
+    mGlobNumTriangles(0), mLocNumTriangles(0), mTriangles(),
     mVDegrees(), mEDegrees(), mKCounts(0),
     mComm(MPI_COMM_WORLD)
   {
@@ -110,7 +110,7 @@ class Graph
   //////////////////////////////////////////////////////////////////////////
  Graph(std::string _fname,MPI_Comm _comm) 
    :mFilename(_fname), mVertProp(0),mMatrix(_comm), mGlobNumTriangles(0), 
-    mLocNumTriangles(0),mTriangles(0),
+    mLocNumTriangles(0),mTriangles(),
     mVDegrees(), mEDegrees(), mKCounts(),
     mComm(_comm)
   {
@@ -147,15 +147,12 @@ class Graph
 
   void printTriangles() const;
 
-  int getGlobNumTriangles() const {return mGlobNumTriangles;};
-
-  void orderTriangles();
-
+  count_t getGlobNumTriangles() const {return mGlobNumTriangles;};
 
   void calculateTriangleDegrees();
   void calculateKCounts();
 
-  void findMinTriDegrees(int v1, int v2, int v3, unsigned int &tvMin, unsigned int &teMin);
+  void findMinTriDegrees(int v1, int v2, int v3, count_t &tvMin, count_t &teMin);
 
   void printKCounts();
 
@@ -76,7 +76,6 @@ int main(int argc, char *argv[])
 
   Graph g(mat,MPI_COMM_WORLD);
   g.triangleEnumerate();
-  g.orderTriangles();
   g.calculateTriangleDegrees();
   g.calculateKCounts();
 
@@ -103,8 +103,7 @@ void Graph::triangleEnumerate()
 
   gettimeofday(&t1, NULL);
 
-  CSRMat L(LOWERTRI);
-  L.createTriMatrix(mMatrix, LOWERTRI);
+  mLowerMat.createTriMatrix(mMatrix, LOWERTRI);
 
   CSRMat U(UPPERTRI);
   U.createTriMatrix(mMatrix, UPPERTRI);
@@ -123,60 +122,19 @@ void Graph::triangleEnumerate()
   ///////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////
-  // B = L*U
+  // Enumerate triangles, B = (L*U) .* L, fused
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
-
-  CSRMat B(L.getM(),U.getN());
-
-  std::cout << "B = L*U: " << std::endl;
+  std::cout << "B = (L*U) .* L: " << std::endl;
 
   gettimeofday(&t1, NULL);
-  B.matmat(L,U);
+  mLowerMat.maskedMatmat(mLowerMat,U,mTriangles);
   gettimeofday(&t2, NULL);
 
-  //  B.print();
+  mNumTriangles = mTriangles.size();
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to compute B = L*U: " << eTime << std::endl;
-
-  std::cout << "--------------------" << std::endl;
-
-  std::cout << "NNZ: " << B.getNNZ() << std::endl;
-
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // B = B .* L
-  ///////////////////////////////////////////////////////////////////////
-  std::cout << "--------------------" << std::endl;
-  std::cout << "B = B .* L: " << std::endl;
-
-  gettimeofday(&t1, NULL);
-  B.EWMult(L);
-  gettimeofday(&t2, NULL);
-
-  //  B.print();
-
-  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to compute B = B .* L: " << eTime << std::endl;
-  std::cout << "--------------------" << std::endl;
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // Enumerate triangles
-  ///////////////////////////////////////////////////////////////////////
-  std::cout << "--------------------" << std::endl;
-
-  gettimeofday(&t1, NULL);
-  mTriangles = B.getSumElements();
-  gettimeofday(&t2, NULL);
-
-  assert(mTriangles.size() % 3 == 0);
-  mNumTriangles = mTriangles.size() / 3;
-
-  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to sum up triangles: " << eTime << std::endl;
+  std::cout << "TIME - Time to compute triangles of B = (L*U) .* L: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
@@ -198,157 +156,75 @@ void Graph::printTriangles() const
   std::cout << "Triangles: " << std::endl;
 
   //Iterate through list and output triangles
-  std::list<int>::const_iterator iter;
+  std::vector<triangle_t>::const_iterator iter;
   for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
   {
-    std::cout << "(" << *iter+1;
-    iter++;
-    std::cout << ", " << *iter+1;
-    iter++;
-    std::cout << ", " << *iter+1 << ")" << std::endl;
+    std::cout << "(" << (*iter)[0]+1;
+    std::cout << ", " << (*iter)[1]+1;
+    std::cout << ", " << (*iter)[2]+1 << ")" << std::endl;
   }
 }
 //////////////////////////////////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////////////////////////////////
+// Calculates triangle degrees of vertices and edges
 //
 // Note: Assumes triangles are in order by vertex
+//   -- Edge (v,w), v>w, is identified by the position of nonzero (v,w)
+//      in L.  The edge IDs of each triangle are saved in mTriEdges.
 //////////////////////////////////////////////////////////////////////////////
 void Graph::calculateTriangleDegrees()
 {
-  std::map<int,int>::iterator vdIter;
-
-  std::map<int,std::map<int,int> >::iterator edIter1;
-  std::map<int,int>::iterator edIter2;
-
-  //Iterate through list of triangles
-  std::list<int>::const_iterator iter;
-  int numEdgesInTriangles=0;
-  for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
+  ///////////////////////////////////////////////////////////////////////
+  // Edge ID offset of each row of L
+  ///////////////////////////////////////////////////////////////////////
+  std::vector<edgeid_t> edgeOffsets(mNumVerts+1,0);
+  for(int rownum=0; rownum<mNumVerts; rownum++)
   {
-    int v1 = *iter;
-    iter++;
-    int v2 = *iter;
-    iter++;
-    int v3 = *iter;
+    edgeOffsets[rownum+1] = edgeOffsets[rownum] + mLowerMat.getNNZInRow(rownum);
+  }
+  ///////////////////////////////////////////////////////////////////////
 
-    /////////////////////////////////
-    // Increment triangle degree of v1
-    /////////////////////////////////
-    vdIter = mVDegrees.find(v1);
-    if(vdIter != mVDegrees.end())
-    {
-      (*vdIter).second++;
-    }
-    else
-    {
-      mVDegrees[v1]=1;
-    }
-    /////////////////////////////////
+  mVDegrees.assign(mNumVerts,0);
+  mEDegrees.assign(edgeOffsets[mNumVerts],0);
+  mTriEdges.resize(mTriangles.size());
 
-    /////////////////////////////////
-    // Increment triangle degree of v2
-    /////////////////////////////////
-    vdIter = mVDegrees.find(v2);
-    if(vdIter != mVDegrees.end())
-    {
-      (*vdIter).second++;
-    }
-    else
-    {
-      mVDegrees[v2]=1;
-    }
-    /////////////////////////////////
-
-    /////////////////////////////////
-    // Increment triangle degree of v3
-    /////////////////////////////////
-    vdIter = mVDegrees.find(v3);
-    if(vdIter != mVDegrees.end())
-    {
-      (*vdIter).second++;
-    }
-    else
-    {
-      mVDegrees[v3]=1;
-    }
-    /////////////////////////////////
+  //Iterate through list of triangles
+  count_t numTriangles = mTriangles.size();
 
-    /////////////////////////////////
-    // Increment triangle degree of edge v1,v2
-    /////////////////////////////////
-    edIter1 = mEDegrees.find(v1);
-    if(edIter1 != mEDegrees.end())
-    {
-      edIter2 = (*edIter1).second.find(v2);
+#pragma omp parallel for schedule(static)
+  for (count_t triID=0; triID<numTriangles; triID++)
+  {
+    int v1 = mTriangles[triID][0];
+    int v2 = mTriangles[triID][1];
+    int v3 = mTriangles[triID][2];
 
-      if(edIter2 != (*edIter1).second.end())
-      {
-        (*edIter2).second++;
-      }
-      else
-      {
-        (*edIter1).second[v2]=1;
-	numEdgesInTriangles++;
-      }
-    }
-    else
-    {
-      mEDegrees[v1][v2]=1;
-      numEdgesInTriangles++;
-    }
     /////////////////////////////////
-
+    // Find IDs of edges v1,v2 v1,v3 v2,v3
     /////////////////////////////////
-    // Increment triangle degree of edge v1,v3
+    std::array<edgeid_t,3> &triEdges = mTriEdges[triID];
+    triEdges[0] = edgeOffsets[v2] + mLowerMat.findNZ(v2,v1);
+    triEdges[1] = edgeOffsets[v3] + mLowerMat.findNZ(v3,v1);
+    triEdges[2] = edgeOffsets[v3] + mLowerMat.findNZ(v3,v2);
     /////////////////////////////////
-    edIter1 = mEDegrees.find(v1);
-    if(edIter1 != mEDegrees.end())
-    {
-      edIter2 = (*edIter1).second.find(v3);
 
-      if(edIter2 != (*edIter1).second.end())
-      {
-        (*edIter2).second++;
-      }
-      else
-      {
-        (*edIter1).second[v3]=1;
-        numEdgesInTriangles++;
-      }
-    }
-    else
-    {
-      mEDegrees[v1][v3]=1;
-      numEdgesInTriangles++;
-    }
     /////////////////////////////////
-
+    // Increment triangle degrees of vertices and edges
     /////////////////////////////////
-    // Increment triangle degree of edge v2,v3
+#pragma omp atomic
+    mVDegrees[v1]++;
+#pragma omp atomic
+    mVDegrees[v2]++;
+#pragma omp atomic
+    mVDegrees[v3]++;
+#pragma omp atomic
+    mEDegrees[triEdges[0]]++;
+#pragma omp atomic
+    mEDegrees[triEdges[1]]++;
+#pragma omp atomic
+    mEDegrees[triEdges[2]]++;
     /////////////////////////////////
-    edIter1 = mEDegrees.find(v2);
-    if(edIter1 != mEDegrees.end())
-    {
-      edIter2 = (*edIter1).second.find(v3);
-
-      if(edIter2 != (*edIter1).second.end())
-      {
-        (*edIter2).second++;
-      }
-      else
-      {
-        (*edIter1).second[v3]=1;
-	numEdgesInTriangles++;
-      }
-    }
-    else
-    {
-      mEDegrees[v2][v3]=1;
-      numEdgesInTriangles++;
-    }
-    ////////////////////////////////
   }
 
 }
@@ -356,110 +232,43 @@ void Graph::calculateTriangleDegrees()
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-void Graph::orderTriangles()
+void Graph::calculateKCounts()
 {
-  int tmpV1, tmpV2, tmpV3;
+  count_t numTriangles = mTriangles.size();
 
-  //Iterate through list of triangles
-  std::list<int>::iterator iter1,iter2,iter3;
-  for (iter1=mTriangles.begin(); iter1!=mTriangles.end(); iter1++)
+#pragma omp parallel
   {
-    iter2=iter1; iter2++;
-    iter3=iter2; iter3++;
-
-    tmpV1 = *iter1;
-    tmpV2 = *iter2;
-    tmpV3 = *iter3;
+    std::vector<count_t> threadKCounts(mKCounts.size(),0);
 
-    /////////////////////////////////
-    // order triangles
-    /////////////////////////////////
-    if(tmpV1 < tmpV2)
+#pragma omp for schedule(static) nowait
+    for (count_t triID=0; triID<numTriangles; triID++)
     {
-      if (tmpV1 < tmpV3)
-      {
-        *iter1 = tmpV1;
-	if(tmpV2<tmpV3)
-	{
-	  *iter2 = tmpV2;
-	  *iter3 = tmpV3;
-	}
-	else
-	{
-	  *iter2 = tmpV3;
-	  *iter3 = tmpV2;
-	}
-      }
-      else
-      {
-        *iter1 = tmpV3;
-        *iter2 = tmpV1;
-        *iter3 = tmpV2;
-      }
+      count_t tvMin, teMin;
 
-    }
-    else
-    {
-      if (tmpV1 < tmpV3)
-      {
-        *iter1 = tmpV2;
-        *iter2 = tmpV1;
-        *iter3 = tmpV3;
-      }
-      else
+      findMinTriDegrees(triID,tvMin,teMin);
+
+      int maxK=3;
+      for(unsigned int k=3; k<threadKCounts.size(); k++)
       {
-        *iter3 = tmpV1;
-        if(tmpV2<tmpV3)
+        if(tvMin >= choose2(k-1) && teMin >= k-2)
         {
-          *iter1 = tmpV2;
-	  *iter2 = tmpV3;
+          maxK = k;
         }
         else
         {
-          *iter1 = tmpV3;
-	  *iter2 = tmpV2;
+          break;
         }
-      } 
+      }
+      threadKCounts[maxK]++;
     }
-    /////////////////////////////////
-
-    iter1++;
-    iter1++;
-  }
 
-}
-//////////////////////////////////////////////////////////////////////////////
-
-//////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////////////////////////////////////////////////
-void Graph::calculateKCounts()
-{
-  std::list<int>::const_iterator iter;
-  for (iter=mTriangles.begin(); iter!=mTriangles.end(); iter++)
-  {
-    int v1=*iter;
-    iter++;
-    int v2=*iter;
-    iter++;
-    int v3=*iter;
-
-    unsigned int tvMin, teMin;
-
-    findMinTriDegrees(v1,v2,v3,tvMin,teMin);
-
-    int maxK=3;
-    for(unsigned int k=3; k<mKCounts.size(); k++)
+#pragma omp critical
     {
-      if(tvMin >= choose2(k-1) && teMin >= k-2)
+      for(unsigned int k=0; k<mKCounts.size(); k++)
       {
-        maxK = k;
-      }
-      else
-      {
-        break;
+        mKCounts[k] += threadKCounts[k];
       }
     }
-    mKCounts[maxK]++;
   }
 
 }
@@ -480,33 +289,36 @@ void Graph::printKCounts()
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-void Graph::findMinTriDegrees(int v1, int v2, int v3, unsigned int &tvMin, unsigned int &teMin)
+void Graph::findMinTriDegrees(count_t triID, count_t &tvMin, count_t &teMin) const
 {
+  const triangle_t &tri = mTriangles[triID];
+  const std::array<edgeid_t,3> &triEdges = mTriEdges[triID];
+
   /////////////////////////////////////////////////////////////////////////
   // Find tvMin
   /////////////////////////////////////////////////////////////////////////
-  tvMin = mVDegrees[v1];
-  if(mVDegrees[v2] < (int) tvMin)
+  tvMin = mVDegrees[tri[0]];
+  if(mVDegrees[tri[1]] < tvMin)
   {
-    tvMin=mVDegrees[v2];
+    tvMin=mVDegrees[tri[1]];
   }
-  if(mVDegrees[v3] < (int) tvMin)
+  if(mVDegrees[tri[2]] < tvMin)
   {
-    tvMin=mVDegrees[v3];
+    tvMin=mVDegrees[tri[2]];
   }
   /////////////////////////////////////////////////////////////////////////
 
   /////////////////////////////////////////////////////////////////////////
   // Find teMin
   /////////////////////////////////////////////////////////////////////////
-  teMin = mEDegrees[v1][v2];
-  if(mEDegrees[v1][v3] < (int) teMin)
+  teMin = mEDegrees[triEdges[0]];
+  if(mEDegrees[triEdges[1]] < teMin)
   {
-    teMin=mEDegrees[v1][v3];
+    teMin=mEDegrees[triEdges[1]];
   }
-  if(mEDegrees[v2][v3] < (int) teMin)
+  if(mEDegrees[triEdges[2]] < teMin)
   {
-    teMin=mEDegrees[v2][v3];
+    teMin=mEDegrees[triEdges[2]];
   }
   /////////////////////////////////////////////////////////////////////////
 }
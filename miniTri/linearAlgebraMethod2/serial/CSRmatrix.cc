@@ -57,19 +57,21 @@
 #include <list>
 #include <map>
 #include <set>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 #include "CSRmatrix.h"
 #include "mmUtil.h"
+#include "permUtil.h"
 #include "mmio.h"
 
 int addNZ(std::map<int,std::list<int> > &nzMap,int col, int elemToAdd);
 
+void sortTriangle(triangle_t &tri);
+
 std::list<int> invalidList;
 
-void createPermutation(int *degree, std::vector<int> &perm, std::vector<int> &iperm);
-void formDegreeMultiMap(int *degree, int size, std::multimap<int,int> &degreeMap);
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -100,26 +102,31 @@ void CSRMat::print() const
 
 ////////////////////////////////////////////////////////////////////////////////
 // Sums matrix elements
+//    -- Each element list holds the 3 vertices of each of its triangles
 ////////////////////////////////////////////////////////////////////////////////
-std::list<int> CSRMat::getSumElements() const
+void CSRMat::getSumElements(std::vector<triangle_t> &triangles) const
 {
-  std::list<int> matList;
   std::list<int>::const_iterator it;
+  triangle_t tri;
+
+  triangles.clear();
 
   for(int rownum=0; rownum<m; rownum++)
   {
     int nrows = nnzInRow[rownum];
     for(int nzIdx=0; nzIdx<nrows; nzIdx++)
     {
-
-      for (it = vals[rownum][nzIdx].begin(); it != vals[rownum][nzIdx].end(); ++it) 
+      for (it = vals[rownum][nzIdx].begin(); it != vals[rownum][nzIdx].end(); ) 
       {
-        matList.push_back(*it);
+        tri[0] = *it++;
+        tri[1] = *it++;
+        tri[2] = *it++;
+
+        sortTriangle(tri);
+        triangles.push_back(tri);
       }
     }
   }
-
-  return matList;
 }
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -185,7 +192,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   // Compute matrix entries one row at a time
   ///////////////////////////////////////////////////////////////////////////
   nnz =0;
-  int tmpNNZ =0;
+  count_t tmpNNZ =0;
   for (int rownum=0; rownum<m; rownum++)
   {
     nnzInRow[rownum]=0;
@@ -256,6 +263,62 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
 }
 ////////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// maskedMatmat -- triangles of (A*B) .* M, where M = this
+//              -- each wedge (rownum,colA,colB) of A*B is tested against
+//                 the marked columns of M's row and only closing wedges
+//                 are kept, so memory is O(triangles) instead of O(wedges)
+//////////////////////////////////////////////////////////////////////////////
+void CSRMat::maskedMatmat(const CSRMat &A, const CSRMat &B,
+                          std::vector<triangle_t> &triangles) const
+{
+  assert(m == A.getM());
+  assert(n == B.getN());
+
+  triangles.clear();
+
+  // colMarker[col] == rownum iff M(rownum,col) is nonzero
+  std::vector<int> colMarker(n,-1);
+  triangle_t tri;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Compute masked entries one row at a time
+  ///////////////////////////////////////////////////////////////////////////
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    for(int nzIndx=0; nzIndx<nnzInRow[rownum]; nzIndx++)
+    {
+      colMarker[cols[rownum][nzIndx]] = rownum;
+    }
+
+    int nnzInRowA = A.getNNZInRow(rownum);
+
+    for(int nzindxA=0; nzindxA<nnzInRowA; nzindxA++)
+    {
+      int colA=A.getCol(rownum, nzindxA);
+
+      int nnzInRowB = B.getNNZInRow(colA);
+
+      for(int nzindxB=0; nzindxB<nnzInRowB; nzindxB++)
+      {
+        int colB=B.getCol(colA, nzindxB);
+
+        if(colMarker[colB]==rownum)
+        {
+          tri[0] = rownum;
+          tri[1] = colA;
+          tri[2] = colB;
+
+          sortTriangle(tri);
+          triangles.push_back(tri);
+        }
+      }
+    }
+  } // end loop over rows
+  ///////////////////////////////////////////////////////////////////////////
+}
+////////////////////////////////////////////////////////////////////////////////
+
 ////////////////////////////////////////////////////////////////////////////////
 // EWMult -- A = A .* W, where A = this
 ////////////////////////////////////////////////////////////////////////////////
@@ -399,7 +462,7 @@ void CSRMat::readMMMatrix(const char *fname)
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
@@ -420,7 +483,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<nnz; i++)
+  for (int64_t i=0; i<nnz; i++)
   {
     if(type==UNDEFINED)
     {
@@ -558,10 +621,10 @@ void CSRMat::createTriMatrix(const CSRMat &matSrc, matrixtype mtype)
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::permute()
 {
-  std::vector<int> perm(m);
-  std::vector<int> iperm(m);
+  std::vector<int> perm;
+  std::vector<int> iperm;
 
-  createPermutation(nnzInRow, perm, iperm);
+  createDegreePermutation(nnzInRow, m, perm, iperm);
 
   ///////////////////////////////////////////////////////////////////////////
   // Set temp pointers to save original order
@@ -583,23 +646,35 @@ void CSRMat::permute()
   ///////////////////////////////////////////////////////////////////////////
   for(int rownum=0; rownum<m; rownum++)
   {
-    //////////////////////////////////////////////////////////////////////
-    // Copy data into permuted order
-    //////////////////////////////////////////////////////////////////////
-    nnzInRow[rownum] = tmpNNZ[iperm[rownum]];    
-    cols[rownum] = tmpCols[iperm[rownum]];
-    
+    int origRow = iperm[rownum];
+    int rowNNZ = tmpNNZ[origRow];
+    int *rowCols = tmpCols[origRow];
+    std::list<int> *origVals = tmpVals[origRow];
+
     /////////////////////////////////////////////////////////////////
-    // permute column numbers as well -- perhaps should sort this
+    // permute column numbers as well, sorted with their original index
     /////////////////////////////////////////////////////////////////
-    for(int i=0;i<nnzInRow[rownum];i++)
+    std::vector<std::pair<int,int> > colOrder(rowNNZ);
+    for(int i=0;i<rowNNZ;i++)
     {
-      cols[rownum][i] = perm[cols[rownum][i]];
+      colOrder[i] = std::make_pair(perm[rowCols[i]],i);
     }
+    std::sort(colOrder.begin(),colOrder.end());
     /////////////////////////////////////////////////////////////////
 
-    vals[rownum] = tmpVals[iperm[rownum]];
+    //////////////////////////////////////////////////////////////////////
+    // Copy data into permuted order, reusing the column array
+    //////////////////////////////////////////////////////////////////////
+    nnzInRow[rownum] = rowNNZ;
+    cols[rownum] = rowCols;
+    vals[rownum] = new std::list<int>[rowNNZ];
 
+    for(int i=0;i<rowNNZ;i++)
+    {
+      rowCols[i] = colOrder[i].first;
+      vals[rownum][i].swap(origVals[colOrder[i].second]);
+    }
+    delete [] origVals;
     //////////////////////////////////////////////////////////////////////
 
   }
@@ -608,42 +683,26 @@ void CSRMat::permute()
 }
 ////////////////////////////////////////////////////////////////////////////////
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-void createPermutation(int *degree, std::vector<int> &perm, std::vector<int> &iperm)
-{
-   std::multimap<int,int> degreeMMap;
-   formDegreeMultiMap(degree,perm.size(),degreeMMap);
-
-   std::multimap<int,int>::const_iterator iter;
-   int cnt=0;
-   for(iter=degreeMMap.begin(); iter!=degreeMMap.end(); ++iter)
-   {
-       perm[(*iter).second] = cnt;
-       iperm[cnt] = (*iter).second;
-       cnt++;
-   }
-}
-////////////////////////////////////////////////////////////////////////////////
-
 //////////////////////////////////////////////////////////////////////////////
-// Form sorted multimap of (degree,rownum) pairs, currently sorted in increasing order
+// sortTriangle -- orders the vertices of a triangle in increasing order
 //////////////////////////////////////////////////////////////////////////////
-void formDegreeMultiMap(int *degree, int size, std::multimap<int,int> &degreeMMap)
+void sortTriangle(triangle_t &tri)
 {
-  for(int i=0; i<size; i++)
+  if(tri[0]>tri[1])
+  {
+    std::swap(tri[0],tri[1]);
+  }
+  if(tri[1]>tri[2])
   {
-    degreeMMap.insert(std::pair<int, int>(degree[i], i));
+    std::swap(tri[1],tri[2]);
+  }
+  if(tri[0]>tri[1])
+  {
+    std::swap(tri[0],tri[1]);
   }
 }
 //////////////////////////////////////////////////////////////////////////////
 
-
-
-
-
-
-
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
@@ -58,9 +58,11 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI} matrixtype;
 #include <list>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 
 #include "mmio.h"
+#include "miniTriDefs.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
@@ -72,7 +74,7 @@ class CSRMat
   matrixtype type;
   int m;   //number of rows
   int n;   //number of cols
-  int nnz; //number of nonzeros
+  count_t nnz; //number of nonzeros
 
   int *nnzInRow;         // number of nonzeros in each row
   int **cols;            //columns of nonzeros
@@ -162,9 +164,10 @@ class CSRMat
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
-  // Sums matrix elements
+  // Sums matrix elements into flat triangle buffer, with the
+  // vertices of each triangle in increasing order
   //////////////////////////////////////////////////////////////////
-  std::list<int> getSumElements() const;
+  void getSumElements(std::vector<triangle_t> &triangles) const;
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
@@ -177,7 +180,7 @@ class CSRMat
   int getN() const { return n;};
 
   // returns the number of cols
-  int getNNZ() const { return nnz;};
+  count_t getNNZ() const { return nnz;};
 
   // returns NNZ in row rnum
   inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
@@ -190,6 +193,19 @@ class CSRMat
   inline const std::list<int> & getVal(int rowi, int nzindx) const 
     {return vals[rowi][nzindx];};
 
+  // returns index of nonzero in row rowi with column colj, -1 if none
+  //   -- assumes columns in row are sorted
+  inline int findNZ(int rowi, int colj) const 
+  {
+    const int *rowCols = cols[rowi];
+    const int *nzPtr = std::lower_bound(rowCols,rowCols+nnzInRow[rowi],colj);
+    if(nzPtr==rowCols+nnzInRow[rowi] || *nzPtr!=colj)
+    {
+      return -1;
+    }
+    return nzPtr-rowCols;
+  };
+
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
@@ -199,6 +215,14 @@ class CSRMat
   void EWMult(const CSRMat &W);
   //////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////
+  // Fused (A*B) .* M, where M = this -- emits the triangles of the
+  // masked product without forming A*B
+  //////////////////////////////////////////////////////////////////
+  void maskedMatmat(const CSRMat &A, const CSRMat &B,
+                    std::vector<triangle_t> &triangles) const;
+  //////////////////////////////////////////////////////////////////
+
   void readMMMatrix(const char* fname);
 
   void createTriMatrix(const CSRMat &matrix, matrixtype mtype);
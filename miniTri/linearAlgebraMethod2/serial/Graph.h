@@ -73,16 +73,18 @@ class Graph
 
   int mNumVerts;
   CSRMat mMatrix;
+  CSRMat mLowerMat; // L, its nonzeros also number the edges
 
-  int mNumTriangles;
-  std::list<int> mTriangles; //contains triangles in graph
+  count_t mNumTriangles;
+  std::vector<triangle_t> mTriangles; //contains triangles in graph
 
-  // Degree info                                                                                                                                                            
-  std::map<int,int> mVDegrees;
-  std::map<int,std::map<int,int> > mEDegrees;
+  // Degree info -- edges indexed by edge ID (position of edge in L)
+  std::vector<count_t> mVDegrees;
+  std::vector<count_t> mEDegrees;
+  std::vector<std::array<edgeid_t,3> > mTriEdges; //edge IDs of each triangle's edges
 
   // K-count frequency table                                                                                                                                                
-  std::vector<int> mKCounts;
+  std::vector<count_t> mKCounts;
 
 
  public:
@@ -90,8 +92,8 @@ class Graph
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mNumTriangles(0), mTriangles(0),
-    mVDegrees(), mEDegrees(), mKCounts(0)
+    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mLowerMat(LOWERTRI), mNumTriangles(0), 
+    mTriangles(), mVDegrees(), mEDegrees(), mTriEdges(), mKCounts(0)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -100,8 +102,8 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string _fname) 
-    :mFilename(_fname), mVertProp(0),mMatrix(), mNumTriangles(0), mTriangles(0),
-    mVDegrees(), mEDegrees(), mKCounts(0)
+    :mFilename(_fname), mVertProp(0),mMatrix(), mLowerMat(LOWERTRI), mNumTriangles(0), 
+    mTriangles(), mVDegrees(), mEDegrees(), mTriEdges(), mKCounts(0)
   {
      mMatrix.readMMMatrix(mFilename.c_str());
      mNumVerts = mMatrix.getM();
@@ -134,14 +136,13 @@ class Graph
 
   void printTriangles() const;
 
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
 
   void calculateTriangleDegrees();
-  void orderTriangles();
   void calculateKCounts();
   void printKCounts();
 
-  void findMinTriDegrees(int v1, int v2, int v3, unsigned int &tvMin, unsigned int &teMin);
+  void findMinTriDegrees(count_t triID, count_t &tvMin, count_t &teMin) const;
 
 };
 //////////////////////////////////////////////////////////////////////////////
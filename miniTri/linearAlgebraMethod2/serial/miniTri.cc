@@ -70,7 +70,6 @@ int main(int argc, char *argv[])
 
   Graph g(mat);
   g.triangleEnumerate();
-  g.orderTriangles();
   g.calculateTriangleDegrees();
   g.calculateKCounts();
 
@@ -53,6 +53,18 @@
 #ifndef MINITRIDEFS_H
 #define MINITRIDEFS_H
 
+#include <stdint.h>
+#include <array>
+
+//////////////////////////////////////////////////////////////////////////////
+// Vertex IDs are stored as int (range checked when graph is built).  Edge
+// IDs, the columns of the incidence and triangle matrices, are edgeid_t.
+// Quantities that can exceed the int range on large graphs -- nonzero
+// counts, triangle counts, triangle degrees and k-counts -- are count_t.
+//////////////////////////////////////////////////////////////////////////////
+typedef int64_t count_t;
+typedef int64_t edgeid_t;
+
 typedef struct {
   int64_t v0;
   int64_t v1;
@@ -64,5 +76,10 @@ typedef struct {
   int v2;
 } dualVal_t;
 
+//////////////////////////////////////////////////////////////////////////////
+// Triangle as its three vertex IDs, stored in increasing order
+//////////////////////////////////////////////////////////////////////////////
+typedef std::array<int,3> triangle_t;
+
 
 #endif
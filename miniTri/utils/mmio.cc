@@ -12,6 +12,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <inttypes.h>
 
 #include "mmio.h"
 
@@ -190,7 +191,7 @@ int mm_write_mtx_crd_size(std::ofstream &ofs, int M, int N, int nz)
         return 0;
 }
 
-int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int *nz )
+int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int64_t *nz )
 {
     char line[MM_MAX_LINE_LENGTH];
     int num_items_read;
@@ -206,13 +207,13 @@ int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int *nz )
     }while (line[0] == '%');
 
     /* line[] is either blank or has M,N, nz */
-    if (sscanf(line, "%d %d %d", M, N, nz) == 3)
+    if (sscanf(line, "%d %d %" SCNd64, M, N, nz) == 3)
         return 0;
         
     else
     do
     { 
-        num_items_read = fscanf(f, "%d %d %d", M, N, nz); 
+        num_items_read = fscanf(f, "%d %d %" SCNd64, M, N, nz); 
         if (num_items_read == EOF) return MM_PREMATURE_EOF;
     }
     while (num_items_read != 3);
@@ -220,6 +221,15 @@ int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int *nz )
     return 0;
 }
 
+int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int *nz )
+{
+    int64_t nz64;
+    int ret_code = mm_read_mtx_crd_size(f, M, N, &nz64);
+
+    *nz = (int) nz64;
+    return ret_code;
+}
+
 
 int mm_read_mtx_array_size(FILE *f, int *M, int *N)
 {
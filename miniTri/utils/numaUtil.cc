@@ -0,0 +1,327 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      numaUtil.cc                                                   //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for memory placement and thread binding on      //
+//              NUMA nodes (Linux).  Uses the system calls directly, so     //
+//              libnuma is not needed.                                      //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "numaUtil.h"
+
+// From linux/mempolicy.h
+#define MINITRI_MPOL_INTERLEAVE 3
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes NUMA options
+//////////////////////////////////////////////////////////////////////////////
+void parseNumaOptions(int &argc, char *argv[], numaParams &params)
+{
+  int newArgc=0;
+
+  for(int i=0; i<argc; i++)
+  {
+    std::string arg(argv[i]);
+
+    if(arg=="--interleave")
+    {
+      params.interleave = true;
+    }
+    else if(arg=="--bind" || arg=="--places")
+    {
+      if(i+1>=argc)
+      {
+        std::cerr << "Missing value for " << arg << std::endl;
+        exit(1);
+      }
+
+      std::string val(argv[++i]);
+
+      if(arg=="--bind" && (val=="none" || val=="close" || val=="spread"))
+      {
+        params.bind = val;
+      }
+      else if(arg=="--places" && (val=="threads" || val=="cores" || val=="sockets"))
+      {
+        params.places = val;
+      }
+      else
+      {
+        std::cerr << "Invalid value for " << arg << ": " << val << std::endl;
+        exit(1);
+      }
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+
+  argc = newArgc;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses Linux cpu/node list, e.g. "0-3,8"
+//////////////////////////////////////////////////////////////////////////////
+static std::vector<int> parseIDList(const std::string &list)
+{
+  std::vector<int> ids;
+  std::stringstream ss(list);
+  std::string range;
+
+  while(std::getline(ss,range,','))
+  {
+    if(range.empty())
+    {
+      continue;
+    }
+
+    size_t dash = range.find('-');
+    int first = atoi(range.substr(0,dash).c_str());
+    int last = (dash==std::string::npos) ? first : atoi(range.substr(dash+1).c_str());
+
+    for(int id=first; id<=last; id++)
+    {
+      ids.push_back(id);
+    }
+  }
+
+  return ids;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads integer from sysfs file, -1 if not available
+//////////////////////////////////////////////////////////////////////////////
+static int readSysInt(const std::string &fname)
+{
+  std::ifstream file(fname.c_str());
+  int val=-1;
+
+  if(!(file >> val))
+  {
+    return -1;
+  }
+
+  return val;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Places: sets of CPUs (of those this process may run on), ordered by
+// socket, core and hardware thread
+//////////////////////////////////////////////////////////////////////////////
+static std::vector<std::vector<int> > findPlaces(const std::string &places)
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+
+  std::map<std::pair<int,int>, std::vector<int> > cpusOfCore;
+
+  for(int cpu=0; cpu<CPU_SETSIZE; cpu++)
+  {
+    if(!CPU_ISSET(cpu,&allowed))
+    {
+      continue;
+    }
+
+    std::ostringstream dir;
+    dir << "/sys/devices/system/cpu/cpu" << cpu << "/topology/";
+
+    int socket = readSysInt(dir.str()+"physical_package_id");
+    int core = readSysInt(dir.str()+"core_id");
+
+    // Without topology information each CPU is its own core
+    if(core<0)
+    {
+      core = cpu;
+    }
+
+    cpusOfCore[std::make_pair(socket,core)].push_back(cpu);
+  }
+
+  std::vector<std::vector<int> > placeList;
+  std::map<std::pair<int,int>, std::vector<int> >::const_iterator iter;
+
+  int prevSocket=-2;
+  for(iter=cpusOfCore.begin(); iter!=cpusOfCore.end(); iter++)
+  {
+    int socket = (*iter).first.first;
+    const std::vector<int> &cpus = (*iter).second;
+
+    if(places=="threads")
+    {
+      for(unsigned int t=0; t<cpus.size(); t++)
+      {
+        placeList.push_back(std::vector<int>(1,cpus[t]));
+      }
+    }
+    else if(places=="sockets" && socket==prevSocket)
+    {
+      placeList.back().insert(placeList.back().end(),cpus.begin(),cpus.end());
+    }
+    else
+    {
+      placeList.push_back(cpus);
+    }
+
+    prevSocket = socket;
+  }
+
+  return placeList;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Applies memory policy and binds threads
+//////////////////////////////////////////////////////////////////////////////
+void applyNumaOptions(const numaParams &params)
+{
+  //////////////////////////////////////////////////////////////
+  // Memory policy
+  //////////////////////////////////////////////////////////////
+  std::ifstream onlineFile("/sys/devices/system/node/online");
+  std::string online("0");
+  onlineFile >> online;
+
+  std::vector<int> nodes = parseIDList(online);
+
+  if(params.interleave)
+  {
+    std::vector<unsigned long> nodeMask(1,0);
+    unsigned long bitsPerWord = 8*sizeof(unsigned long);
+
+    for(unsigned int i=0; i<nodes.size(); i++)
+    {
+      if(nodes[i]/bitsPerWord >= nodeMask.size())
+      {
+        nodeMask.resize(nodes[i]/bitsPerWord+1,0);
+      }
+      nodeMask[nodes[i]/bitsPerWord] |= 1UL << (nodes[i]%bitsPerWord);
+    }
+
+    if(syscall(SYS_set_mempolicy, MINITRI_MPOL_INTERLEAVE, nodeMask.data(),
+               nodeMask.size()*bitsPerWord+1)!=0)
+    {
+      std::cerr << "Warning: could not set interleaved memory policy" << std::endl;
+    }
+  }
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Pin each thread of the pool to a place
+  //////////////////////////////////////////////////////////////
+  int numPlaces=0;
+
+  if(params.bind!="none")
+  {
+    std::vector<std::vector<int> > placeList = findPlaces(params.places);
+    numPlaces = placeList.size();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int thread=0;
+      int numThreads=1;
+#ifdef _OPENMP
+      thread = omp_get_thread_num();
+      numThreads = omp_get_num_threads();
+#endif
+
+      int place = (params.bind=="close") ? thread % numPlaces 
+                                         : (int) ((long) thread*numPlaces/numThreads);
+
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for(unsigned int c=0; c<placeList[place].size(); c++)
+      {
+        CPU_SET(placeList[place][c], &cpus);
+      }
+
+      // 0 -- calling thread
+      sched_setaffinity(0, sizeof(cpus), &cpus);
+    }
+  }
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Report settings only when a NUMA option was given
+  //////////////////////////////////////////////////////////////
+  if(params.interleave || params.bind!="none")
+  {
+    std::cout << "NUMA - nodes: " << nodes.size() 
+              << ", memory: " << (params.interleave ? "interleaved" : "first touch")
+              << ", bind: " << params.bind;
+    if(params.bind!="none")
+    {
+      std::cout << ", places: " << params.places << " (" << numPlaces << ")";
+    }
+    std::cout << std::endl;
+  }
+  //////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
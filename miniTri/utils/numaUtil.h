@@ -0,0 +1,94 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      numaUtil.h                                                    //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for memory placement and thread binding on      //
+//              NUMA nodes (Linux).                                         //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef NUMAUTIL_H
+#define NUMAUTIL_H
+
+#include <string>
+
+//////////////////////////////////////////////////////////////////////////////
+// NUMA settings, set from the command line by parseNumaOptions
+//    interleave -- interleave pages over all nodes instead of placing
+//                  them on the node of the thread that first touches them
+//    bind       -- none, close or spread: threads are pinned to places in
+//                  order (close) or evenly over the places (spread)
+//    places     -- threads, cores or sockets
+//////////////////////////////////////////////////////////////////////////////
+struct numaParams
+{
+  bool interleave;
+  std::string bind;
+  std::string places;
+
+  numaParams()
+    :interleave(false),bind("none"),places("cores")
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes "--bind {none || close || spread}",
+// "--places {threads || cores || sockets}" and "--interleave" from argv
+//////////////////////////////////////////////////////////////////////////////
+void parseNumaOptions(int &argc, char *argv[], numaParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Applies memory policy and pins the threads of the OpenMP thread pool.
+// Call after the number of threads is set and before data is allocated.
+//////////////////////////////////////////////////////////////////////////////
+void applyNumaOptions(const numaParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,760 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      sampleUtil.h                                                  //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for approximate triangle counting by sampling.  //
+//              The estimators are templated on the CSR matrix class and    //
+//              need getM(), getNNZInRow(row), getCol(row,nzIndx) of a      //
+//              symmetric adjacency matrix with sorted rows.                //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef SAMPLEUTIL_H
+#define SAMPLEUTIL_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// Sampling methods
+//    DOULION_METHOD  -- keep each edge with probability p, scale by 1/p^3
+//    COLORFUL_METHOD -- color vertices with N colors, keep monochromatic
+//                       edges, scale by N^2
+//    WEDGE_METHOD    -- sample wedges uniformly, scale closed fraction by
+//                       (number of wedges)/3
+//////////////////////////////////////////////////////////////////////////////
+enum approxmethod_t {EXACT_METHOD=0, DOULION_METHOD, COLORFUL_METHOD, WEDGE_METHOD};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Sampling parameters, set from the command line by parseApproxOptions
+//    param -- p (doulion), number of colors (colorful), number of
+//             samples (wedge); 0 selects the default (or, for wedge, the
+//             number of samples needed for error)
+//    error -- wedge: bound on error of closed wedge fraction (95%)
+//    reps  -- independent repetitions; doulion/colorful report the
+//             spread over repetitions, wedge pools the samples
+//////////////////////////////////////////////////////////////////////////////
+struct approxParams
+{
+  approxmethod_t method;
+  double param;
+  double error;
+  int reps;
+  uint64_t seed;
+
+  approxParams()
+    :method(EXACT_METHOD),param(0.0),error(0.01),reps(3),seed(1)
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Estimates.  The confidence interval of numTriangles is
+// numTriangles +/- 1.96*stdErr, that of kCounts[k] is
+// kCounts[k] +/- 1.96*kStdErr[k].
+//////////////////////////////////////////////////////////////////////////////
+struct approxResult
+{
+  double numTriangles;
+  double stdErr;
+  std::vector<double> vertexTris;   // triangle degree of each vertex
+  std::vector<double> kCounts;      // empty if no k-counts requested
+  std::vector<double> kStdErr;
+  int64_t sampleSize;               // kept edges or sampled wedges
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle found in a sample (vertex IDs of A)
+//////////////////////////////////////////////////////////////////////////////
+struct sampledTri_t
+{
+  int v[3];
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle degrees of vertices when scoring sampled triangles: exact if the
+// row merges cost at most KCOUNT_EXACT_WORK entries, else estimated from
+// KCOUNT_VERTEX_WEDGES wedges sampled at the vertex
+//////////////////////////////////////////////////////////////////////////////
+#define KCOUNT_EXACT_WORK    (1<<20)
+#define KCOUNT_VERTEX_WEDGES 4096
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses trailing options
+//    --approx {doulion || colorful || wedge}[:param]  --reps R
+//    --seed S  --error e
+// Returns the index of the first option (number of positional arguments).
+//////////////////////////////////////////////////////////////////////////////
+int parseApproxOptions(int argc, char *argv[], approxParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints usage of approximate counting options
+//////////////////////////////////////////////////////////////////////////////
+void printApproxUsage();
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints estimates (K-counts if kCounts is not empty)
+//////////////////////////////////////////////////////////////////////////////
+void printApproxResult(const approxParams &params, const approxResult &result);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Internal helpers used by the templates below
+//////////////////////////////////////////////////////////////////////////////
+double sampleUnit(uint64_t seed, uint64_t key);
+unsigned int approxK(double tvMin, int64_t teMin, unsigned int numKCounts);
+void meanStdErr(const std::vector<double> &vals, double &mean, double &stdErr);
+void combineApproxReps(const std::vector<double> &repTris, 
+                       const std::vector<std::vector<double> > &repKCounts,
+                       approxResult &result);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// True if b is in the sorted row a of A
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+bool isAdjacent(const MatT &A, int a, int b)
+{
+  int lo=0;
+  int hi=A.getNNZInRow(a);
+  while(lo<hi)
+  {
+    int mid = (lo+hi)/2;
+    if(A.getCol(a,mid)<b)
+    {
+      lo = mid+1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo<A.getNNZInRow(a) && A.getCol(a,lo)==b;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Exact triangle degree of edge (u,v) -- merge of the sorted rows u and v
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+int64_t edgeTriDegree(const MatT &A, int u, int v)
+{
+  int64_t numTris=0;
+  int nzU=0;
+  int nzV=0;
+
+  while(nzU<A.getNNZInRow(u) && nzV<A.getNNZInRow(v))
+  {
+    int colU = A.getCol(u,nzU);
+    int colV = A.getCol(v,nzV);
+
+    if(colU<colV)
+    {
+      nzU++;
+    }
+    else if(colV<colU)
+    {
+      nzV++;
+    }
+    else
+    {
+      if(colU!=u && colU!=v)
+      {
+        numTris++;
+      }
+      nzU++;
+      nzV++;
+    }
+  }
+
+  return numTris;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle degree of vertex v (closed wedges centered at v), exact if the
+// merges of row v with its neighbors' rows cost at most maxWork, else
+// estimated from numSamples wedges sampled at v
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+double vertexTriDegree(const MatT &A, int v, int64_t maxWork, int64_t numSamples,
+                       uint64_t seed)
+{
+  std::vector<int> nbrs;
+  nbrs.reserve(A.getNNZInRow(v));
+  int64_t work=0;
+  for(int nz=0; nz<A.getNNZInRow(v); nz++)
+  {
+    int w = A.getCol(v,nz);
+    if(w!=v)
+    {
+      nbrs.push_back(w);
+      work += A.getNNZInRow(v) + A.getNNZInRow(w);
+    }
+  }
+
+  int64_t d = nbrs.size();
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Exact -- each triangle at v is counted from both of its edges at v
+  ///////////////////////////////////////////////////////////////////////////
+  if(work<=maxWork)
+  {
+    int64_t twiceTris=0;
+    for(int64_t i=0; i<d; i++)
+    {
+      twiceTris += edgeTriDegree(A,v,nbrs[i]);
+    }
+    return twiceTris/2;
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Estimate -- closed fraction of sampled wedges
+  ///////////////////////////////////////////////////////////////////////////
+  int64_t numClosed = 0;
+  for(int64_t s=0; s<numSamples; s++)
+  {
+    uint64_t key = ((uint64_t)v*numSamples + s)*2;
+    int64_t i0 = std::min((int64_t) (sampleUnit(seed,key)*d), d-1);
+    int64_t i1 = std::min((int64_t) (sampleUnit(seed,key+1)*(d-1)), d-2);
+    if(i1>=i0)
+    {
+      i1++;
+    }
+    numClosed += isAdjacent(A,nbrs[i0],nbrs[i1]);
+  }
+
+  return (double)numClosed/numSamples*(0.5*d*(d-1.0));
+  ///////////////////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Histogram of the k of sampled triangles
+//
+// The k of a triangle uses the same rule as the exact k-counts, applied to
+// the exact triangle degrees of its edges and the triangle degrees of its
+// vertices (see vertexTriDegree).  Vertex degrees are cached in vTriDegree
+// (negative if not yet computed) and reused across repetitions.
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+void sampledKHistogram(const MatT &A, const std::vector<sampledTri_t> &tris,
+                       uint64_t seed, std::vector<double> &vTriDegree,
+                       std::vector<double> &kHist)
+{
+  ///////////////////////////////////////////////////////////////////////////
+  // Triangle degrees of vertices not scored before
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> newVerts;
+  for(unsigned int t=0; t<tris.size(); t++)
+  {
+    for(int i=0; i<3; i++)
+    {
+      int v = tris[t].v[i];
+      if(vTriDegree[v]==-1.0)
+      {
+        vTriDegree[v] = -2.0;
+        newVerts.push_back(v);
+      }
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+  for(int i=0; i<(int) newVerts.size(); i++)
+  {
+    vTriDegree[newVerts[i]] = vertexTriDegree(A, newVerts[i], KCOUNT_EXACT_WORK, 
+                                                KCOUNT_VERTEX_WEDGES, seed);
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // k of each sampled triangle
+  ///////////////////////////////////////////////////////////////////////////
+  kHist.assign(kHist.size(),0.0);
+  unsigned int numKCounts = kHist.size();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<double> localK(numKCounts,0.0);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,64)
+#endif
+    for(int64_t t=0; t<(int64_t) tris.size(); t++)
+    {
+      const int *v = tris[t].v;
+
+      double tvMin = std::min(std::min(vTriDegree[v[0]],vTriDegree[v[1]]),vTriDegree[v[2]]);
+      int64_t teMin = std::min(std::min(edgeTriDegree(A,v[0],v[1]),edgeTriDegree(A,v[0],v[2])),
+                               edgeTriDegree(A,v[1],v[2]));
+
+      localK[approxK(tvMin,teMin,numKCounts)] += 1.0;
+    }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      for(unsigned int k=0; k<numKCounts; k++)
+      {
+        kHist[k] += localK[k];
+      }
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangles of sparsified graph (one repetition of doulion/colorful)
+//
+// The kept edges are stored as a lower triangular CSR matrix S, whose
+// triangles i>k>j are found by marking S(i,:) and scanning S(k,:).  The
+// vertex triangle degrees of S, scaled to the whole graph, are
+// accumulated in vertexTris.  If keepTris is true, the triangles of S are
+// returned in tris.
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+double sparsifiedCount(const MatT &A, approxmethod_t method, double param,
+                       uint64_t seed, std::vector<double> &vertexTris,
+                       int64_t &sampleSize, bool keepTris,
+                       std::vector<sampledTri_t> &tris)
+{
+  int m = A.getM();
+
+  double p = (method==DOULION_METHOD) ? param : 1.0/param;
+  int numColors = (int) param;
+
+  // triangle survival probability
+  double triScale = (method==DOULION_METHOD) ? 1.0/(p*p*p) : 1.0/(p*p);
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Build S
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int64_t> rowStart(m+1,0);
+  std::vector<int> colors;
+
+  if(method==COLORFUL_METHOD)
+  {
+    colors.resize(m);
+    for(int v=0; v<m; v++)
+    {
+      colors[v] = (int) (sampleUnit(seed,v) * numColors);
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+  for(int row=0; row<m; row++)
+  {
+    for(int nz=0; nz<A.getNNZInRow(row); nz++)
+    {
+      int col = A.getCol(row,nz);
+      if(col<row && 
+         ((method==DOULION_METHOD && sampleUnit(seed,(uint64_t)row*m+col)<p) ||
+          (method==COLORFUL_METHOD && colors[row]==colors[col])))
+      {
+        rowStart[row+1]++;
+      }
+    }
+  }
+
+  for(int row=0; row<m; row++)
+  {
+    rowStart[row+1] += rowStart[row];
+  }
+
+  std::vector<int> cols(rowStart[m]);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+  for(int row=0; row<m; row++)
+  {
+    int64_t pos = rowStart[row];
+    for(int nz=0; nz<A.getNNZInRow(row); nz++)
+    {
+      int col = A.getCol(row,nz);
+      if(col<row && 
+         ((method==DOULION_METHOD && sampleUnit(seed,(uint64_t)row*m+col)<p) ||
+          (method==COLORFUL_METHOD && colors[row]==colors[col])))
+      {
+        cols[pos++] = col;
+      }
+    }
+  }
+  sampleSize = rowStart[m];
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Count triangles of S and vertex triangle degrees
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int64_t> vTris(m,0);
+  int64_t numTris=0;
+
+  tris.clear();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<int64_t> marker(m,0);
+    std::vector<sampledTri_t> localTris;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,64) reduction(+:numTris)
+#endif
+    for(int rowI=0; rowI<m; rowI++)
+    {
+      for(int64_t posI=rowStart[rowI]; posI<rowStart[rowI+1]; posI++)
+      {
+        marker[cols[posI]] = posI+1;
+      }
+
+      for(int64_t posI=rowStart[rowI]; posI<rowStart[rowI+1]; posI++)
+      {
+        int rowK = cols[posI];
+
+        for(int64_t posK=rowStart[rowK]; posK<rowStart[rowK+1]; posK++)
+        {
+          if(marker[cols[posK]]==0)
+          {
+            continue;
+          }
+
+          int colJ = cols[posK];
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          vTris[rowI]++;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          vTris[rowK]++;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          vTris[colJ]++;
+
+          numTris++;
+
+          if(keepTris)
+          {
+            sampledTri_t tri = {{rowI, rowK, colJ}};
+            localTris.push_back(tri);
+          }
+        }
+      }
+
+      for(int64_t posI=rowStart[rowI]; posI<rowStart[rowI+1]; posI++)
+      {
+        marker[cols[posI]] = 0;
+      }
+    }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      tris.insert(tris.end(),localTris.begin(),localTris.end());
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  for(int v=0; v<m; v++)
+  {
+    vertexTris[v] += triScale*vTris[v];
+  }
+
+  return triScale*numTris;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Wedge sampling
+//
+// Wedge centers are chosen with probability proportional to C(d,2) by a
+// search of the prefix sums, the two end points uniformly among distinct
+// neighbors.  A wedge is closed if its end points are adjacent.  Each
+// triangle has 3 wedges, so the closed wedges with k(t)=k estimate the
+// k-count like the closed wedges estimate the triangle count.
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+void wedgeSampleCount(const MatT &A, int64_t numSamples, uint64_t seed,
+                      unsigned int numKCounts, approxResult &result)
+{
+  int m = A.getM();
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Wedges centered at each vertex (self loops excluded)
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> degree(m,0);
+  std::vector<int> firstNZ(m,0);
+  std::vector<double> wedgeSum(m+1,0.0);
+
+  for(int row=0; row<m; row++)
+  {
+    int d = A.getNNZInRow(row);
+    for(int nz=0; nz<A.getNNZInRow(row); nz++)
+    {
+      if(A.getCol(row,nz)==row)
+      {
+        d--;
+      }
+    }
+    degree[row] = d;
+    wedgeSum[row+1] = wedgeSum[row] + 0.5*d*(d-1.0);
+  }
+
+  double numWedges = wedgeSum[m];
+  ///////////////////////////////////////////////////////////////////////////
+
+  std::vector<int64_t> closedAt(m,0);
+  int64_t numClosed=0;
+
+  std::vector<sampledTri_t> tris;
+
+  if(numWedges>0)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<sampledTri_t> localTris;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static) reduction(+:numClosed)
+#endif
+      for(int64_t s=0; s<numSamples; s++)
+      {
+        double r = sampleUnit(seed,3*s)*numWedges;
+        int center = std::upper_bound(wedgeSum.begin(),wedgeSum.end(),r) 
+                     - wedgeSum.begin() - 1;
+        center = std::min(std::max(center,0),m-1);
+
+        while(degree[center]<2)
+        {
+          center++;
+        }
+
+        // Pick two distinct neighbors (ranks among non-loop neighbors)
+        int d = degree[center];
+        int i0 = std::min((int) (sampleUnit(seed,3*s+1)*d), d-1);
+        int i1 = std::min((int) (sampleUnit(seed,3*s+2)*(d-1)), d-2);
+        if(i1>=i0)
+        {
+          i1++;
+        }
+
+        int v[2] = {-1,-1};
+        int rank=0;
+        for(int nz=0; nz<A.getNNZInRow(center) && (v[0]<0 || v[1]<0); nz++)
+        {
+          int col = A.getCol(center,nz);
+          if(col==center)
+          {
+            continue;
+          }
+          if(rank==i0)
+          {
+            v[0] = col;
+          }
+          if(rank==i1)
+          {
+            v[1] = col;
+          }
+          rank++;
+        }
+
+        if(isAdjacent(A,v[0],v[1]))
+        {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          closedAt[center]++;
+          numClosed++;
+
+          if(numKCounts>0)
+          {
+            sampledTri_t tri = {{center, v[0], v[1]}};
+            localTris.push_back(tri);
+          }
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      {
+        tris.insert(tris.end(),localTris.begin(),localTris.end());
+      }
+    }
+  }
+
+  double closedFrac = (numSamples>0) ? (double)numClosed/numSamples : 0.0;
+
+  result.numTriangles = closedFrac*numWedges/3.0;
+  result.stdErr = (numSamples>0) ? 
+    numWedges/3.0*sqrt(closedFrac*(1.0-closedFrac)/numSamples) : 0.0;
+  result.sampleSize = numSamples;
+
+  result.vertexTris.resize(m);
+  for(int v=0; v<m; v++)
+  {
+    result.vertexTris[v] = (numSamples>0) ? (double)closedAt[v]/numSamples*numWedges : 0.0;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // K-counts -- fraction of samples closed with each k
+  ///////////////////////////////////////////////////////////////////////////
+  result.kCounts.assign(numKCounts,0.0);
+  result.kStdErr.assign(numKCounts,0.0);
+
+  if(numKCounts>0 && numSamples>0)
+  {
+    std::vector<double> vTriDegree(m,-1.0);
+    std::vector<double> kHist(numKCounts,0.0);
+
+    sampledKHistogram(A, tris, seed, vTriDegree, kHist);
+
+    for(unsigned int k=0; k<numKCounts; k++)
+    {
+      double kFrac = kHist[k]/numSamples;
+      result.kCounts[k] = kFrac*numWedges/3.0;
+      result.kStdErr[k] = numWedges/3.0*sqrt(kFrac*(1.0-kFrac)/numSamples);
+    }
+  }
+  ///////////////////////////////////////////////////////////////////////////
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Approximate triangle count, triangle degrees and k-counts.  numKCounts
+// is the size of the k-count table (0 to skip).
+//
+// Each sampled triangle is weighted by the inverse of its sampling
+// probability and binned by its k (see sampledKHistogram).  The k is not
+// computed from the scaled degrees of the sample, which take only a few
+// distinct values.
+//////////////////////////////////////////////////////////////////////////////
+template <typename MatT>
+void approxTriangleCount(const MatT &A, const approxParams &params,
+                         unsigned int numKCounts, approxResult &result)
+{
+  int m = A.getM();
+
+  if(params.method==WEDGE_METHOD)
+  {
+    int64_t numSamples = (int64_t) params.param;
+    if(numSamples<=0)
+    {
+      numSamples = (int64_t) ceil(log(2.0/0.05)/(2.0*params.error*params.error));
+    }
+
+    wedgeSampleCount(A, numSamples*params.reps, params.seed, numKCounts, result);
+    return;
+  }
+
+  result.vertexTris.assign(m,0.0);
+  result.sampleSize = 0;
+
+  // scale of a sampled triangle
+  double triScale = (params.method==DOULION_METHOD) ? 
+    1.0/(params.param*params.param*params.param) : params.param*params.param;
+
+  std::vector<double> repTris(params.reps);
+  std::vector<std::vector<double> > repKCounts(params.reps);
+  std::vector<double> vTriDegree((numKCounts>0) ? m : 0, -1.0);
+  std::vector<sampledTri_t> tris;
+
+  for(int rep=0; rep<params.reps; rep++)
+  {
+    int64_t sampleSize;
+    repTris[rep] = sparsifiedCount(A, params.method, params.param, 
+                                   params.seed + 7919*(uint64_t)rep,
+                                   result.vertexTris, sampleSize,
+                                   numKCounts>0, tris);
+    result.sampleSize += sampleSize;
+
+    if(numKCounts>0)
+    {
+      repKCounts[rep].assign(numKCounts,0.0);
+      sampledKHistogram(A, tris, params.seed, vTriDegree, repKCounts[rep]);
+
+      for(unsigned int k=0; k<numKCounts; k++)
+      {
+        repKCounts[rep][k] *= triScale;
+      }
+    }
+  }
+
+  combineApproxReps(repTris, repKCounts, result);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,590 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      triSinkUtil.cc                                                //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for triangle listing sinks.                     //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+#include "triSinkUtil.h"
+
+namespace
+{
+  // Buffers are handed to the stream/file once they reach this size
+  const size_t SINK_BUFFER_SIZE = 1<<20;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Appends decimal representation of val to str
+  //////////////////////////////////////////////////////////////////////////
+  void appendUInt(std::string &str, unsigned int val)
+  {
+    char tmp[16];
+    int len=0;
+    do
+    {
+      tmp[len++] = '0' + (val%10);
+      val /= 10;
+    } while(val>0);
+
+    while(len>0)
+    {
+      str.push_back(tmp[--len]);
+    }
+  }
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Appends val as 32 bit little endian / as varint (7 bits per byte)
+  //////////////////////////////////////////////////////////////////////////
+  void appendU32(std::vector<unsigned char> &buf, unsigned int val)
+  {
+    buf.push_back(val & 0xff);
+    buf.push_back((val>>8) & 0xff);
+    buf.push_back((val>>16) & 0xff);
+    buf.push_back((val>>24) & 0xff);
+  }
+
+  void appendVarint(std::vector<unsigned char> &buf, unsigned int val)
+  {
+    while(val>=0x80)
+    {
+      buf.push_back((val & 0x7f) | 0x80);
+      val >>= 7;
+    }
+    buf.push_back(val);
+  }
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Buffered reader for readTriangleFile
+  //////////////////////////////////////////////////////////////////////////
+  class byteReader
+  {
+   public:
+    byteReader(FILE *fp) :mFP(fp),mBuf(SINK_BUFFER_SIZE),mPos(0),mEnd(0) {};
+
+    // Returns false at end of file
+    bool get(unsigned char &c)
+    {
+      if(mPos==mEnd)
+      {
+        mEnd = fread(&(mBuf[0]),1,mBuf.size(),mFP);
+        mPos = 0;
+        if(mEnd==0)
+        {
+          return false;
+        }
+      }
+      c = mBuf[mPos++];
+      return true;
+    }
+
+    bool getU32(unsigned int &val)
+    {
+      unsigned char c;
+      val = 0;
+      for(int i=0; i<4; i++)
+      {
+        if(!get(c))
+        {
+          return false;
+        }
+        val |= ((unsigned int) c) << (8*i);
+      }
+      return true;
+    }
+
+    bool getVarint(unsigned int &val)
+    {
+      unsigned char c;
+      val = 0;
+      for(int shift=0; shift<35; shift+=7)
+      {
+        if(!get(c))
+        {
+          return false;
+        }
+        val |= ((unsigned int) (c & 0x7f)) << shift;
+        if((c & 0x80)==0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+   private:
+    FILE *mFP;
+    std::vector<unsigned char> mBuf;
+    size_t mPos;
+    size_t mEnd;
+  };
+  //////////////////////////////////////////////////////////////////////////
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// textTriangleSink
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+textTriangleSink::textTriangleSink(std::ostream &os, bool printK)
+  :mOS(&os),mOwnedOS(0),mPrintK(printK),mBuffers()
+{
+}
+
+textTriangleSink::textTriangleSink(const std::string &fname, bool printK)
+  :mOS(0),mOwnedOS(0),mPrintK(printK),mBuffers()
+{
+  std::ofstream *ofs = new std::ofstream(fname.c_str());
+
+  if(!ofs->is_open())
+  {
+    std::cerr << "Unable to open triangle file " << fname << std::endl;
+    exit(1);
+  }
+  mOS = mOwnedOS = ofs;
+}
+
+textTriangleSink::~textTriangleSink()
+{
+  for(unsigned int i=0; i<mBuffers.size(); i++)
+  {
+    delete mBuffers[i];
+  }
+  delete mOwnedOS;
+}
+
+void textTriangleSink::open(int numThreads)
+{
+  mBuffers.resize(numThreads,0);
+  for(int i=0; i<numThreads; i++)
+  {
+    mBuffers[i] = new std::string();
+    mBuffers[i]->reserve(SINK_BUFFER_SIZE+64);
+  }
+}
+
+void textTriangleSink::write(int thread, const sinkTri_t &tri)
+{
+  std::string &buf = *(mBuffers[thread]);
+
+  buf.push_back('(');
+  appendUInt(buf,tri.v1);
+  buf.append(", ");
+  appendUInt(buf,tri.v2);
+  buf.append(", ");
+  appendUInt(buf,tri.v3);
+  buf.push_back(')');
+  if(mPrintK)
+  {
+    buf.push_back(' ');
+    appendUInt(buf,tri.k);
+  }
+  buf.push_back('\n');
+
+  if(buf.size()>=SINK_BUFFER_SIZE)
+  {
+    flush(thread);
+  }
+}
+
+void textTriangleSink::flush(int thread)
+{
+  std::string &buf = *(mBuffers[thread]);
+
+#ifdef _OPENMP
+  #pragma omp critical (textTriangleSink)
+#endif
+  {
+    mOS->write(buf.data(),buf.size());
+  }
+  buf.clear();
+}
+
+void textTriangleSink::close()
+{
+  for(unsigned int i=0; i<mBuffers.size(); i++)
+  {
+    flush(i);
+  }
+  mOS->flush();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// fileTriangleSink
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+fileTriangleSink::fileTriangleSink(const std::string &fname, bool compress, bool storeK)
+  :mFilename(fname),mCompress(compress),mStoreK(storeK),mFilenames(),mFiles()
+{
+}
+
+fileTriangleSink::~fileTriangleSink()
+{
+  for(unsigned int i=0; i<mFiles.size(); i++)
+  {
+    if(mFiles[i]->fp!=0)
+    {
+      fclose(mFiles[i]->fp);
+    }
+    delete mFiles[i];
+  }
+}
+
+void fileTriangleSink::open(int numThreads)
+{
+  mFiles.resize(numThreads,0);
+  mFilenames.resize(numThreads);
+
+  for(int i=0; i<numThreads; i++)
+  {
+    if(numThreads==1)
+    {
+      mFilenames[i] = mFilename;
+    }
+    else
+    {
+      std::ostringstream oss;
+      oss << mFilename << "." << i;
+      mFilenames[i] = oss.str();
+    }
+
+    threadFile *tf = new threadFile;
+    tf->fp = fopen(mFilenames[i].c_str(),"wb");
+    if(tf->fp==0)
+    {
+      std::cerr << "Unable to open triangle file " << mFilenames[i] << std::endl;
+      exit(1);
+    }
+    tf->prevV1 = 0;
+    tf->buf.reserve(SINK_BUFFER_SIZE+64);
+
+    const char *magic = mCompress ? "TRD3" : "TRI3";
+    tf->buf.insert(tf->buf.end(),magic,magic+4);
+    appendU32(tf->buf,mStoreK ? 1 : 0);
+
+    mFiles[i] = tf;
+  }
+}
+
+void fileTriangleSink::write(int thread, const sinkTri_t &tri)
+{
+  threadFile &tf = *(mFiles[thread]);
+
+  if(mCompress)
+  {
+    appendVarint(tf.buf,tri.v1-tf.prevV1);
+    appendVarint(tf.buf,tri.v1-tri.v2);
+    appendVarint(tf.buf,tri.v1-tri.v3);
+    if(mStoreK)
+    {
+      appendVarint(tf.buf,tri.k);
+    }
+    tf.prevV1 = tri.v1;
+  }
+  else
+  {
+    appendU32(tf.buf,tri.v1);
+    appendU32(tf.buf,tri.v2);
+    appendU32(tf.buf,tri.v3);
+    if(mStoreK)
+    {
+      appendU32(tf.buf,tri.k);
+    }
+  }
+
+  if(tf.buf.size()>=SINK_BUFFER_SIZE)
+  {
+    flush(thread);
+  }
+}
+
+void fileTriangleSink::flush(int thread)
+{
+  threadFile &tf = *(mFiles[thread]);
+
+  if(tf.buf.size()>0 && fwrite(&(tf.buf[0]),1,tf.buf.size(),tf.fp)!=tf.buf.size())
+  {
+    std::cerr << "Error writing triangle file " << mFilenames[thread] << std::endl;
+    exit(1);
+  }
+  tf.buf.clear();
+}
+
+void fileTriangleSink::close()
+{
+  for(unsigned int i=0; i<mFiles.size(); i++)
+  {
+    flush(i);
+    fclose(mFiles[i]->fp);
+    mFiles[i]->fp = 0;
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// callbackTriangleSink
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+callbackTriangleSink::callbackTriangleSink(const triangleCallback &callback, int batchSize)
+  :mCallback(callback),mBatchSize(batchSize),mBatches()
+{
+}
+
+callbackTriangleSink::~callbackTriangleSink()
+{
+  for(unsigned int i=0; i<mBatches.size(); i++)
+  {
+    delete mBatches[i];
+  }
+}
+
+void callbackTriangleSink::open(int numThreads)
+{
+  mBatches.resize(numThreads,0);
+  for(int i=0; i<numThreads; i++)
+  {
+    mBatches[i] = new std::vector<sinkTri_t>();
+    mBatches[i]->reserve(mBatchSize);
+  }
+}
+
+void callbackTriangleSink::write(int thread, const sinkTri_t &tri)
+{
+  std::vector<sinkTri_t> &batch = *(mBatches[thread]);
+
+  batch.push_back(tri);
+
+  if((int) batch.size()>=mBatchSize)
+  {
+    flush(thread);
+  }
+}
+
+void callbackTriangleSink::flush(int thread)
+{
+  std::vector<sinkTri_t> &batch = *(mBatches[thread]);
+
+  if(batch.size()>0)
+  {
+    mCallback(thread,&(batch[0]),batch.size());
+  }
+  batch.clear();
+}
+
+void callbackTriangleSink::close()
+{
+  for(unsigned int i=0; i<mBatches.size(); i++)
+  {
+    flush(i);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes export options
+//////////////////////////////////////////////////////////////////////////////
+void parseExportOptions(int &argc, char *argv[], exportParams &params)
+{
+  int newArgc=0;
+
+  for(int i=0; i<argc; i++)
+  {
+    std::string arg(argv[i]);
+
+    if(arg=="--export" || arg=="--export-format" || arg=="--kmin")
+    {
+      if(i+1>=argc)
+      {
+        std::cerr << "Missing value for " << arg << std::endl;
+        exit(1);
+      }
+
+      std::string val(argv[++i]);
+
+      if(arg=="--export")
+      {
+        params.file = val;
+      }
+      else if(arg=="--export-format" && (val=="text" || val=="bin" || val=="delta"))
+      {
+        params.format = val;
+      }
+      else if(arg=="--kmin" && atoi(val.c_str())>=0)
+      {
+        params.kMin = atoi(val.c_str());
+      }
+      else
+      {
+        std::cerr << "Invalid value for " << arg << ": " << val << std::endl;
+        exit(1);
+      }
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+
+  argc = newArgc;
+  argv[argc] = 0;
+
+  if(params.file=="-" && params.format!="text")
+  {
+    std::cerr << "Only text format can be exported to stdout" << std::endl;
+    exit(1);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Creates sink for export options
+//////////////////////////////////////////////////////////////////////////////
+triangleSink *createTriangleSink(const exportParams &params)
+{
+  if(params.format=="text")
+  {
+    if(params.file=="-")
+    {
+      return new textTriangleSink(std::cout,true);
+    }
+    return new textTriangleSink(params.file,true);
+  }
+
+  return new fileTriangleSink(params.file,params.format=="delta",true);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads binary triangle file
+//////////////////////////////////////////////////////////////////////////////
+long long readTriangleFile(const std::string &fname, triangleSink &sink)
+{
+  FILE *fp = fopen(fname.c_str(),"rb");
+  if(fp==0)
+  {
+    std::cerr << "Unable to open triangle file " << fname << std::endl;
+    exit(1);
+  }
+
+  byteReader reader(fp);
+
+  char magic[4];
+  unsigned int hasK=0;
+  for(int i=0; i<4; i++)
+  {
+    unsigned char c=0;
+    reader.get(c);
+    magic[i] = c;
+  }
+
+  bool compressed = (strncmp(magic,"TRD3",4)==0);
+  if((!compressed && strncmp(magic,"TRI3",4)!=0) || !reader.getU32(hasK))
+  {
+    std::cerr << "Invalid triangle file " << fname << std::endl;
+    exit(1);
+  }
+
+  sink.open(1);
+
+  long long numTris=0;
+  unsigned int prevV1=0;
+  while(true)
+  {
+    sinkTri_t tri;
+    tri.k = 0;
+
+    bool ok;
+    if(compressed)
+    {
+      unsigned int d1=0,d2=0,d3=0;
+      ok = reader.getVarint(d1);
+      if(!ok)
+      {
+        break;
+      }
+      ok = reader.getVarint(d2) && reader.getVarint(d3) && (hasK==0 || reader.getVarint(tri.k));
+      tri.v1 = prevV1 + d1;
+      tri.v2 = tri.v1 - d2;
+      tri.v3 = tri.v1 - d3;
+      prevV1 = tri.v1;
+    }
+    else
+    {
+      ok = reader.getU32(tri.v1);
+      if(!ok)
+      {
+        break;
+      }
+      ok = reader.getU32(tri.v2) && reader.getU32(tri.v3) && (hasK==0 || reader.getU32(tri.k));
+    }
+
+    if(!ok)
+    {
+      std::cerr << "Truncated triangle file " << fname << std::endl;
+      exit(1);
+    }
+
+    sink.write(0,tri);
+    numTris++;
+  }
+
+  sink.close();
+  fclose(fp);
+
+  return numTris;
+}
+//////////////////////////////////////////////////////////////////////////////
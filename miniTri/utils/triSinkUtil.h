@@ -0,0 +1,226 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      triSinkUtil.h                                                 //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for triangle listing sinks (text, binary,       //
+//              delta compressed binary and callback).                      //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef TRISINKUTIL_H
+#define TRISINKUTIL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include <cstdio>
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle passed to a sink
+//    -- vertices are 1-based (as in the matrix file), v1 > v2, v3
+//    -- k is the k-count bound of the triangle (0 if not computed)
+//////////////////////////////////////////////////////////////////////////////
+struct sinkTri_t
+{
+  unsigned int v1;
+  unsigned int v2;
+  unsigned int v3;
+  unsigned int k;
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle sink
+//    -- open is called once with the number of threads that will write
+//    -- write may be called concurrently, but each thread id is only used
+//       by one thread at a time; triangles of a thread are written in the
+//       order they are found
+//    -- close flushes everything that is buffered
+//////////////////////////////////////////////////////////////////////////////
+class triangleSink
+{
+ public:
+  virtual ~triangleSink() {};
+
+  virtual void open(int numThreads) = 0;
+  virtual void write(int thread, const sinkTri_t &tri) = 0;
+  virtual void close() = 0;
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Text sink -- "(v1, v2, v3)" or "(v1, v2, v3) k" per line.  Lines are
+// buffered per thread and appended to the stream in blocks, so triangles
+// of different threads are interleaved by block.
+//////////////////////////////////////////////////////////////////////////////
+class textTriangleSink : public triangleSink
+{
+ public:
+  textTriangleSink(std::ostream &os, bool printK=false);
+  textTriangleSink(const std::string &fname, bool printK=false);
+  ~textTriangleSink();
+
+  void open(int numThreads);
+  void write(int thread, const sinkTri_t &tri);
+  void close();
+
+ private:
+  void flush(int thread);
+
+  std::ostream *mOS;
+  std::ostream *mOwnedOS;
+  bool mPrintK;
+  std::vector<std::string *> mBuffers;
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Binary file sink -- each thread writes its own file (fname if one thread,
+// fname.0, fname.1, ... otherwise) through a private buffer.
+//    Header:   "TRI3" (fixed records) or "TRD3" (delta compressed),
+//              followed by a 32 bit flag that is 1 if k is stored
+//    Fixed:    v1 v2 v3 [k] as 32 bit unsigned integers
+//    Delta:    varint(v1 - previous v1), varint(v1 - v2), varint(v1 - v3)
+//              [, varint(k)] -- v1 is nondecreasing within a thread
+//////////////////////////////////////////////////////////////////////////////
+class fileTriangleSink : public triangleSink
+{
+ public:
+  fileTriangleSink(const std::string &fname, bool compress, bool storeK);
+  ~fileTriangleSink();
+
+  void open(int numThreads);
+  void write(int thread, const sinkTri_t &tri);
+  void close();
+
+  const std::vector<std::string> & getFilenames() const {return mFilenames;};
+
+ private:
+  struct threadFile
+  {
+    FILE *fp;
+    unsigned int prevV1;
+    std::vector<unsigned char> buf;
+  };
+
+  void flush(int thread);
+
+  std::string mFilename;
+  bool mCompress;
+  bool mStoreK;
+  std::vector<std::string> mFilenames;
+  std::vector<threadFile *> mFiles;
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Callback sink -- triangles are buffered per thread and handed to the
+// callback in batches, from the thread that found them.  The callback
+// must be safe to call concurrently for different threads.
+//////////////////////////////////////////////////////////////////////////////
+typedef std::function<void(int thread, const sinkTri_t *tris, int numTris)> triangleCallback;
+
+class callbackTriangleSink : public triangleSink
+{
+ public:
+  callbackTriangleSink(const triangleCallback &callback, int batchSize=4096);
+  ~callbackTriangleSink();
+
+  void open(int numThreads);
+  void write(int thread, const sinkTri_t &tri);
+  void close();
+
+ private:
+  void flush(int thread);
+
+  triangleCallback mCallback;
+  int mBatchSize;
+  std::vector<std::vector<sinkTri_t> *> mBatches;
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Export settings, set from the command line by parseExportOptions
+//    file   -- output file, empty for no export ("-" for stdout, text only)
+//    format -- text, bin or delta
+//    kMin   -- only triangles with k-count bound >= kMin are exported
+//////////////////////////////////////////////////////////////////////////////
+struct exportParams
+{
+  std::string file;
+  std::string format;
+  unsigned int kMin;
+
+  exportParams()
+    :file(),format("bin"),kMin(0)
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes "--export file", "--export-format {text || bin ||
+// delta}" and "--kmin k" from argv
+//////////////////////////////////////////////////////////////////////////////
+void parseExportOptions(int &argc, char *argv[], exportParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Creates the sink described by params (caller deletes it)
+//////////////////////////////////////////////////////////////////////////////
+triangleSink *createTriangleSink(const exportParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads a binary triangle file (either format) and writes its triangles
+// to sink as thread 0.  Returns the number of triangles read.
+//////////////////////////////////////////////////////////////////////////////
+long long readTriangleFile(const std::string &fname, triangleSink &sink);
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,133 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      updateUtil.cc                                                 //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for edge update (insertion/deletion) files.     //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "updateUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void readEdgeUpdates(const char *fname, int numVerts,
+                     std::vector<std::vector<edgeUpdate_t> > &batches)
+{
+  std::ifstream ifs(fname);
+
+  if(!ifs)
+  {
+    std::cerr << "Cannot open filename " << fname << std::endl;
+    exit(1);
+  }
+
+  batches.clear();
+
+  std::vector<edgeUpdate_t> batch;
+  std::string line;
+  int lineNum=0;
+
+  while(std::getline(ifs,line))
+  {
+    lineNum++;
+
+    std::istringstream iss(line);
+    std::string op;
+
+    if(!(iss >> op) || op[0]=='%')
+    {
+      continue;
+    }
+
+    if(op=="=")
+    {
+      if(batch.size()>0)
+      {
+        batches.push_back(batch);
+        batch.clear();
+      }
+      continue;
+    }
+
+    edgeUpdate_t update;
+    long v0, v1;
+
+    if((op!="+" && op!="-") || !(iss >> v0 >> v1))
+    {
+      std::cerr << "Invalid edge update on line " << lineNum << " of " 
+                << fname << std::endl;
+      exit(1);
+    }
+
+    if(v0<1 || v0>numVerts || v1<1 || v1>numVerts)
+    {
+      std::cerr << "Vertex out of range on line " << lineNum << " of " 
+                << fname << std::endl;
+      exit(1);
+    }
+
+    update.v0 = v0-1;
+    update.v1 = v1-1;
+    update.insert = (op=="+");
+
+    batch.push_back(update);
+  }
+
+  if(batch.size()>0)
+  {
+    batches.push_back(batch);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
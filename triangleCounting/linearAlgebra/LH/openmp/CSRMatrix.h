@@ -60,6 +60,8 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI,INCIDENCE} matrixtype;
 #include <map>
 #include <vector>
 
+#include "miniTriDefs.h"
+
 
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
@@ -71,7 +73,7 @@ class CSRMat
   matrixtype type;
   int m;   //number of rows
   int n;   //number of cols
-  int nnz; //number of nonzeros
+  count_t nnz; //number of nonzeros
 
   std::vector<int> nnzInRow;                             // nnz in each row
   std::vector<std::vector<int> > cols;           //columns of nonzeros
@@ -138,7 +140,7 @@ class CSRMat
   int getN() const { return n;};
 
   // returns the number of cols
-  int getNNZ() const { return nnz;};
+  count_t getNNZ() const { return nnz;};
 
   // returns NNZ in row rnum
   inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
@@ -172,4 +174,65 @@ class CSRMat
 };
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Implicit incidence matrix H
+//    -- Column e of H is edge e, numbered by the nonzero index of the edge
+//       in the upper triangle U of the adjacency matrix, so no edge index
+//       map is needed.  Only U's structure is stored: row k's edge IDs are
+//       edgeOffsets[k] .. edgeOffsets[k+1]-1 and edgeEnds[e] is the higher
+//       endpoint of edge e.  Row k of H also holds the edges (w,k), w<k,
+//       which are the upper edges of row w.
+//////////////////////////////////////////////////////////////////////////////
+class ImplicitIncMat
+{
+
+ private:
+  int m;   //number of rows (vertices)
+  int n;   //number of cols (edges)
+
+  std::vector<int> edgeOffsets;  // first edge ID of each row of U
+  std::vector<int> edgeEnds;     // higher endpoint of each edge
+
+  int mBlockSize;
+
+ public:
+  //////////////////////////////////////////////////////////////////////////
+  // default constructor -- builds empty matrix
+  //////////////////////////////////////////////////////////////////////////
+  ImplicitIncMat()
+    :m(0),n(0),edgeOffsets(),edgeEnds(),mBlockSize(1)
+  {
+  };
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Constructor that accepts block size for row scheduling
+  //////////////////////////////////////////////////////////////////////////
+  ImplicitIncMat(int blocksize)
+    :m(0),n(0),edgeOffsets(),edgeEnds(),mBlockSize(blocksize)
+  {
+  };
+  //////////////////////////////////////////////////////////////////////////
+
+  // returns the number of rows
+  int getM() const { return m;};
+
+  // returns the number of cols (edges)
+  int getN() const { return n;};
+
+  //////////////////////////////////////////////////////////////////
+  // Builds edge numbering from adjacency matrix
+  //////////////////////////////////////////////////////////////////
+  void create(const CSRMat &matSrc);
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Count-only L*H -- returns number of entries of L*H equal to 2
+  //////////////////////////////////////////////////////////////////
+  count_t countTwosInProduct(const CSRMat &L) const;
+  //////////////////////////////////////////////////////////////////
+
+};
+//////////////////////////////////////////////////////////////////////////////
+
 #endif
@@ -79,67 +79,48 @@ void Graph::countTriangles()
             << "**********" << std::endl;
 
   ///////////////////////////////////////////////////////////////////////
-  // Form B
+  // Form implicit incidence matrix H
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
-  std::cout << "Creating incidence matrix B...";
+  std::cout << "Creating implicit incidence matrix H...";
 
   gettimeofday(&t1, NULL);
 
-  CSRMat B(INCIDENCE,mBlockSize);
-  B.createIncidenceMatrix(mMatrix,mEdgeIndices);
+  ImplicitIncMat H(mBlockSize);
+  H.create(mMatrix);
 
   gettimeofday(&t2, NULL);
 
   std::cout << " done" <<std::endl;
 
-  //mMatrix.print();
-  //B.print();
-
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to create B: " << eTime << std::endl;
+  std::cout << "TIME - Time to create H: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////
-  // Create lower triangle matrix                                        
+  // Create lower triangle matrix
   ///////////////////////////////////////////////////////////////////////
-  // Should eventually move this to constructor, build incidence from this
   CSRMat L(LOWERTRI);
   L.createTriMatrix(mMatrix, LOWERTRI);
   ///////////////////////////////////////////////////////////////////////
 
   ///////////////////////////////////////////////////////////////////////
-  // C = L*B
+  // Count entries of C = L*H equal to 2, C not formed
   ///////////////////////////////////////////////////////////////////////
   std::cout << "--------------------" << std::endl;
-
-
-  std::shared_ptr<CSRMat> C(new CSRMat(mMatrix.getM(),B.getN(),mBlockSize));
-
-  std::cout << "C = L*B: " << std::endl;
+  std::cout << "C = L*H (count only): " << std::endl;
 
   gettimeofday(&t1, NULL);
-  C->matmat(L,B);
+  mNumTriangles = H.countTwosInProduct(L);
   gettimeofday(&t2, NULL);
 
-  //C.print();
-
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
-  std::cout << "TIME - Time to compute C = L*B: " << eTime << std::endl;
+  mKernelTime = eTime;
+  std::cout << "TIME - Time to compute C = L*H: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
-
-  std::cout << "C NNZ: " << C->getNNZ() << std::endl;
-
-  mNumTriangles = C->getNNZ();
-  ///////////////////////////////////////////////////////////////////////
-
-  ///////////////////////////////////////////////////////////////////////
-  // Save triangle information                                           
-  ///////////////////////////////////////////////////////////////////////
-  mTriMat = C;
   ///////////////////////////////////////////////////////////////////////
 
   std::cout << "************************************************************"
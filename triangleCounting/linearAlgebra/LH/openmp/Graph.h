@@ -57,7 +57,6 @@
 #include <vector>
 #include <map>
 #include <cmath>
-#include <memory>
 
 #include "CSRMatrix.h"
 
@@ -73,16 +72,14 @@ class Graph
   std::string mFilename;
 
   int mNumVerts;
-  int mNumEdges;
+  count_t mNumEdges;
   CSRMat mMatrix;
 
 
-  std::shared_ptr<CSRMat> mTriMat;
- 
-  std::map<int,std::map<int,int> > mEdgeIndices;
+  count_t mNumTriangles;
 
-
-  int mNumTriangles;
+  // Time of the multiply/reduce phase of the last countTriangles()
+  double mKernelTime;
 
   int mBlockSize;
 
@@ -91,7 +88,7 @@ class Graph
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mNumTriangles(0),mBlockSize(1)
+    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0),mBlockSize(1)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -100,7 +97,7 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
  Graph(std::string _fname, bool binFile, int blocksize=1) 
-    :mFilename(_fname),mMatrix(), mNumTriangles(0), mBlockSize(blocksize)
+    :mFilename(_fname),mMatrix(), mNumTriangles(0),mKernelTime(0.0), mBlockSize(blocksize)
   {
     if(binFile==false)
     {
@@ -132,7 +129,14 @@ class Graph
   void countTriangles();
   //////////////////////////////////////////////////////////////////////////
 
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Time of the last count, excluding building L/H and support output
+  //////////////////////////////////////////////////////////////////////////
+  double getKernelTime() const {return mKernelTime;};
+  //////////////////////////////////////////////////////////////////////////
+  count_t getNumEdges() const {return mNumEdges;};
 
 };
 //////////////////////////////////////////////////////////////////////////////
@@ -53,11 +53,13 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <vector>
 
 #include <omp.h>
 
 #include <sys/time.h>
 
+#include "trialUtil.h"
 #include "Graph.h"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -65,12 +67,17 @@
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  struct timeval t1, t2;
+  // --trials N --warmup W are removed from argv
+  trialParams trials;
+  parseTrialOptions(argc, argv, trials);
+
+  struct timeval t1, t2 = {0, 0};
 
  
   if(argc!=4 && argc!=5)
   {
-    std::cerr << "Usage: miniTri.exe matrixFile blockSize numThreads [fileformat ={MM || Bin}]" << std::endl;
+    std::cerr << "Usage: miniTri.exe matrixFile blockSize numThreads [fileformat ={MM || Bin}]"
+              << " [--trials N --warmup W]" << std::endl;
     exit(1);
   }
 
@@ -105,10 +112,32 @@ int main(int argc, char *argv[])
 
   Graph g(mat,isBinFile,blockSize);
 
-  g.countTriangles();
+  ////////////////////////////////////////////////////////////////////////
+  // Count triangles warmup+trials times on the resident graph, timing
+  // only the multiply/reduce kernel (building L/H and support output are
+  // excluded)
+  ////////////////////////////////////////////////////////////////////////
+  std::vector<double> times;
+
+  for(int run=0; run<trials.warmup+trials.trials; run++)
+  {
+    silenceOutput(run>0);
+
+    g.countTriangles();
 
+    // Time of the first run, as reported without trials
+    if(run==0)
+    {
+      gettimeofday(&t2, NULL);
+    }
 
-  gettimeofday(&t2, NULL);
+    if(run>=trials.warmup)
+    {
+      times.push_back(g.getKernelTime());
+    }
+  }
+  silenceOutput(false);
+  ////////////////////////////////////////////////////////////////////////
 
 
 
@@ -118,6 +147,11 @@ int main(int argc, char *argv[])
 
   std::cout << "TIME - Time to count the number of triangles: " << eTime << std::endl;
 
+  if(trials.enabled)
+  {
+    printTrialStats("LH-openmp", trials, times, g.getNumEdges());
+  }
+
 
   //MMW need to unpermute matrix
 
@@ -110,7 +110,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   ///////////////////////////////////////////////////////////////////////////
   nnz =0;
 
-  int tmpNNZ =0;
+  count_t tmpNNZ =0;
 
   for (int rownum=0; rownum<m; rownum++)
   {
@@ -202,7 +202,7 @@ void CSRMat::readMMMatrix(const char *fname)
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
@@ -222,7 +222,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -318,7 +318,7 @@ void CSRMat::readBinMatrix(const char *fname)
   int base=0;
   int tmpval=1;
 
-  for (int i=0; i<numEdges; i++)
+  for (int64_t i=0; i<numEdges; i++)
   {
     if(type==UNDEFINED)
     {
@@ -525,6 +525,110 @@ void CSRMat::createIncidenceMatrix(const CSRMat &matSrc, std::map<int,std::map<i
 }
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// create -- numbers the edges (k,w), k<w, in row major order of the upper
+//           triangle of the adjacency matrix
+////////////////////////////////////////////////////////////////////////////////
+void ImplicitIncMat::create(const CSRMat &matSrc)
+{
+  m = matSrc.getM();
+
+  //////////////////////////////////////////////////////////////
+  // Count upper triangle nonzeros in each row, prefix sum
+  //////////////////////////////////////////////////////////////
+  edgeOffsets.assign(m+1,0);
+
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    int nnzInRowSrc = matSrc.getNNZInRow(rownum);
+    int numUpper=0;
+
+    for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    {
+      if(rownum < matSrc.getCol(rownum, nzindxSrc))
+      {
+        numUpper++;
+      }
+    }
+    edgeOffsets[rownum+1] = numUpper;
+  }
+
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    edgeOffsets[rownum+1] += edgeOffsets[rownum];
+  }
+  n = edgeOffsets[m];
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Store higher endpoint of each edge
+  //////////////////////////////////////////////////////////////
+  edgeEnds.resize(n);
+
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    int nnzInRowSrc = matSrc.getNNZInRow(rownum);
+    int eID = edgeOffsets[rownum];
+
+    for(int nzindxSrc=0; nzindxSrc<nnzInRowSrc; nzindxSrc++)
+    {
+      int colnum = matSrc.getCol(rownum, nzindxSrc);
+
+      if(rownum < colnum)
+      {
+        edgeEnds[eID++] = colnum;
+      }
+    }
+  }
+  //////////////////////////////////////////////////////////////
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// countTwosInProduct -- count-only C = L*H
+//
+// C(i,e) for edge e=(k,w) is the number of endpoints of e in row i of L, so
+// C(i,e)==2 iff both k and w are in L(i,:).  Each such entry is counted once,
+// from its lower endpoint k, by marking the columns of L(i,:) and scanning
+// the upper edges of each k in L(i,:).  C is never formed.
+////////////////////////////////////////////////////////////////////////////////
+count_t ImplicitIncMat::countTwosInProduct(const CSRMat &L) const
+{
+  assert(L.getM() == m);
+
+  count_t numTwos=0;
+
+  // rowMarker[v] == rownum iff L(rownum,v) is nonzero
+  std::vector<int> rowMarker(m,-1);
+
+  for (int rownum=0; rownum<m; rownum++)
+  {
+    int nnzInRowL = L.getNNZInRow(rownum);
+
+    for(int nzindxL=0; nzindxL<nnzInRowL; nzindxL++)
+    {
+      rowMarker[L.getCol(rownum, nzindxL)] = rownum;
+    }
+
+    for(int nzindxL=0; nzindxL<nnzInRowL; nzindxL++)
+    {
+      int colL = L.getCol(rownum, nzindxL);
+
+      for(int eID=edgeOffsets[colL]; eID<edgeOffsets[colL+1]; eID++)
+      {
+        if(rowMarker[edgeEnds[eID]]==rownum)
+        {
+          numTwos++;
+        }
+      }
+    }
+  }
+
+  return numTwos;
+}
+////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // addNZ -- For a given row, add a column for a nonzero into a sorted list
 //////////////////////////////////////////////////////////////////////////////
@@ -57,7 +57,6 @@
 #include <vector>
 #include <map>
 #include <cmath>
-#include <memory>
 
 #include "CSRmatrix.hpp"
 
@@ -71,21 +70,20 @@ class Graph
   std::string mFilename;
 
   int mNumVerts;
-  int mNumEdges;
+  count_t mNumEdges;
   CSRMat mMatrix;
 
-  int mNumTriangles;
-  std::shared_ptr<CSRMat> mTriMat;
-
-  std::map<int,std::map<int,int> > mEdgeIndices;
+  count_t mNumTriangles;
 
+  // Time of the multiply/reduce phase of the last countTriangles()
+  double mKernelTime;
 
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mNumTriangles(0), mTriMat()
+    :mFilename("UNDEFINED"),mNumVerts(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -94,7 +92,7 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string _fname,bool binFile=false) 
-   :mFilename(_fname),mMatrix(), mNumTriangles(0), mTriMat()
+   :mFilename(_fname),mMatrix(), mNumTriangles(0),mKernelTime(0.0)
   {
     if(binFile==false)
     {
@@ -125,7 +123,14 @@ class Graph
   void countTriangles();
   //////////////////////////////////////////////////////////////////////////
 
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Time of the last count, excluding building L/H and support output
+  //////////////////////////////////////////////////////////////////////////
+  double getKernelTime() const {return mKernelTime;};
+  //////////////////////////////////////////////////////////////////////////
+  count_t getNumEdges() const {return mNumEdges;};
 
 };
 //////////////////////////////////////////////////////////////////////////////
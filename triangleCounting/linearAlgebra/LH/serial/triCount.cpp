@@ -53,16 +53,24 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <vector>
+#include <sys/time.h>
 
+#include "trialUtil.h"
 #include "Graph.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
+  // --trials N --warmup W are removed from argv
+  trialParams trials;
+  parseTrialOptions(argc, argv, trials);
+
   if(argc!=2 && argc!=3)
   {
-    std::cerr << "Usage: triCount matrixFile [fileformat ={MM || Bin}]" << std::endl;
+    std::cerr << "Usage: triCount matrixFile [fileformat ={MM || Bin}]"
+              << " [--trials N --warmup W]" << std::endl;
     exit(1);
   }
 
@@ -89,9 +97,33 @@ int main(int argc, char *argv[])
 
 
   Graph g(mat,isBinFile);
-  g.countTriangles();
+  ////////////////////////////////////////////////////////////////////////
+  // Count triangles warmup+trials times on the resident graph, timing
+  // only the multiply/reduce kernel (building L/H and support output are
+  // excluded)
+  ////////////////////////////////////////////////////////////////////////
+  std::vector<double> times;
+
+  for(int run=0; run<trials.warmup+trials.trials; run++)
+  {
+    silenceOutput(run>0);
+
+    g.countTriangles();
+
+    if(run>=trials.warmup)
+    {
+      times.push_back(g.getKernelTime());
+    }
+  }
+  silenceOutput(false);
+  ////////////////////////////////////////////////////////////////////////
   std::cout << "Number of Triangles: " << g.getNumTriangles() << std::endl;
 
+  if(trials.enabled)
+  {
+    printTrialStats("LH-serial", trials, times, g.getNumEdges());
+  }
+
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -52,6 +52,7 @@
 #include <fstream>
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cassert>
 #include <cstdlib>
 #include <sys/time.h>
@@ -66,15 +67,124 @@ extern "C"{
 #include "Graph.h"
 #include "mmUtil.h"
 #include "mmio.h"
+#include "kkGraphReader.h"
 
 #include <impl/Kokkos_Timer.hpp>
 
 #include "KokkosGraph_Triangle.hpp"
 
+//////////////////////////////////////////////////////////////////////////////
+// Names of formulations, as given on the command line
+//////////////////////////////////////////////////////////////////////////////
+const char *GB_MODE_NAMES[] = {"plustimes", "pluspair", "sandiadot"};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses formulation name
+//////////////////////////////////////////////////////////////////////////////
+gbmode_t parseGBMode(const char *name)
+{
+  std::string modeName(name);
+
+  if(modeName=="all")
+  {
+    return GB_ALL_MODES;
+  }
+
+  for(int mode=0; mode<GB_ALL_MODES; mode++)
+  {
+    if(modeName==GB_MODE_NAMES[mode])
+    {
+      return (gbmode_t) mode;
+    }
+  }
+
+  std::cerr << "Formulation must be plustimes, pluspair, sandiadot or all" << std::endl;
+  exit(1);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Sums the entries of C = L*L mask L, returns time
+//
+//    GB_PLUS_TIMES -- C<L> = L*L with the plus-times semiring
+//    GB_PLUS_PAIR  -- C<s(L)> = L*L with the plus-pair semiring, whose
+//                     multiply is 1 for every pair of entries (structure
+//                     only), and a structural mask
+//    GB_SANDIA_DOT -- C<s(L)> = L*U' with U = L', so that each entry of
+//                     the mask is computed as a dot product of two sorted
+//                     rows (L(i,:) and U(j,:)), and C has the pattern of L
+//
+// The sum of C is reduced directly to a scalar.  The Graph BLAS API has
+// no masked product that is reduced on the fly, so C is formed, but
+// with the structural mask it is never larger than L.
+//////////////////////////////////////////////////////////////////////////////
+static double maskedProductCount(GrB_Matrix gbL, ordinal_t m, gbmode_t mode,
+                                 int64_t &numTriangles)
+{
+  Kokkos::Impl::Timer timer1;
+
+  GrB_Matrix gbC = NULL;
+  GrB_Matrix gbU = NULL;
+
+  numTriangles = 0;
+
+  if(mode==GB_PLUS_TIMES)
+  {
+    GrB_Matrix_new (&gbC, GrB_UINT32, m, m);
+
+    // gbC=gbL*gbL mask gbL
+    GrB_mxm (gbC, gbL, NULL, GrB_PLUS_TIMES_UINT32, gbL, gbL, NULL);
+  }
+#if defined(GxB_IMPLEMENTATION_MAJOR) && GxB_IMPLEMENTATION_MAJOR >= 4
+  else if(mode==GB_PLUS_PAIR)
+  {
+    GrB_Matrix_new (&gbC, GrB_UINT32, m, m);
+
+    // gbC=gbL*gbL mask structure of gbL
+    GrB_mxm (gbC, gbL, NULL, GxB_PLUS_PAIR_UINT32, gbL, gbL, GrB_DESC_S);
+  }
+  else if(mode==GB_SANDIA_DOT)
+  {
+    GrB_Matrix_new (&gbU, GrB_UINT32, m, m);
+    GrB_transpose (gbU, NULL, NULL, gbL, NULL);
+
+    GrB_Matrix_new (&gbC, GrB_UINT32, m, m);
+
+    // gbC=gbL*gbU' mask structure of gbL (dot products)
+    GrB_mxm (gbC, gbL, NULL, GxB_PLUS_PAIR_UINT32, gbL, gbU, GrB_DESC_ST1);
+  }
+#endif
+  else
+  {
+    std::cerr << "Formulation " << GB_MODE_NAMES[mode] 
+              << " requires SuiteSparse:GraphBLAS 4 or later" << std::endl;
+    exit(1);
+  }
+
+  ///////////////////////////////////////////////////////////////////////
+  // Sum up triangles
+  ///////////////////////////////////////////////////////////////////////
+  //GrB_reduce (&numTriangles, NULL, GrB_PLUS_INT64_MONOID, gbC, NULL);
+  GrB_Matrix_reduce_INT64(&numTriangles, NULL, GrB_PLUS_INT64_MONOID, gbC, NULL);
+  ///////////////////////////////////////////////////////////////////////
+
+  double eTime = timer1.seconds();
+
+  GrB_Matrix_free(&gbC);
+  if(gbU!=NULL)
+  {
+    GrB_Matrix_free(&gbU);
+  }
+
+  return eTime;
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // Count triangles in graph
 //////////////////////////////////////////////////////////////////////////////
-double Graph::triangleCount()
+double Graph::triangleCount(gbmode_t mode)
 {
   //  struct timeval t1, t2, t3, t4;
   double eTime1;
@@ -90,10 +200,6 @@ double Graph::triangleCount()
             << "**********" << std::endl;
 
 
-  // Initialize Graph BLAS, should be moved to main?
-  GrB_init(GrB_NONBLOCKING);
-
-
   //////////////////////////////////////////////////////////////////
   // typedefs
   //////////////////////////////////////////////////////////////////
@@ -121,125 +227,223 @@ double Graph::triangleCount()
   //////////////////////////////////////////////////////////////////
   // Create "lower triangle" matrix in graphBLAS format
   //////////////////////////////////////////////////////////////////
-  size_type nnz = mAdjMatrixA.nnz();
-  size_type nnzL = nnz/2;
+  graph_t & graphA = mAdjMatrixA.graph; 
+
+  auto rowmapA = graphA.row_map;
+  lno_nnz_view_t colIndsA = graphA.entries;
+
+  const ordinal_t *newIdx = newIndices.data();
 
   /////////////////////////////////////////////////////////////
-  // Create tuple arrays i,j,v
+  // Row pointers of L: count nonzeros of each row, then
+  // prefix sum over rows
   /////////////////////////////////////////////////////////////
-  GrB_Index *i = (GrB_Index*) malloc (nnzL * sizeof (int64_t));
-  GrB_Index *j = (GrB_Index*) malloc (nnzL * sizeof (int64_t));
+  GrB_Index *rowPtrL = (GrB_Index*) malloc ((m+1) * sizeof (GrB_Index));
 
-  // Should this be int or something else?
-  uint32_t *v = (uint32_t *) malloc (nnzL * sizeof (uint32_t));
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &rownum)
+    {
+      GrB_Index nnzInRow=0;
+      for(size_type indx=rowmapA[rownum]; indx<rowmapA[rownum+1]; indx++)
+      {
+        if(newIdx[colIndsA[indx]] < newIdx[rownum])
+        {
+          nnzInRow++;
+        }
+      }
+      rowPtrL[rownum+1] = nnzInRow;
+    }
+  );
+
+  rowPtrL[0] = 0;
+  Kokkos::parallel_scan(Kokkos::RangePolicy<myExecSpace>(0,m+1),
+    KOKKOS_LAMBDA(const ordinal_t &rownum, GrB_Index &update, const bool final)
+    {
+      update += rowPtrL[rownum];
+      if(final)
+      {
+        rowPtrL[rownum] = update;
+      }
+    }
+  );
+
+  GrB_Index nnzL = rowPtrL[m];
   /////////////////////////////////////////////////////////////
 
   /////////////////////////////////////////////////////////////
-  // Copy data from KK structure to Graph BLAS arrays
+  // Column indices of L, each row filled independently
+  // (sorted, since the rows of A are)
   /////////////////////////////////////////////////////////////
-  graph_t & graphA = mAdjMatrixA.graph; 
+  GrB_Index *colIndsL = (GrB_Index*) malloc ((nnzL+1) * sizeof (GrB_Index));
 
-   auto rowmapA = graphA.row_map;
-  //lno_view_t rowmapL = graphL.row_map;
-  lno_nnz_view_t colIndsA = graphA.entries;
-
-  size_type nzIndx=0;
-  for(ordinal_t rownum=0; rownum<m; rownum++)
-  {
-    for(size_type indx=rowmapA[rownum]; indx<rowmapA[rownum+1]; indx++)
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &rownum)
     {
-      if(newIndices[colIndsA[indx]] < newIndices[rownum])
+      GrB_Index nzIndx = rowPtrL[rownum];
+      for(size_type indx=rowmapA[rownum]; indx<rowmapA[rownum+1]; indx++)
       {
-        i[nzIndx] = rownum;
-        j[nzIndx] = colIndsA[indx];
-        v[nzIndx] = 1;
-        nzIndx++;
+        if(newIdx[colIndsA[indx]] < newIdx[rownum])
+        {
+          colIndsL[nzIndx++] = colIndsA[indx];
+        }
       }
     }
-  }
+  );
+  myExecSpace::fence();
   /////////////////////////////////////////////////////////////
 
+  GrB_Matrix gbL = NULL;
+
+#if defined(GxB_IMPLEMENTATION_MAJOR) && GxB_IMPLEMENTATION_MAJOR >= 5
   /////////////////////////////////////////////////////////////
-  // Build Graph BLAS matrix from tuples
+  // Import CSR arrays without copying -- on success Graph BLAS
+  // takes ownership of rowPtrL, colIndsL and v.  All values are
+  // 1, so from 5.1 on L is iso-valued and needs a single value;
+  // 5.0 has no iso matrices and needs nnzL values.
   /////////////////////////////////////////////////////////////
-  GrB_Matrix gbL = NULL;
+#if GxB_IMPLEMENTATION >= GxB_VERSION(5,1,0)
+  GrB_Index numVals = 1;
+#else
+  GrB_Index numVals = nnzL+1;
+#endif
+
+  uint32_t *v = (uint32_t *) malloc (numVals * sizeof (uint32_t));
+  for(GrB_Index vIndx=0; vIndx<numVals; vIndx++)
+  {
+    v[vIndx] = 1;
+  }
+
+#if GxB_IMPLEMENTATION >= GxB_VERSION(5,1,0)
+  GrB_Info info = GxB_Matrix_import_CSR (&gbL, GrB_UINT32, m, m, &rowPtrL, &colIndsL, (void **) &v,
+                                         (m+1)*sizeof(GrB_Index), (nnzL+1)*sizeof(GrB_Index),
+                                         numVals*sizeof(uint32_t), true, false, NULL);
+#else
+  GrB_Info info = GxB_Matrix_import_CSR (&gbL, GrB_UINT32, m, m, &rowPtrL, &colIndsL, (void **) &v,
+                                         (m+1)*sizeof(GrB_Index), (nnzL+1)*sizeof(GrB_Index),
+                                         numVals*sizeof(uint32_t), false, NULL);
+#endif
+
+  // Arrays are not transferred on failure
+  if(info != GrB_SUCCESS)
+  {
+    std::cerr << "GxB_Matrix_import_CSR failed for L: " << info << std::endl;
+    free(rowPtrL);
+    free(colIndsL);
+    free(v);
+    exit(1);
+  }
+  /////////////////////////////////////////////////////////////
+#else
+  /////////////////////////////////////////////////////////////
+  // No import in this Graph BLAS -- fill tuple arrays i,j,v in
+  // parallel from the CSR arrays and build matrix from tuples
+  /////////////////////////////////////////////////////////////
+  GrB_Index *i = (GrB_Index*) malloc ((nnzL+1) * sizeof (GrB_Index));
+
+  // Should this be int or something else?
+  uint32_t *v = (uint32_t *) malloc ((nnzL+1) * sizeof (uint32_t));
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &rownum)
+    {
+      for(GrB_Index nzIndx=rowPtrL[rownum]; nzIndx<rowPtrL[rownum+1]; nzIndx++)
+      {
+        i[nzIndx] = rownum;
+        v[nzIndx] = 1;
+      }
+    }
+  );
+  myExecSpace::fence();
 
   GrB_Matrix_new (&gbL, GrB_UINT32, m, m);
   //For some reason this macro didn't seem to work
   //GrB_Matrix_build (C, i, j, v, nnz, GrB_PLUS_UINT32);
-  GrB_Matrix_build_UINT32 (gbL, i, j, v, nnzL, GrB_PLUS_UINT32);
+  GrB_Matrix_build_UINT32 (gbL, i, colIndsL, v, nnzL, GrB_PLUS_UINT32);
+
+  free(i);
+  free(v);
+  free(rowPtrL);
+  free(colIndsL);
   /////////////////////////////////////////////////////////////
+#endif
 
+  std::cout << "Time to create L matrix: " << timer1.seconds() << std::endl;
   //////////////////////////////////////////////////////////////////
 
-  ///////////////////////////////////////////////////////////////////////
-  // C = L*L mask L using Graph BLAS
-  ///////////////////////////////////////////////////////////////////////
-  Kokkos::Impl::Timer timer2;
-  GrB_Matrix gbC = NULL;
-  //  OK (GrB_Matrix_nrows (&n, L)) ;
-  GrB_Matrix_new (&gbC, GrB_UINT32, m, m);
-
-  // gbC=gbL*gbL mask gbL                                                                                    
-  GrB_mxm (gbC, gbL, NULL, GrB_PLUS_TIMES_UINT32, gbL, gbL, NULL);
+  double lTime = timer1.seconds();
 
   ///////////////////////////////////////////////////////////////////////
-
-
-  ///////////////////////////////////////////////////////////////////////
-  // Sum up triangles
+  // C = L*L mask L using Graph BLAS, for each requested formulation
   ///////////////////////////////////////////////////////////////////////
-  //GrB_reduce (&numTriangles, NULL, GrB_PLUS_INT64_MONOID, gbC, NULL);
-  GrB_Matrix_reduce_INT64(&numTriangles, NULL, GrB_PLUS_INT64_MONOID, gbC, NULL);
-  ///////////////////////////////////////////////////////////////////////
-
-  myExecSpace::fence();
-  eTime1 = timer1.seconds();
-
-
-  std::cout << "************************************************************"
-            << "**********" << std::endl;
-  std::cout << "Finished triangle counting" << std::endl;
-  std::cout << "************************************************************" 
-            << "**********" << std::endl;
-
-  //////////////////////////////////////////////////////////////////
-  // Output triangle counting info
-  //////////////////////////////////////////////////////////////////
   ordinal_t numVerts = mAdjMatrixA.numRows();
   size_type numEdges = mAdjMatrixA.nnz()/2;
 
-  std::cout << "|V| = " << numVerts << std::endl;
-  std::cout << "|E| = " << numEdges << std::endl;
-  std::cout << "|T| = " << numTriangles << std::endl;
+  int firstMode = (mode==GB_ALL_MODES) ? 0 : mode;
+  int lastMode = (mode==GB_ALL_MODES) ? GB_ALL_MODES-1 : mode;
 
-  std::cout << "Time to count triangles: " << eTime1 << std::endl;
-  //////////////////////////////////////////////////////////////////
+  eTime1 = 0.0;
+  double kernelTime = 0.0;
+
+  for(int currMode=firstMode; currMode<=lastMode; currMode++)
+  {
+    double mxmTime = maskedProductCount(gbL, m, (gbmode_t) currMode, numTriangles);
+
+    myExecSpace::fence();
+    eTime1 = lTime + mxmTime;
+    kernelTime += mxmTime;
+
+    std::cout << "************************************************************"
+              << "**********" << std::endl;
+    std::cout << "Finished triangle counting" << std::endl;
+    std::cout << "************************************************************" 
+              << "**********" << std::endl;
+
+    //////////////////////////////////////////////////////////////////
+    // Output triangle counting info
+    //////////////////////////////////////////////////////////////////
+    std::cout << "|V| = " << numVerts << std::endl;
+    std::cout << "|E| = " << numEdges << std::endl;
+    std::cout << "|T| = " << numTriangles << std::endl;
+
+    std::cout << "Time to count triangles: " << eTime1 << std::endl;
+
+    // One line per run, same fields as the Kokkos-Kernels driver
+    std::cout << "BENCH method=graphBLAS-" << GB_MODE_NAMES[currMode]
+              << " file=" << mFilename << " V=" << numVerts << " E=" << numEdges
+              << " T=" << numTriangles << " timeL=" << lTime
+              << " timeCount=" << mxmTime << " timeTotal=" << eTime1 << std::endl;
+    //////////////////////////////////////////////////////////////////
+  }
+  ///////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
-  // free arrays
+  // free matrices (Graph BLAS stays initialized for later counts)
   //////////////////////////////////////////////////////////////////
-  free(i);
-  free(j);
-  free(v);
+  GrB_Matrix_free(&gbL);
   //////////////////////////////////////////////////////////////////
 
 
-
-  GrB_finalize();
-
-
-  return eTime1;
+  return kernelTime;
 }
 //////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
-// Reads matrix market file
+// Reads graph file -- Matrix Market (.mtx), cached CSR (.csr) or binary
+// edge file (see kkGraphReader.h)
 ////////////////////////////////////////////////////////////////////////////////
-void readMMMatrixA(const char *fname, crsMat_t &matrix)
+void readMatrixA(const char *fname, crsMat_t &matrix)
+{
+  readKKMatrix<crsMat_t,myExecSpace>(fname, matrix);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Writes graph as cached CSR file
+//////////////////////////////////////////////////////////////////////////////
+void Graph::writeCSR(std::string fname) const
 {
-   matrix = KokkosKernels::Impl::read_kokkos_crst_matrix<crsMat_t>(fname);
-   matrix.values = values_view_t();
+  writeCachedCrsMatrix(fname.c_str(), mAdjMatrixA);
+  std::cout << "Wrote cached CSR file " << fname << std::endl;
 }
 //////////////////////////////////////////////////////////////////////////////
 
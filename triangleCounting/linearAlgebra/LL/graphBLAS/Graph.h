@@ -56,7 +56,17 @@
 #include "triCountConfig.h"
 #include "KokkosSparse_CrsMatrix.hpp"
 
-void readMMMatrixA(const char* fname, crsMat_t &outMat);
+void readMatrixA(const char* fname, crsMat_t &outMat);
+
+//////////////////////////////////////////////////////////////////////////////
+// Formulations of C = L*L mask L (see maskedProductCount in Graph.cpp)
+//////////////////////////////////////////////////////////////////////////////
+enum gbmode_t {GB_PLUS_TIMES=0, GB_PLUS_PAIR, GB_SANDIA_DOT, GB_ALL_MODES};
+
+extern const char *GB_MODE_NAMES[];
+
+gbmode_t parseGBMode(const char *name);
+//////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
 // Graph class
@@ -69,6 +79,8 @@ class Graph
   ordinal_t mNumVerts;
   ordinal_t mNumEdges;
 
+  std::string mFilename;
+
   crsMat_t mAdjMatrixA;
 
  public:
@@ -76,7 +88,7 @@ class Graph
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mNumVerts(0),mAdjMatrixA()
+    :mNumVerts(0),mFilename("UNDEFINED"),mAdjMatrixA()
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -85,7 +97,7 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string fname1) 
-    :mAdjMatrixA()
+    :mFilename(fname1),mAdjMatrixA()
   {
     struct timeval t1, t2;
 
@@ -96,7 +108,7 @@ class Graph
     ////////////////////////////////////////////////////////////////////
 
     std::cout << "Reading input file..." << std::endl;
-    readMMMatrixA(fname1.c_str(),mAdjMatrixA);
+    readMatrixA(fname1.c_str(),mAdjMatrixA);
 
     std::cout << "Finished Reading input file." << std::endl;
     ////////////////////////////////////////////////////////////////////
@@ -120,9 +132,19 @@ class Graph
 
 
   //////////////////////////////////////////////////////////////////////////
-  // Count triangles
+  // Count triangles with formulation mode (GB_ALL_MODES runs each
+  // formulation on the same L).  Returns the time of the masked
+  // products only, excluding the construction of L
+  //////////////////////////////////////////////////////////////////////////
+  double triangleCount(gbmode_t mode=GB_PLUS_TIMES);
+  //////////////////////////////////////////////////////////////////////////
+
+  size_type getNumEdges() const {return mAdjMatrixA.nnz()/2;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Writes graph as cached CSR file, for fast reading by later runs
   //////////////////////////////////////////////////////////////////////////
-  double triangleCount();
+  void writeCSR(std::string fname) const;
   //////////////////////////////////////////////////////////////////////////
 
 };
@@ -53,22 +53,48 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <vector>
+#include <string>
 
 #include <omp.h>
 
 #include <sys/time.h>
 
+#include "trialUtil.h"
 #include "Graph.h"
 
+extern "C"{
+#include "GraphBLAS.h"
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 // Main
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  if(argc!=3)
+  // --trials N --warmup W are removed from argv
+  trialParams trials;
+  parseTrialOptions(argc, argv, trials);
+
+  //////////////////////////////////////////////////////////////////
+  // Options follow the positional arguments
+  //////////////////////////////////////////////////////////////////
+  int numArgs = argc;
+  std::string csrFile;
+
+  if(argc>=2 && std::string(argv[argc-2])=="--write-csr")
+  {
+    csrFile = argv[argc-1];
+    numArgs = argc-2;
+  }
+  //////////////////////////////////////////////////////////////////
+
+  if(numArgs!=3 && numArgs!=4)
   {
-    std::cerr << "Usage: miniTri.exe matrixFile numThreads" << std::endl;
+    std::cerr << "Usage: miniTri.exe matrixFile numThreads"
+              << " [formulation ={plustimes || pluspair || sandiadot || all}]"
+              << " [--write-csr csrFile] [--trials N --warmup W]" << std::endl;
     exit(1);
   }
 
@@ -78,12 +104,52 @@ int main(int argc, char *argv[])
   mat1 = argv[1];
   numThreads = atoi(argv[2]);
 
+  gbmode_t mode = GB_PLUS_TIMES;
+  if(numArgs==4)
+  {
+    mode = parseGBMode(argv[3]);
+  }
+
   Kokkos::OpenMP::initialize(numThreads); // Can I use execspace for this?
   Kokkos::OpenMP::print_configuration(std::cout);
 
+  // Graph BLAS is initialized once per process, so that repeated counts
+  // do not pay for its setup
+  GrB_init(GrB_NONBLOCKING);
+
   Graph g(mat1);
 
-  g.triangleCount();
+  if(csrFile!="")
+  {
+    g.writeCSR(csrFile);
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Count triangles warmup+trials times on the resident graph, timing
+  // the counting kernel
+  ////////////////////////////////////////////////////////////////////////
+  std::vector<double> times;
+
+  for(int run=0; run<trials.warmup+trials.trials; run++)
+  {
+    silenceOutput(run>0);
+
+    double eTime = g.triangleCount(mode);
+
+    if(run>=trials.warmup)
+    {
+      times.push_back(eTime);
+    }
+  }
+  silenceOutput(false);
+
+  if(trials.enabled)
+  {
+    printTrialStats("LL-graphBLAS", trials, times, g.getNumEdges());
+  }
+  ////////////////////////////////////////////////////////////////////////
+
+  GrB_finalize();
 
   myExecSpace::finalize();
 
@@ -50,8 +50,11 @@
 //              Source file for graph class.                                //
 //////////////////////////////////////////////////////////////////////////////
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <cassert>
 #include <cstdlib>
 #include <sys/time.h>
@@ -59,41 +62,45 @@
 #include "Graph.h"
 #include "mmUtil.h"
 #include "mmio.h"
+#include "kkGraphReader.h"
+#include "supportUtil.h"
 
 #include <impl/Kokkos_Timer.hpp>
 
 #include "KokkosGraph_Triangle.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
-// Count triangles in graph
+// typedefs
 //////////////////////////////////////////////////////////////////////////////
-double Graph::triangleCount()
-{
-  double eTime;
-
-  size_t numTriangles;
-
-
-  std::cout << "************************************************************"
-            << "**********" << std::endl;
-  std::cout << "Counting triangles ....." << std::endl;
-  std::cout << "************************************************************" 
-            << "**********" << std::endl;
-
-
+typedef typename crsMat_t::StaticCrsGraphType::row_map_type::non_const_type lno_view_t;
+typedef typename crsMat_t::StaticCrsGraphType::entries_type::non_const_type lno_nnz_view_t;
+typedef myExecSpace TempMemSpace;
+typedef myExecSpace PersistentMemSpace;
 
-  //////////////////////////////////////////////////////////////////
-  // typedefs
-  //////////////////////////////////////////////////////////////////
-  typedef typename crsMat_t::StaticCrsGraphType::row_map_type::non_const_type lno_view_t;
-  typedef typename crsMat_t::StaticCrsGraphType::entries_type::non_const_type lno_nnz_view_t;
-  typedef myExecSpace TempMemSpace;
-  typedef myExecSpace PersistentMemSpace;
+typedef KokkosKernels::Experimental::KokkosKernelsHandle
+  <lno_view_t,lno_nnz_view_t, lno_nnz_view_t, myExecSpace, TempMemSpace,PersistentMemSpace > KernelHandle;
+//////////////////////////////////////////////////////////////////////////////
 
-  typedef KokkosKernels::Experimental::KokkosKernelsHandle
-    <lno_view_t,lno_nnz_view_t, lno_nnz_view_t, myExecSpace, TempMemSpace,PersistentMemSpace > KernelHandle;
-  //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// Settings swept by autotuning, and target number of nonzeros of the
+// sample of L they are timed on
+//////////////////////////////////////////////////////////////////////////////
+static const int TUNE_WORK_SIZES[] = {4, 8, 16, 32, 64, 128, 256};
+static const int TUNE_NUM_WORK_SIZES = 7;
+static const double TUNE_SAMPLE_NNZ = 2000000.0;
+//////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Counts triangles of L: C = L*L mask L
+//
+// Runs the Kokkos-Kernels triangle kernel with the given settings and
+// returns the time of the kernel and the sum.  L must be acyclic (here
+// degree ordered), so each triangle is counted once.
+//////////////////////////////////////////////////////////////////////////////
+static double triangleKernel(const kkTuning &tuning, ordinal_t m,
+                             const row_map_view_t &rowMapL, const cols_view_t &entriesL,
+                             size_t &numTriangles, bool verbose)
+{
   //////////////////////////////////////////////////////////////////
   // Set Parameters to tune kkmem algorithm
   //////////////////////////////////////////////////////////////////
@@ -102,18 +109,19 @@ double Graph::triangleCount()
   KernelHandle kh;
   kh.create_spgemm_handle(KokkosSparse::SPGEMM_KK_TRIANGLE_LL);
 
-  kh.set_dynamic_scheduling(true);
-
+  kh.set_dynamic_scheduling(tuning.dynamicScheduling);
 
   // Sets thread chunk size
-  int chunk_size=16;
-  kh.set_team_work_size(chunk_size);
+  kh.set_team_work_size(tuning.teamWorkSize);
 
   // 2 steps of compression (true would be 1 step of compression)
-  kh.get_spgemm_handle()->set_compression_steps(false);
+  kh.get_spgemm_handle()->set_compression_steps(tuning.oneStepCompression);
 
-  kh.set_verbose(true);
+  // L is formed (and ordered) explicitly by createL
+  kh.get_spgemm_handle()->set_create_lower_triangular(false);
+  kh.get_spgemm_handle()->set_sort_lower_triangular(false);
 
+  kh.set_verbose(verbose);
 
   //////////////////////////////////////////////////////
   // Other Kokkos Kernels options that were not used
@@ -123,9 +131,6 @@ double Graph::triangleCount()
   //kh.set_shmem_size(shmemsize);
   //kh.set_suggested_team_size(team_size);
 
-  // Tells SGEMM not to sort the lower triangular since we are going to sort this ourselves
-  // kh.get_spgemm_handle()->set_sort_lower_triangular(false);
-
   //This is to calculate the number of operations
   //kh.get_spgemm_handle()->set_read_write_cost_calc(true);
 
@@ -136,55 +141,24 @@ double Graph::triangleCount()
   //////////////////////////////////////////////////////////////////
   // Allocate memory for output structure
   //////////////////////////////////////////////////////////////////
-  const ordinal_t m = mAdjMatrixA.numRows();
-
   Kokkos::View <size_t *,myExecSpace> matC_row;
 
   matC_row = Kokkos::View <size_t *,myExecSpace> ("Counts of triangles for each row", m);
   //////////////////////////////////////////////////////////////////
 
-  //  crsMat_t adjMatrixL;
-
-  // std::vector<ordinal_t> newIndices;
-
-  // newIndices.resize(m);
-
-
-
-  ///////////////////////////////////////////////////////////////////////
-  // C = L*L mask L
-  ///////////////////////////////////////////////////////////////////////
   Kokkos::Impl::Timer timer1;
 
-  // For now comment these out, eventually want to explicitly do this
-  //
-  // //////////////////////////////////////////////////////////////////
-  // // Creating lower triangular matrix.
-  // //////////////////////////////////////////////////////////////////
-
-  // // Determine order of vertices/rows when forming L
-  // KokkosKernels::Experimental::Util::
-  //   kk_sort_by_row_size <size_type, ordinal_t,myExecSpace>(m,mAdjMatrixA.graph.row_map.data(),
-  // 							   newIndices.data());
-
-  // // Create "lower triangular" portion of matrix
-  // adjMatrixL = KokkosKernels::Experimental::Util::kk_get_lower_crs_matrix(mAdjMatrixA,newIndices.data());
-  // //////////////////////////////////////////////////////////////////
-
   //////////////////////////////////////////////////////////////////
   // Triangle counting
   // Counts triangles using linear algebra formulation for C = L*L with mask
   //
   // kh -- kernel handle
   // m -- Number of rows in L and C
-  // graphL.row_map -- KokkosView of row map, matrix L
-  // graphL.entries -- KokkosView of column indices, matrix L
+  // rowMapL -- KokkosView of row map, matrix L
+  // entriesL -- KokkosView of column indices, matrix L
   // Q kokkos Lambda -- run on each entry of resulting matrix
   //////////////////////////////////////////////////////////////////
-  //  graph_t & graphL = adjMatrixL.graph;
-  graph_t & graphA = mAdjMatrixA.graph;
-
-  KokkosGraph::Experimental::triangle_generic(&kh, m, graphA.row_map, graphA.entries,
+  KokkosGraph::Experimental::triangle_generic(&kh, m, rowMapL, entriesL,
       KOKKOS_LAMBDA(const ordinal_t& row, const ordinal_t &col_set_index, const ordinal_t &col_set,  const ordinal_t &thread_id) 
       {
 	matC_row(row) += KokkosKernels::Impl::pop_count(col_set);
@@ -201,9 +175,61 @@ double Graph::triangleCount()
   //////////////////////////////////////////////////////////////////
 
   myExecSpace::fence();
-  eTime = timer1.seconds();
+
+  return timer1.seconds();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Count triangles in graph
+//////////////////////////////////////////////////////////////////////////////
+double Graph::triangleCount()
+{
+  double eTime;
+
+  size_t numTriangles;
 
 
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Counting triangles ....." << std::endl;
+  std::cout << "************************************************************" 
+            << "**********" << std::endl;
+
+  const ordinal_t m = mAdjMatrixA.numRows();
+
+  //////////////////////////////////////////////////////////////////
+  // Creating lower triangular matrix
+  //////////////////////////////////////////////////////////////////
+  row_map_view_t rowMapL;
+  cols_view_t entriesL;
+
+  double lTime = createL(rowMapL, entriesL);
+
+  std::cout << "Time to create L matrix: " << lTime << std::endl;
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Kernel settings
+  //////////////////////////////////////////////////////////////////
+  if(mAutoTune)
+  {
+    eTime = autoTune(rowMapL, entriesL);
+    std::cout << "Time to autotune: " << eTime << std::endl;
+  }
+
+  std::cout << "Kernel settings: team work size = " << mTuning.teamWorkSize
+            << ", compression steps = " << (mTuning.oneStepCompression ? 1 : 2)
+            << ", dynamic scheduling = " << (mTuning.dynamicScheduling ? "yes" : "no") 
+            << std::endl;
+  //////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////
+  // C = L*L mask L
+  ///////////////////////////////////////////////////////////////////////
+  eTime = triangleKernel(mTuning, m, rowMapL, entriesL, numTriangles, true);
+  ///////////////////////////////////////////////////////////////////////
+
   std::cout << "************************************************************"
             << "**********" << std::endl;
   std::cout << "Finished triangle counting" << std::endl;
@@ -221,20 +247,435 @@ double Graph::triangleCount()
   std::cout << "|T| = " << numTriangles << std::endl;
 
   std::cout << "Time to count triangles: " << eTime << std::endl;
+
+  // One line per run, same fields as the Graph BLAS driver
+  std::cout << "BENCH method=kokkos-LL file=" << mFilename << " V=" << numVerts 
+            << " E=" << numEdges << " T=" << numTriangles << " timeL=" << lTime
+            << " timeCount=" << eTime << " timeTotal=" << lTime+eTime << std::endl;
   //////////////////////////////////////////////////////////////////
 
+  if(mSupportFile!="")
+  {
+    triangleSupport(numTriangles);
+  }
+
+
+  return eTime;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Forms degree-ordered L
+//     -- keeps the column order of A, so rows of L are sorted if those
+//        of A are
+//////////////////////////////////////////////////////////////////////////////
+double Graph::createL(row_map_view_t &rowMapL, cols_view_t &entriesL)
+{
+  Kokkos::Impl::Timer timer1;
+
+  const ordinal_t m = mAdjMatrixA.numRows();
+
+  row_map_view_t rowMapA = mAdjMatrixA.graph.row_map;
+  cols_view_t entriesA = mAdjMatrixA.graph.entries;
+
+  rowMapL = row_map_view_t("Row map of L", m+1);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &row)
+    {
+      size_type degRow = rowMapA(row+1) - rowMapA(row);
+      size_type nnzInRow=0;
+      for(size_type nz=rowMapA(row); nz<rowMapA(row+1); nz++)
+      {
+        ordinal_t col = entriesA(nz);
+        size_type degCol = rowMapA(col+1) - rowMapA(col);
+        if(degCol>degRow || (degCol==degRow && col<row))
+        {
+          nnzInRow++;
+        }
+      }
+      rowMapL(row+1) = nnzInRow;
+    }
+  );
+
+  Kokkos::parallel_scan(Kokkos::RangePolicy<myExecSpace>(0,m+1),
+    KOKKOS_LAMBDA(const ordinal_t &row, size_type &update, const bool final)
+    {
+      update += rowMapL(row);
+      if(final)
+      {
+        rowMapL(row) = update;
+      }
+    }
+  );
+
+  size_type nnzL;
+  Kokkos::deep_copy(nnzL, Kokkos::subview(rowMapL, m));
+
+  entriesL = cols_view_t("Entries of L", nnzL);
+
+  cols_view_t entries = entriesL;
+  row_map_view_t rowMap = rowMapL;
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &row)
+    {
+      size_type degRow = rowMapA(row+1) - rowMapA(row);
+      size_type nzL = rowMap(row);
+      for(size_type nz=rowMapA(row); nz<rowMapA(row+1); nz++)
+      {
+        ordinal_t col = entriesA(nz);
+        size_type degCol = rowMapA(col+1) - rowMapA(col);
+        if(degCol>degRow || (degCol==degRow && col<row))
+        {
+          entries(nzL++) = col;
+        }
+      }
+    }
+  );
+
+  myExecSpace::fence();
+
+  return timer1.seconds();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Autotunes kernel settings
+//
+// The cache file has one line per input and thread count:
+//    filename numRows nnz concurrency teamWorkSize compressionSteps dynamic
+// Settings are timed on the subgraph of L induced by a sample of the
+// vertices (sampling rate chosen for about TUNE_SAMPLE_NNZ nonzeros), which
+// keeps the degree ordering and the shape of the rows of L.
+//////////////////////////////////////////////////////////////////////////////
+double Graph::autoTune(const row_map_view_t &rowMapL, const cols_view_t &entriesL)
+{
+  Kokkos::Impl::Timer timer1;
+
+  const ordinal_t m = mAdjMatrixA.numRows();
+  const size_type nnz = mAdjMatrixA.nnz();
+  const int concurrency = myExecSpace::concurrency();
+
+  //////////////////////////////////////////////////////////////////
+  // Look up cache
+  //////////////////////////////////////////////////////////////////
+  std::ifstream cacheIn(mTuneCache.c_str());
+  std::string line;
+
+  while(std::getline(cacheIn,line))
+  {
+    std::istringstream iss(line);
+    std::string fname;
+    long long cacheM, cacheNNZ;
+    int cacheConc, workSize, compSteps, dynamic;
+
+    if((iss >> fname >> cacheM >> cacheNNZ >> cacheConc >> workSize >> compSteps >> dynamic) &&
+       fname==mFilename && cacheM==m && cacheNNZ==nnz && cacheConc==concurrency)
+    {
+      mTuning.teamWorkSize = workSize;
+      mTuning.oneStepCompression = (compSteps==1);
+      mTuning.dynamicScheduling = (dynamic==1);
+
+      std::cout << "Using cached kernel settings from " << mTuneCache << std::endl;
+      return timer1.seconds();
+    }
+  }
+  cacheIn.close();
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Sample of L
+  //////////////////////////////////////////////////////////////////
+  typename row_map_view_t::HostMirror hRowMapL = Kokkos::create_mirror_view(rowMapL);
+  typename cols_view_t::HostMirror hEntriesL = Kokkos::create_mirror_view(entriesL);
+  Kokkos::deep_copy(hRowMapL, rowMapL);
+  Kokkos::deep_copy(hEntriesL, entriesL);
+
+  size_type nnzL = hRowMapL(m);
+  double rate = (nnzL>0) ? std::min(1.0, sqrt(TUNE_SAMPLE_NNZ/nnzL)) : 1.0;
+
+  std::vector<ordinal_t> sampleID(m,-1);
+  ordinal_t mS=0;
+  for(ordinal_t v=0; v<m; v++)
+  {
+    // Knuth multiplicative hash of vertex ID
+    if(((uint32_t) v * 2654435761u) < rate*4294967296.0)
+    {
+      sampleID[v] = mS++;
+    }
+  }
+
+  std::vector<size_type> rowMapS(1,0);
+  std::vector<ordinal_t> entriesS;
+  for(ordinal_t v=0; v<m; v++)
+  {
+    if(sampleID[v]<0)
+    {
+      continue;
+    }
+    for(size_type nz=hRowMapL(v); nz<hRowMapL(v+1); nz++)
+    {
+      if(sampleID[hEntriesL(nz)]>=0)
+      {
+        entriesS.push_back(sampleID[hEntriesL(nz)]);
+      }
+    }
+    rowMapS.push_back(entriesS.size());
+  }
+
+  row_map_view_t rowMapSample("Row map of sample", mS+1);
+  cols_view_t entriesSample("Entries of sample", entriesS.size());
+
+  typename row_map_view_t::HostMirror hRowMapS = Kokkos::create_mirror_view(rowMapSample);
+  typename cols_view_t::HostMirror hEntriesS = Kokkos::create_mirror_view(entriesSample);
+  for(ordinal_t row=0; row<=mS; row++)
+  {
+    hRowMapS(row) = rowMapS[row];
+  }
+  for(size_t nz=0; nz<entriesS.size(); nz++)
+  {
+    hEntriesS(nz) = entriesS[nz];
+  }
+  Kokkos::deep_copy(rowMapSample, hRowMapS);
+  Kokkos::deep_copy(entriesSample, hEntriesS);
+
+  std::cout << "Autotuning on sample: " << mS << " rows, " << entriesS.size() 
+            << " nonzeros" << std::endl;
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Sweep settings, best of 2 runs each
+  //////////////////////////////////////////////////////////////////
+  double bestTime = -1.0;
+
+  for(int w=0; w<TUNE_NUM_WORK_SIZES; w++)
+  {
+    for(int comp=0; comp<2; comp++)
+    {
+      for(int dyn=0; dyn<2; dyn++)
+      {
+        kkTuning tuning;
+        tuning.teamWorkSize = TUNE_WORK_SIZES[w];
+        tuning.oneStepCompression = (comp==1);
+        tuning.dynamicScheduling = (dyn==1);
+
+        size_t sampleTris;
+        double tTime = std::min(triangleKernel(tuning, mS, rowMapSample, entriesSample, sampleTris, false),
+                                triangleKernel(tuning, mS, rowMapSample, entriesSample, sampleTris, false));
+
+        if(bestTime<0.0 || tTime<bestTime)
+        {
+          bestTime = tTime;
+          mTuning = tuning;
+        }
+      }
+    }
+  }
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Add to cache
+  //////////////////////////////////////////////////////////////////
+  std::ofstream cacheOut(mTuneCache.c_str(), std::ios::app);
+  if(!cacheOut)
+  {
+    std::cerr << "Warning: could not write autotuning cache " << mTuneCache << std::endl;
+  }
+  else
+  {
+    cacheOut << mFilename << " " << m << " " << nnz << " " << concurrency << " "
+             << mTuning.teamWorkSize << " " << (mTuning.oneStepCompression ? 1 : 2) << " "
+             << (mTuning.dynamicScheduling ? 1 : 0) << std::endl;
+  }
+  //////////////////////////////////////////////////////////////////
+
+  return timer1.seconds();
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Per-vertex triangle counts and per-edge support
+//
+// triangle_generic does not report the middle vertex of each wedge (and
+// counts on the degree-ordered L), so L is formed explicitly in
+// the natural ordering and the triangles of (L*L) .* L are found by merging
+// sorted rows: for each k in L(i,:), L(i,:) up to k with L(k,:).
+// Assumes the column indices of each row of A are sorted.
+//////////////////////////////////////////////////////////////////////////////
+double Graph::triangleSupport(size_t numTriangles)
+{
+  std::cout << "--------------------" << std::endl;
+  std::cout << "Computing triangle support ..." << std::endl;
+
+  Kokkos::Impl::Timer timer1;
+
+  const ordinal_t m = mAdjMatrixA.numRows();
+
+  row_map_view_t rowMapA = mAdjMatrixA.graph.row_map;
+  cols_view_t entriesA = mAdjMatrixA.graph.entries;
+
+  //////////////////////////////////////////////////////////////////
+  // Create lower triangular matrix L
+  //////////////////////////////////////////////////////////////////
+  row_map_view_t rowMapL("Row map of L", m+1);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &row)
+    {
+      size_type nnzInRow=0;
+      for(size_type nz=rowMapA(row); nz<rowMapA(row+1); nz++)
+      {
+        if(entriesA(nz)<row)
+        {
+          nnzInRow++;
+        }
+      }
+      rowMapL(row+1) = nnzInRow;
+    }
+  );
+
+  Kokkos::parallel_scan(Kokkos::RangePolicy<myExecSpace>(0,m+1),
+    KOKKOS_LAMBDA(const ordinal_t &row, size_type &update, const bool final)
+    {
+      update += rowMapL(row);
+      if(final)
+      {
+        rowMapL(row) = update;
+      }
+    }
+  );
+
+  size_type nnzL;
+  Kokkos::deep_copy(nnzL, Kokkos::subview(rowMapL, m));
+
+  cols_view_t entriesL("Entries of L", nnzL);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<myExecSpace>(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &row)
+    {
+      size_type nzL = rowMapL(row);
+      for(size_type nz=rowMapA(row); nz<rowMapA(row+1); nz++)
+      {
+        if(entriesA(nz)<row)
+        {
+          entriesL(nzL++) = entriesA(nz);
+        }
+      }
+    }
+  );
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Count triangles of each vertex and edge
+  //////////////////////////////////////////////////////////////////
+  Kokkos::View<int64_t *,myExecSpace> vertexTris("Triangles per vertex", m);
+  Kokkos::View<int *,myExecSpace> edgeSupport("Triangles per edge", nnzL);
+
+  size_t numSupportTris = 0;
+
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<myExecSpace,Kokkos::Schedule<Kokkos::Dynamic> >(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &rowI, size_t &numTris)
+    {
+      for(size_type nzI=rowMapL(rowI); nzI<rowMapL(rowI+1); nzI++)
+      {
+        ordinal_t rowK = entriesL(nzI);
+
+        size_type posI = rowMapL(rowI);
+        size_type posK = rowMapL(rowK);
+
+        while(posI<nzI && posK<rowMapL(rowK+1))
+        {
+          if(entriesL(posI)<entriesL(posK))
+          {
+            posI++;
+          }
+          else if(entriesL(posK)<entriesL(posI))
+          {
+            posK++;
+          }
+          else
+          {
+            // triangle rowI > rowK > entriesL(posI)
+            Kokkos::atomic_increment(&vertexTris(rowI));
+            Kokkos::atomic_increment(&vertexTris(rowK));
+            Kokkos::atomic_increment(&vertexTris(entriesL(posI)));
+
+            Kokkos::atomic_increment(&edgeSupport(nzI));
+            Kokkos::atomic_increment(&edgeSupport(posI));
+            Kokkos::atomic_increment(&edgeSupport(posK));
+
+            numTris++;
+            posI++;
+            posK++;
+          }
+        }
+      }
+    }, numSupportTris
+  );
+
+  myExecSpace::fence();
+  double eTime = timer1.seconds();
+
+  assert(numSupportTris==numTriangles);
+
+  std::cout << "Time to compute triangle support: " << eTime << std::endl;
+  //////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////
+  // Write to file
+  //////////////////////////////////////////////////////////////////
+  typename row_map_view_t::HostMirror hRowMapL = Kokkos::create_mirror_view(rowMapL);
+  typename cols_view_t::HostMirror hEntriesL = Kokkos::create_mirror_view(entriesL);
+  typename Kokkos::View<int64_t *,myExecSpace>::HostMirror hVertexTris = 
+    Kokkos::create_mirror_view(vertexTris);
+  typename Kokkos::View<int *,myExecSpace>::HostMirror hEdgeSupport = 
+    Kokkos::create_mirror_view(edgeSupport);
+
+  Kokkos::deep_copy(hRowMapL, rowMapL);
+  Kokkos::deep_copy(hEntriesL, entriesL);
+  Kokkos::deep_copy(hVertexTris, vertexTris);
+  Kokkos::deep_copy(hEdgeSupport, edgeSupport);
+
+  std::vector<edgeSupport_t> edges(nnzL);
+  for(ordinal_t row=0; row<m; row++)
+  {
+    for(size_type nz=hRowMapL(row); nz<hRowMapL(row+1); nz++)
+    {
+      edges[nz].v0 = row;
+      edges[nz].v1 = hEntriesL(nz);
+      edges[nz].support = hEdgeSupport(nz);
+    }
+  }
+
+  writeTriangleSupport(mSupportFile.c_str(), numTriangles, m, hVertexTris.data(),
+                       nnzL, edges.data());
+
+  std::cout << "Wrote triangle support to " << mSupportFile << std::endl;
+  std::cout << "--------------------" << std::endl;
+  //////////////////////////////////////////////////////////////////
 
   return eTime;
 }
 //////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
-// Reads matrix market file
+// Reads graph file -- Matrix Market (.mtx), cached CSR (.csr) or binary
+// edge file (see kkGraphReader.h)
 ////////////////////////////////////////////////////////////////////////////////
-void readMMMatrixA(const char *fname, crsMat_t &matrix)
+void readMatrixA(const char *fname, crsMat_t &matrix)
+{
+  readKKMatrix<crsMat_t,myExecSpace>(fname, matrix);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Writes graph as cached CSR file
+//////////////////////////////////////////////////////////////////////////////
+void Graph::writeCSR(std::string fname) const
 {
-   matrix = KokkosKernels::Impl::read_kokkos_crst_matrix<crsMat_t>(fname);
-   matrix.values = values_view_t();
+  writeCachedCrsMatrix(fname.c_str(), mAdjMatrixA);
+  std::cout << "Wrote cached CSR file " << fname << std::endl;
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -56,7 +56,7 @@
 #include "triCountConfig.h"
 #include "KokkosSparse_CrsMatrix.hpp"
 
-void readMMMatrixA(const char* fname, crsMat_t &outMat);
+void readMatrixA(const char* fname, crsMat_t &outMat);
 
 //////////////////////////////////////////////////////////////////////////////
 // Graph class
@@ -69,14 +69,44 @@ class Graph
   ordinal_t mNumVerts;
   ordinal_t mNumEdges;
 
+  std::string mFilename;
+
   crsMat_t mAdjMatrixA;
 
+  std::string mSupportFile;
+
+  kkTuning mTuning;
+  bool mAutoTune;
+  std::string mTuneCache;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Forms degree-ordered L: row i keeps the neighbors of higher degree
+  // (ties by lower index), i.e. the lower triangular part of A when
+  // numbered by decreasing degree
+  //////////////////////////////////////////////////////////////////////////
+  double createL(row_map_view_t &rowMapL, cols_view_t &entriesL);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Sets mTuning from mTuneCache, or by timing the kernel settings on a
+  // sample of L and adding the best to mTuneCache
+  //////////////////////////////////////////////////////////////////////////
+  double autoTune(const row_map_view_t &rowMapL, const cols_view_t &entriesL);
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Per-vertex triangle counts and per-edge support, written to
+  // mSupportFile
+  //////////////////////////////////////////////////////////////////////////
+  double triangleSupport(size_t numTriangles);
+  //////////////////////////////////////////////////////////////////////////
+
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mNumVerts(0),mAdjMatrixA()
+    :mNumVerts(0),mFilename("UNDEFINED"),mAdjMatrixA(),mAutoTune(false)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -85,7 +115,7 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string fname1) 
-    :mAdjMatrixA()
+    :mFilename(fname1),mAdjMatrixA(),mAutoTune(false)
   {
     struct timeval t1, t2;
 
@@ -96,7 +126,7 @@ class Graph
     ////////////////////////////////////////////////////////////////////
 
     std::cout << "Reading input file..." << std::endl;
-    readMMMatrixA(fname1.c_str(),mAdjMatrixA);
+    readMatrixA(fname1.c_str(),mAdjMatrixA);
 
     std::cout << "Finished Reading input file." << std::endl;
     ////////////////////////////////////////////////////////////////////
@@ -120,11 +150,31 @@ class Graph
 
 
   //////////////////////////////////////////////////////////////////////////
-  // Count triangles
+  // Count triangles -- returns the time of the counting kernel only
   //////////////////////////////////////////////////////////////////////////
   double triangleCount();
   //////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////
+  // Also write per-vertex/per-edge triangle counts to binary file fname
+  //////////////////////////////////////////////////////////////////////////
+  void setSupportFile(std::string fname) {mSupportFile=fname;};
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Autotune kernel settings, cached per input in file cacheFile
+  //////////////////////////////////////////////////////////////////////////
+  void setAutoTune(std::string cacheFile) {mAutoTune=true; mTuneCache=cacheFile;};
+  //////////////////////////////////////////////////////////////////////////
+
+  size_type getNumEdges() const {return mAdjMatrixA.nnz()/2;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Writes graph as cached CSR file, for fast reading by later runs
+  //////////////////////////////////////////////////////////////////////////
+  void writeCSR(std::string fname) const;
+  //////////////////////////////////////////////////////////////////////////
+
 };
 //////////////////////////////////////////////////////////////////////////////
 
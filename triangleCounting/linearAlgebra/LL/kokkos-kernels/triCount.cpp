@@ -53,11 +53,15 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <vector>
+#include <string>
+#include <algorithm>
 
 #include <omp.h>
 
 #include <sys/time.h>
 
+#include "trialUtil.h"
 #include "Graph.h"
 
 
@@ -66,9 +70,60 @@
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  if(argc!=3)
+  // --trials N --warmup W are removed from argv
+  trialParams trials;
+  parseTrialOptions(argc, argv, trials);
+
+  //////////////////////////////////////////////////////////////////
+  // Options follow the positional arguments
+  //////////////////////////////////////////////////////////////////
+  int numArgs = argc;
+  bool autoTune = false;
+  std::string tuneCache = "triCountTune.txt";
+  std::string csrFile;
+  std::string supportFile;
+
+  for(int i=1; i<argc; i++)
   {
-    std::cerr << "Usage: miniTri.exe matrixFile numThreads" << std::endl;
+    std::string arg(argv[i]);
+
+    if(arg.compare(0,2,"--")!=0)
+    {
+      continue;
+    }
+
+    numArgs = std::min(numArgs,i);
+
+    if(arg=="--tune")
+    {
+      autoTune = true;
+    }
+    else if(arg=="--tune-cache" && i+1<argc)
+    {
+      autoTune = true;
+      tuneCache = argv[++i];
+    }
+    else if(arg=="--write-csr" && i+1<argc)
+    {
+      csrFile = argv[++i];
+    }
+    else if(arg=="--support" && i+1<argc)
+    {
+      supportFile = argv[++i];
+    }
+    else
+    {
+      numArgs = 0;
+      break;
+    }
+  }
+  //////////////////////////////////////////////////////////////////
+
+  if(numArgs!=3)
+  {
+    std::cerr << "Usage: miniTri.exe matrixFile numThreads [--support supportFile]"
+              << " [--tune] [--tune-cache cacheFile] [--write-csr csrFile]"
+              << " [--trials N --warmup W]" << std::endl;
     exit(1);
   }
 
@@ -83,7 +138,45 @@ int main(int argc, char *argv[])
 
   Graph g(mat1);
 
-  g.triangleCount();
+  if(csrFile!="")
+  {
+    g.writeCSR(csrFile);
+  }
+
+  if(supportFile!="")
+  {
+    g.setSupportFile(supportFile);
+  }
+
+  if(autoTune)
+  {
+    g.setAutoTune(tuneCache);
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Count triangles warmup+trials times on the resident graph, timing
+  // the counting kernel
+  ////////////////////////////////////////////////////////////////////////
+  std::vector<double> times;
+
+  for(int run=0; run<trials.warmup+trials.trials; run++)
+  {
+    silenceOutput(run>0);
+
+    double eTime = g.triangleCount();
+
+    if(run>=trials.warmup)
+    {
+      times.push_back(eTime);
+    }
+  }
+  silenceOutput(false);
+
+  if(trials.enabled)
+  {
+    printTrialStats("LL-kokkos", trials, times, g.getNumEdges());
+  }
+  ////////////////////////////////////////////////////////////////////////
 
   myExecSpace::finalize();
 
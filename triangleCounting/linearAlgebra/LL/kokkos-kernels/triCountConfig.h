@@ -17,4 +17,23 @@ typedef typename crsMat_t::row_map_type::non_const_type row_map_view_t;
 typedef typename crsMat_t::index_type::non_const_type   cols_view_t;
 typedef typename crsMat_t::values_type::non_const_type values_view_t;
 
+//////////////////////////////////////////////////////////////////////////////
+// Settings of the Kokkos-Kernels triangle kernel
+//    teamWorkSize -- rows per thread chunk
+//    oneStepCompression -- 1 step of compression (false: 2 steps)
+//    dynamicScheduling -- dynamic scheduling of row chunks
+//////////////////////////////////////////////////////////////////////////////
+struct kkTuning
+{
+  int teamWorkSize;
+  bool oneStepCompression;
+  bool dynamicScheduling;
+
+  kkTuning()
+    :teamWorkSize(16),oneStepCompression(false),dynamicScheduling(true)
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
 #endif
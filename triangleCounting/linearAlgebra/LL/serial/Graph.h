@@ -58,6 +58,8 @@
 #include <cmath>
 
 #include "CSRmatrix.h"
+#include "sampleUtil.h"
+#include "wedgeUtil.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Graph class
@@ -73,25 +75,46 @@ class Graph
   int mNumVerts;
   CSRMat mMatrix;
 
-  int mNumTriangles;
+  count_t mNumTriangles;
+
+  // Time of the multiply/reduce phase of the last countTriangles()
+  double mKernelTime;
+
+  std::string mSupportFile;
+  std::vector<int> mOrigID;
+
+  vertorder_t mOrdering;
+
+  // Wedge statistics, only computed for AUTO_ORDER
+  bool mHaveWedgeStats;
+  wedgeStats mWedgeStats;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Reads graph, computes wedge statistics and applies vertex ordering
+  //////////////////////////////////////////////////////////////////////////
+  void readGraph();
+  //////////////////////////////////////////////////////////////////////////
 
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mNumTriangles(0)
+    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0),
+     mOrdering(NATURAL_ORDER),mHaveWedgeStats(false)
   {
   };
   //////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////
-  // Constructor that accepts matrix type as an argument
+  // Constructor that accepts filename and vertex ordering as arguments
+  //     -- AUTO_ORDER selects the ordering with lowest predicted time
   //////////////////////////////////////////////////////////////////////////
-  Graph(std::string _fname) 
-    :mFilename(_fname), mVertProp(0),mMatrix(), mNumTriangles(0)
+  Graph(std::string _fname, vertorder_t _order=NATURAL_ORDER) 
+    :mFilename(_fname), mVertProp(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0),
+     mOrdering(_order),mHaveWedgeStats(false)
   {
-     mMatrix.readMMMatrix(mFilename.c_str());
+     readGraph();
      mNumVerts = mMatrix.getM();
   };
   //////////////////////////////////////////////////////////////////////////
@@ -111,7 +134,27 @@ class Graph
   void countTriangles();
   //////////////////////////////////////////////////////////////////////////
 
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Time of the last count, excluding building L/H and support output
+  //////////////////////////////////////////////////////////////////////////
+  double getKernelTime() const {return mKernelTime;};
+  //////////////////////////////////////////////////////////////////////////
+  count_t getNumEdges() const {return mMatrix.getNNZ()/2;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Also write per-vertex/per-edge triangle counts to binary file fname
+  //////////////////////////////////////////////////////////////////////////
+  void setSupportFile(std::string fname) {mSupportFile=fname;};
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Approximate mode -- estimates the triangle count and triangle degrees
+  // by sampling the adjacency matrix, without forming L or B
+  //////////////////////////////////////////////////////////////////////////
+  void approximateCount(const approxParams &params);
+  //////////////////////////////////////////////////////////////////////////
 
 };
 //////////////////////////////////////////////////////////////////////////////
@@ -71,6 +71,8 @@ void Graph::countTriangles()
   struct timeval t1, t2;
   double eTime;
 
+  mKernelTime = 0.0;
+
   std::cout << "************************************************************"
             << "**********" << std::endl;
   std::cout << "Counting triangles ....." << std::endl;
@@ -119,6 +121,7 @@ void Graph::countTriangles()
   //  B.print();
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  mKernelTime += eTime;
   std::cout << "TIME - Time to compute B = L*U: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
@@ -140,6 +143,7 @@ void Graph::countTriangles()
   //  B.print();
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  mKernelTime += eTime;
   std::cout << "TIME - Time to compute B = B .* L: " << eTime << std::endl;
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
@@ -154,11 +158,46 @@ void Graph::countTriangles()
   gettimeofday(&t2, NULL);
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  mKernelTime += eTime;
   std::cout << "TIME - Time to sum up triangles: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
 
+  ///////////////////////////////////////////////////////////////////////
+  // Per-vertex triangle counts and per-edge support
+  ///////////////////////////////////////////////////////////////////////
+  if(mSupportFile!="")
+  {
+    std::cout << "--------------------" << std::endl;
+    std::cout << "Computing triangle support ..." << std::endl;
+
+    gettimeofday(&t1, NULL);
+
+    std::vector<int64_t> vertexTris;
+    std::vector<edgeSupport_t> edges;
+    int64_t numTris = L.countTriangleSupport(U, vertexTris, edges);
+
+    gettimeofday(&t2, NULL);
+
+    assert(numTris==mNumTriangles);
+
+    eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to compute triangle support: " << eTime << std::endl;
+
+    gettimeofday(&t1, NULL);
+    writeTriangleSupport(mSupportFile.c_str(), numTris, vertexTris.size(),
+                         vertexTris.data(), edges.size(), edges.data());
+    gettimeofday(&t2, NULL);
+
+    eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to write triangle support to " << mSupportFile 
+              << ": " << eTime << std::endl;
+
+    std::cout << "--------------------" << std::endl;
+  }
+  ///////////////////////////////////////////////////////////////////////
+
 
   std::cout << "************************************************************"
             << "**********" << std::endl;
@@ -168,3 +207,36 @@ void Graph::countTriangles()
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Approximate triangle count and triangle degrees by sampling
+//////////////////////////////////////////////////////////////////////////////
+void Graph::approximateCount(const approxParams &params)
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Estimating triangles ....." << std::endl;
+  std::cout << "************************************************************" 
+            << "**********" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  approxResult result;
+  approxTriangleCount(mMatrix, params, 0, result);
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to estimate triangles: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished triangle estimation" << std::endl;
+  std::cout << "************************************************************" 
+            << "**********" << std::endl;
+
+  printApproxResult(params, result);
+}
+//////////////////////////////////////////////////////////////////////////////
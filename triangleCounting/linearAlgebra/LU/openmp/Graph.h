@@ -59,6 +59,7 @@
 
 //#include "mmio.h"
 #include "CSRmatrix.h"
+#include "sampleUtil.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Graph class
@@ -74,14 +75,19 @@ class Graph
   int mNumVerts;
   CSRMat mMatrix;
 
-  int mNumTriangles;
+  count_t mNumTriangles;
+
+  // Time of the multiply/reduce phase of the last countTriangles()
+  double mKernelTime;
+
+  std::string mSupportFile;
 
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty graph
   //////////////////////////////////////////////////////////////////////////
   Graph() 
-    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mNumTriangles(0)
+    :mFilename("UNDEFINED"),mVertProp(0),mNumVerts(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0)
   {
   };
   //////////////////////////////////////////////////////////////////////////
@@ -90,7 +96,7 @@ class Graph
   // Constructor that accepts matrix type as an argument
   //////////////////////////////////////////////////////////////////////////
   Graph(std::string _fname) 
-    :mFilename(_fname), mVertProp(0),mMatrix(), mNumTriangles(0)
+    :mFilename(_fname), mVertProp(0),mMatrix(), mNumTriangles(0),mKernelTime(0.0)
   {
      mMatrix.readMMMatrix(mFilename.c_str());
      mNumVerts = mMatrix.getM();
@@ -112,7 +118,27 @@ class Graph
   void countTriangles();
   //////////////////////////////////////////////////////////////////////////
 
-  int getNumTriangles() const {return mNumTriangles;};
+  count_t getNumTriangles() const {return mNumTriangles;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Time of the last count, excluding building L/H and support output
+  //////////////////////////////////////////////////////////////////////////
+  double getKernelTime() const {return mKernelTime;};
+  //////////////////////////////////////////////////////////////////////////
+  count_t getNumEdges() const {return mMatrix.getNNZ()/2;};
+
+  //////////////////////////////////////////////////////////////////////////
+  // Also write per-vertex/per-edge triangle counts to binary file fname
+  //////////////////////////////////////////////////////////////////////////
+  void setSupportFile(std::string fname) {mSupportFile=fname;};
+  //////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////
+  // Approximate mode -- estimates the triangle count and triangle degrees
+  // by sampling the adjacency matrix, without forming L or B
+  //////////////////////////////////////////////////////////////////////////
+  void approximateCount(const approxParams &params);
+  //////////////////////////////////////////////////////////////////////////
 
 };
 //////////////////////////////////////////////////////////////////////////////
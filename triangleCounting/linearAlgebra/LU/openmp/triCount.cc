@@ -53,17 +53,36 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <vector>
+#include <sys/time.h>
 #include <omp.h>
 
+#include "trialUtil.h"
+#include "supportUtil.h"
 #include "Graph.h"
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-  if(argc!=3)
+  // --trials N --warmup W are removed from argv
+  trialParams trials;
+  parseTrialOptions(argc, argv, trials);
+
+  // --support file is removed from argv
+  std::string supportFile;
+  parseSupportOption(argc, argv, supportFile);
+
+  // Approximate mode options follow the positional arguments
+  approxParams params;
+  int numArgs = parseApproxOptions(argc, argv, params);
+
+  if(numArgs!=3)
   {
-    std::cerr << "Usage: triangleEnumerate mat.mtx numThreads" << std::endl;
+    std::cerr << "Usage: triangleEnumerate mat.mtx numThreads [--support supportFile]"
+              << " [--approx method[:param] [--reps R] [--seed S] [--error e]]"
+              << " [--trials N --warmup W]" << std::endl;
+    printApproxUsage();
     exit(1);
   }
 
@@ -73,10 +92,46 @@ int main(int argc, char *argv[])
   omp_set_num_threads(numThreads);
 
   Graph g(mat);
-  g.countTriangles();
+
+  if(supportFile!="")
+  {
+    g.setSupportFile(supportFile);
+  }
+
+  if(params.method!=EXACT_METHOD)
+  {
+    g.approximateCount(params);
+    return 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Count triangles warmup+trials times on the resident graph, timing
+  // only the multiply/reduce kernel (building L/H and support output are
+  // excluded)
+  ////////////////////////////////////////////////////////////////////////
+  std::vector<double> times;
+
+  for(int run=0; run<trials.warmup+trials.trials; run++)
+  {
+    silenceOutput(run>0);
+
+    g.countTriangles();
+
+    if(run>=trials.warmup)
+    {
+      times.push_back(g.getKernelTime());
+    }
+  }
+  silenceOutput(false);
+  ////////////////////////////////////////////////////////////////////////
 
   std::cout << "Number of Triangles: " << g.getNumTriangles() << std::endl;
 
+  if(trials.enabled)
+  {
+    printTrialStats("LU-openmp", trials, times, g.getNumEdges());
+  }
+
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -66,6 +66,24 @@
 
 int addNZ(std::map<int,int> &nzMap,int col, int elemToAdd);
 
+////////////////////////////////////////////////////////////////////////////////
+// addTriangleSupport -- counts triangle (v0,v1,v2) with edge positions
+//                       e01, e02, e12
+////////////////////////////////////////////////////////////////////////////////
+inline void addTriangleSupport(int v0, int v1, int v2, int e01, int e02, int e12,
+                               std::vector<int64_t> &vertexTris,
+                               std::vector<edgeSupport_t> &edges)
+{
+  vertexTris[v0]++;
+  vertexTris[v1]++;
+  vertexTris[v2]++;
+
+  edges[e01].support++;
+  edges[e02].support++;
+  edges[e12].support++;
+}
+////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 // print function -- outputs matrix to file
 //                -- accepts optional filename, "CSRmatrix.out" default name
@@ -87,9 +105,9 @@ void CSRMat::print() const
 ////////////////////////////////////////////////////////////////////////////////
 // Sums matrix elements
 ////////////////////////////////////////////////////////////////////////////////
-int CSRMat::getSumElements() const
+count_t CSRMat::getSumElements() const
 {
-  int sum = 0;
+  count_t sum = 0;
 
   for(int rownum=0; rownum<m; rownum++)
   {
@@ -166,7 +184,7 @@ void CSRMat::matmat(const CSRMat &A, const CSRMat &B)
   // Compute matrix entries one row at a time
   ///////////////////////////////////////////////////////////////////////////
   nnz =0;
-  int tmpNNZ =0;
+  count_t tmpNNZ =0;
   for (int rownum=0; rownum<m; rownum++)
   {
     nnzInRow[rownum]=0;
@@ -338,6 +356,169 @@ void CSRMat::EWMult(const CSRMat &W)
 }
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// initTriangleSupport -- sets up edge array in CSR order of L = this
+//                     -- rowStart[i] is position of first nonzero of row i
+////////////////////////////////////////////////////////////////////////////////
+void CSRMat::initTriangleSupport(std::vector<int> &rowStart,
+                                 std::vector<int64_t> &vertexTris,
+                                 std::vector<edgeSupport_t> &edges) const
+{
+  assert(type==LOWERTRI);
+  assert(m==n);
+
+  rowStart.resize(m+1);
+  rowStart[0]=0;
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    rowStart[rownum+1] = rowStart[rownum] + nnzInRow[rownum];
+  }
+
+  vertexTris.assign(m,0);
+  edges.resize(rowStart[m]);
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    for(int nzIndx=0; nzIndx<nnzInRow[rownum]; nzIndx++)
+    {
+      edgeSupport_t &e = edges[rowStart[rownum]+nzIndx];
+      e.v0 = rownum;
+      e.v1 = cols[rownum][nzIndx];
+      e.support = 0;
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// countTriangleSupport -- per-vertex triangle counts and per-edge support
+//                      -- from the triangles of (L * L) .* L, where L = this
+//
+// For each row i, the columns of L(i,:) are marked with their edge position.
+// A marked column j of L(k,:), k in L(i,:), is the triangle i>k>j.
+////////////////////////////////////////////////////////////////////////////////
+int64_t CSRMat::countTriangleSupport(std::vector<int64_t> &vertexTris,
+                                     std::vector<edgeSupport_t> &edges) const
+{
+  std::vector<int> rowStart;
+  initTriangleSupport(rowStart, vertexTris, edges);
+
+  int64_t numTriangles=0;
+  {
+    // marker[j] is 1 + edge position of L(i,j), 0 if not in row
+    std::vector<int> marker(n,0);
+    for(int rowI=0; rowI<m; rowI++)
+    {
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        marker[cols[rowI][nzI]] = rowStart[rowI]+nzI+1;
+      }
+
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        int rowK = cols[rowI][nzI];
+
+        for(int nzK=0; nzK<nnzInRow[rowK]; nzK++)
+        {
+          int ijPos = marker[cols[rowK][nzK]];
+
+          if(ijPos!=0)
+          {
+            addTriangleSupport(rowI, rowK, cols[rowK][nzK], rowStart[rowI]+nzI,
+                               ijPos-1, rowStart[rowK]+nzK, vertexTris, edges);
+            numTriangles++;
+          }
+        }
+      }
+
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        marker[cols[rowI][nzI]] = 0;
+      }
+    }
+  }
+
+  return numTriangles;
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// countTriangleSupport -- per-vertex triangle counts and per-edge support
+//                      -- from the triangles of (L * U) .* L, where L = this
+//
+// Same as above, with the wedges i>k<j taken from U(k,:).  U = L^T, so the
+// position of U(k,j) in the edge array of L is that of L(j,k).
+////////////////////////////////////////////////////////////////////////////////
+int64_t CSRMat::countTriangleSupport(const CSRMat &U,
+                                     std::vector<int64_t> &vertexTris,
+                                     std::vector<edgeSupport_t> &edges) const
+{
+  assert(U.getM()==m && U.getNNZ()==nnz);
+
+  std::vector<int> rowStart;
+  initTriangleSupport(rowStart, vertexTris, edges);
+
+  //////////////////////////////////////////////////////////
+  // Map nonzeros of U to edge positions in L
+  //////////////////////////////////////////////////////////
+  std::vector<int> uRowStart(m+1);
+  uRowStart[0]=0;
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    uRowStart[rownum+1] = uRowStart[rownum] + U.getNNZInRow(rownum);
+  }
+
+  std::vector<int> uToL(uRowStart[m]);
+  std::vector<int> uFill(uRowStart.begin(), uRowStart.end()-1);
+
+  for(int rownum=0; rownum<m; rownum++)
+  {
+    for(int nzIndx=0; nzIndx<nnzInRow[rownum]; nzIndx++)
+    {
+      uToL[uFill[cols[rownum][nzIndx]]++] = rowStart[rownum]+nzIndx;
+    }
+  }
+  //////////////////////////////////////////////////////////
+
+  int64_t numTriangles=0;
+  {
+    // marker[j] is 1 + edge position of L(i,j), 0 if not in row
+    std::vector<int> marker(n,0);
+    for(int rowI=0; rowI<m; rowI++)
+    {
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        marker[cols[rowI][nzI]] = rowStart[rowI]+nzI+1;
+      }
+
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        int rowK = cols[rowI][nzI];
+
+        for(int nzK=0; nzK<U.getNNZInRow(rowK); nzK++)
+        {
+          int colJ = U.getCol(rowK, nzK);
+          int ijPos = marker[colJ];
+
+          if(ijPos!=0)
+          {
+            addTriangleSupport(rowI, colJ, rowK, ijPos-1, rowStart[rowI]+nzI,
+                               uToL[uRowStart[rowK]+nzK], vertexTris, edges);
+            numTriangles++;
+          }
+        }
+      }
+
+      for(int nzI=0; nzI<nnzInRow[rowI]; nzI++)
+      {
+        marker[cols[rowI][nzI]] = 0;
+      }
+    }
+  }
+
+  return numTriangles;
+}
+////////////////////////////////////////////////////////////////////////////////
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 void CSRMat::readMMMatrix(const char *fname)
@@ -347,15 +528,23 @@ void CSRMat::readMMMatrix(const char *fname)
   // Build edge list from MM file                               
   //////////////////////////////////////////////////////////////
   int numVerts;
-  int numEdges;
+  int64_t numEdges;
   std::vector<edge_t> edgeList;
 
   buildEdgeListFromMM(fname, numVerts, numEdges, edgeList);
+  //////////////////////////////////////////////////////////////
 
+  createFromEdgeList(numVerts, edgeList);
+}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+void CSRMat::createFromEdgeList(int numVerts, std::vector<edge_t> &edgeList)
+{
   m = numVerts;
   n = numVerts;
-  nnz = numEdges;
-  //////////////////////////////////////////////////////////////
+  nnz = edgeList.size();
 
   //////////////////////////////////////////////////////////////
   // Allocate memory for matrix structure                       
@@ -368,7 +557,7 @@ void CSRMat::readMMMatrix(const char *fname)
   //////////////////////////////////////////////////////////////
   int tmpval=1;
 
-  for (int i=0; i<nnz; i++)
+  for (int64_t i=0; i<nnz; i++)
   {
     if(type==UNDEFINED)
     {
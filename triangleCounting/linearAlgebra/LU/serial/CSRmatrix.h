@@ -57,9 +57,12 @@ typedef enum {UNDEFINED,LOWERTRI,UPPERTRI} matrixtype;
 
 #include <vector>
 #include <map>
+#include <stdint.h>
 
 
 #include "mmio.h"
+#include "supportUtil.h"
+#include "miniTriDefs.h"
 
 //////////////////////////////////////////////////////////////////////////////
 // Compressed Sparse Row storage format Matrix
@@ -71,12 +74,16 @@ class CSRMat
   matrixtype type;
   int m;   //number of rows
   int n;   //number of cols
-  int nnz; //number of nonzeros
+  count_t nnz; //number of nonzeros
 
   int *nnzInRow;         // number of nonzeros in each row
   int **cols;            //columns of nonzeros
   int **vals; //values of nonzeros
 
+  void initTriangleSupport(std::vector<int> &rowStart,
+                           std::vector<int64_t> &vertexTris,
+                           std::vector<edgeSupport_t> &edges) const;
+
  public:
   //////////////////////////////////////////////////////////////////////////
   // default constructor -- builds empty matrix
@@ -163,7 +170,7 @@ class CSRMat
   //////////////////////////////////////////////////////////////////
   // Sums matrix elements
   //////////////////////////////////////////////////////////////////
-  int getSumElements() const;
+  count_t getSumElements() const;
   //////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////
@@ -176,7 +183,7 @@ class CSRMat
   int getN() const { return n;};
 
   // returns the number of cols
-  int getNNZ() const { return nnz;};
+  count_t getNNZ() const { return nnz;};
 
   // returns NNZ in row rnum
   inline int getNNZInRow(int rnum) const {return nnzInRow[rnum];};
@@ -198,8 +205,27 @@ class CSRMat
   void EWMult(const CSRMat &W);
   //////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////
+  // Per-vertex triangle counts and per-edge support (edges in CSR
+  // order of L = this), returns number of triangles
+  //     -- without U: triangles of (L * L) .* L
+  //     -- with U:    triangles of (L * U) .* L
+  //////////////////////////////////////////////////////////////////
+  int64_t countTriangleSupport(std::vector<int64_t> &vertexTris,
+                               std::vector<edgeSupport_t> &edges) const;
+  int64_t countTriangleSupport(const CSRMat &U,
+                               std::vector<int64_t> &vertexTris,
+                               std::vector<edgeSupport_t> &edges) const;
+  //////////////////////////////////////////////////////////////////
+
   void readMMMatrix(const char* fname);
 
+  //////////////////////////////////////////////////////////////////
+  // Builds matrix from symmetric 1-based edge list, frees edge list
+  //////////////////////////////////////////////////////////////////
+  void createFromEdgeList(int numVerts, std::vector<edge_t> &edgeList);
+  //////////////////////////////////////////////////////////////////
+
   void createTriMatrix(const CSRMat &matrix, matrixtype mtype);
 
   //////////////////////////////////////////////////////////////////////////
@@ -59,6 +59,60 @@
 
 #include "Graph.h"
 #include "mmio.h"
+#include "mmUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads graph and applies vertex ordering
+//    -- wedge statistics are only computed to select the AUTO_ORDER ordering
+//////////////////////////////////////////////////////////////////////////////
+void Graph::readGraph()
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  int numVerts;
+  int64_t numEdges;
+  std::vector<edge_t> edgeList;
+
+  buildEdgeListFromMM(mFilename.c_str(), numVerts, numEdges, edgeList);
+
+  ///////////////////////////////////////////////////////////////////////
+  // Wedge statistics (AUTO_ORDER only), apply ordering
+  ///////////////////////////////////////////////////////////////////////
+  std::cout << "--------------------" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  if(mOrdering==AUTO_ORDER)
+  {
+    std::cout << "Computing wedge statistics ..." << std::endl;
+
+    computeWedgeStats(numVerts, edgeList, mWedgeStats);
+    mHaveWedgeStats = true;
+
+    mOrdering = selectOrdering(mWedgeStats, LU_FORM);
+  }
+
+  applyOrdering(mOrdering, numVerts, edgeList, mOrigID);
+
+  gettimeofday(&t2, NULL);
+
+  if(mHaveWedgeStats)
+  {
+    printWedgeStats(mWedgeStats);
+  }
+  std::cout << "Ordering: " << orderingName(mOrdering) << std::endl;
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to compute wedge statistics and ordering: " 
+            << eTime << std::endl;
+
+  std::cout << "--------------------" << std::endl;
+  ///////////////////////////////////////////////////////////////////////
+
+  mMatrix.createFromEdgeList(numVerts, edgeList);
+}
+//////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
 // Enumerate triangles in graph
@@ -67,6 +121,7 @@ void Graph::countTriangles()
 {
   struct timeval t1, t2;
   double eTime;
+  double multTime=0.0;
 
   std::cout << "************************************************************"
             << "**********" << std::endl;
@@ -116,6 +171,7 @@ void Graph::countTriangles()
   //  B.print();
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  multTime += eTime;
   std::cout << "TIME - Time to compute B = L*U: " << eTime << std::endl;
 
   std::cout << "--------------------" << std::endl;
@@ -137,6 +193,7 @@ void Graph::countTriangles()
   //  B.print();
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  multTime += eTime;
   std::cout << "TIME - Time to compute B = B .* L: " << eTime << std::endl;
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
@@ -151,11 +208,57 @@ void Graph::countTriangles()
   gettimeofday(&t2, NULL);
 
   eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  multTime += eTime;
   std::cout << "TIME - Time to sum up triangles: " << eTime << std::endl;
 
+  mKernelTime = multTime;
+
   std::cout << "--------------------" << std::endl;
   ///////////////////////////////////////////////////////////////////////
 
+  ///////////////////////////////////////////////////////////////////////
+  // Per-vertex triangle counts and per-edge support
+  ///////////////////////////////////////////////////////////////////////
+  if(mSupportFile!="")
+  {
+    std::cout << "--------------------" << std::endl;
+    std::cout << "Computing triangle support ..." << std::endl;
+
+    gettimeofday(&t1, NULL);
+
+    std::vector<int64_t> vertexTris;
+    std::vector<edgeSupport_t> edges;
+    int64_t numTris = L.countTriangleSupport(U, vertexTris, edges);
+    unpermuteTriangleSupport(mOrigID, vertexTris, edges);
+
+    gettimeofday(&t2, NULL);
+
+    assert(numTris==mNumTriangles);
+
+    eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to compute triangle support: " << eTime << std::endl;
+
+    gettimeofday(&t1, NULL);
+    writeTriangleSupport(mSupportFile.c_str(), numTris, vertexTris.size(),
+                         vertexTris.data(), edges.size(), edges.data());
+    gettimeofday(&t2, NULL);
+
+    eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+    std::cout << "TIME - Time to write triangle support to " << mSupportFile 
+              << ": " << eTime << std::endl;
+
+    std::cout << "--------------------" << std::endl;
+  }
+  ///////////////////////////////////////////////////////////////////////
+
+
+  if(mHaveWedgeStats)
+  {
+    std::cout << "PREDICT - (L * U) .* L, " << orderingName(mOrdering) 
+              << " ordering -- predicted: " 
+              << predictTime(mWedgeStats, LU_FORM, mOrdering)
+              << ", actual: " << multTime << std::endl;
+  }
 
   std::cout << "************************************************************"
             << "**********" << std::endl;
@@ -165,3 +268,36 @@ void Graph::countTriangles()
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Approximate triangle count and triangle degrees by sampling
+//////////////////////////////////////////////////////////////////////////////
+void Graph::approximateCount(const approxParams &params)
+{
+  struct timeval t1, t2;
+  double eTime;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Estimating triangles ....." << std::endl;
+  std::cout << "************************************************************" 
+            << "**********" << std::endl;
+
+  gettimeofday(&t1, NULL);
+
+  approxResult result;
+  approxTriangleCount(mMatrix, params, 0, result);
+
+  gettimeofday(&t2, NULL);
+
+  eTime = t2.tv_sec - t1.tv_sec + ((t2.tv_usec-t1.tv_usec)/1000000.0);
+  std::cout << "TIME - Time to estimate triangles: " << eTime << std::endl;
+
+  std::cout << "************************************************************"
+            << "**********" << std::endl;
+  std::cout << "Finished triangle estimation" << std::endl;
+  std::cout << "************************************************************" 
+            << "**********" << std::endl;
+
+  printApproxResult(params, result);
+}
+//////////////////////////////////////////////////////////////////////////////
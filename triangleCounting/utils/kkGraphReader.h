@@ -0,0 +1,462 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      kkGraphReader.h                                               //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Reads graphs directly into Kokkos CRS matrices (row map and //
+//              entries only, no values) for the Kokkos-Kernels and Graph   //
+//              BLAS triangle counters.                                     //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef KKGRAPHREADER_H
+#define KKGRAPHREADER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+#include "miniTriDefs.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// File formats, chosen by extension
+//    .mtx -- Matrix Market (read by Kokkos-Kernels)
+//    .csr -- cached CSR written by writeCachedCrsMatrix:
+//            "KCSR", int64 numRows, int64 nnz, int64 rowMap[numRows+1],
+//            int64 entries[nnz]
+//    other -- binary edge file of edge_t records (see binFileReader.h),
+//             0-based, each undirected edge in either or both directions
+//
+// The binary readers map the file and fill the matrix in parallel, so
+// they require an execution space that can access host memory.
+//
+// Only the structure is stored: the returned matrix has nnz entries but an
+// empty values view.  Callers must never access matrix.values.
+//////////////////////////////////////////////////////////////////////////////
+#define CSR_CACHE_MAGIC "KCSR"
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Maps file read only, exits on failure
+//////////////////////////////////////////////////////////////////////////////
+inline const char *mapGraphFile(const char *fname, size_t &fileSize)
+{
+  int fd = open(fname, O_RDONLY);
+  struct stat st;
+
+  if(fd<0 || fstat(fd,&st)!=0)
+  {
+    std::cerr << "Could not open file " << fname << std::endl;
+    exit(1);
+  }
+
+  fileSize = st.st_size;
+
+  if(fileSize==0)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  void *data = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(data==MAP_FAILED)
+  {
+    std::cerr << "Could not map file " << fname << std::endl;
+    exit(1);
+  }
+
+  madvise(data, fileSize, MADV_SEQUENTIAL);
+
+  return (const char *) data;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+inline void unmapGraphFile(const char *data, size_t fileSize)
+{
+  if(data!=NULL)
+  {
+    munmap((void *) data, fileSize);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads binary edge file
+//
+// Rows are counted with atomics, prefix summed and filled in parallel,
+// then each row is sorted and duplicate edges (and self loops) removed.
+//////////////////////////////////////////////////////////////////////////////
+template <typename crsMat_t, typename execSpace>
+void readBinCrsMatrix(const char *fname, crsMat_t &matrix)
+{
+  // Lambdas read the mapped file and call std::sort/std::unique
+  static_assert(Kokkos::SpaceAccessibility<execSpace, Kokkos::HostSpace>::accessible,
+                "readBinCrsMatrix requires a host-accessible execution space");
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename crsMat_t::index_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::ordinal_type ordinal_t;
+  typedef typename crsMat_t::size_type size_type;
+
+  size_t fileSize;
+  const char *data = mapGraphFile(fname, fileSize);
+
+  if(fileSize%sizeof(edge_t)!=0)
+  {
+    std::cerr << "Size of binary edge file " << fname << " is not a multiple of "
+              << sizeof(edge_t) << " bytes" << std::endl;
+    exit(1);
+  }
+
+  const edge_t *edges = (const edge_t *) data;
+  const int64_t numEdges = fileSize/sizeof(edge_t);
+
+  //////////////////////////////////////////////////////////////
+  // Number of vertices
+  //////////////////////////////////////////////////////////////
+  int64_t maxVert=-1;
+  int64_t minVert=0;
+
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<execSpace>(0,numEdges),
+    KOKKOS_LAMBDA(const int64_t &e, int64_t &lmax)
+    {
+      lmax = std::max(lmax, std::max(edges[e].v0,edges[e].v1));
+    }, Kokkos::Max<int64_t>(maxVert));
+
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<execSpace>(0,numEdges),
+    KOKKOS_LAMBDA(const int64_t &e, int64_t &lmin)
+    {
+      lmin = std::min(lmin, std::min(edges[e].v0,edges[e].v1));
+    }, Kokkos::Min<int64_t>(minVert));
+
+  if(minVert<0 || maxVert>=(int64_t) std::numeric_limits<ordinal_t>::max() ||
+     2*numEdges>=(int64_t) std::numeric_limits<size_type>::max())
+  {
+    std::cerr << "Vertex IDs or number of edges in " << fname 
+              << " out of range of ordinal_t/size_type" << std::endl;
+    exit(1);
+  }
+
+  const ordinal_t m = maxVert+1;
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Count nonzeros in each row
+  //////////////////////////////////////////////////////////////
+  row_map_view_t rowMap("Row map of A", m+1);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<execSpace>(0,numEdges),
+    KOKKOS_LAMBDA(const int64_t &e)
+    {
+      if(edges[e].v0!=edges[e].v1)
+      {
+        Kokkos::atomic_increment(&rowMap(edges[e].v0+1));
+        Kokkos::atomic_increment(&rowMap(edges[e].v1+1));
+      }
+    }
+  );
+
+  Kokkos::parallel_scan(Kokkos::RangePolicy<execSpace>(0,m+1),
+    KOKKOS_LAMBDA(const ordinal_t &row, size_type &update, const bool final)
+    {
+      update += rowMap(row);
+      if(final)
+      {
+        rowMap(row) = update;
+      }
+    }
+  );
+
+  size_type nnz;
+  Kokkos::deep_copy(nnz, Kokkos::subview(rowMap, m));
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Fill entries
+  //////////////////////////////////////////////////////////////
+  cols_view_t entries("Entries of A", nnz);
+  row_map_view_t fillPos("Fill positions", m);
+
+  Kokkos::deep_copy(fillPos, Kokkos::subview(rowMap, std::make_pair((ordinal_t)0,m)));
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<execSpace>(0,numEdges),
+    KOKKOS_LAMBDA(const int64_t &e)
+    {
+      if(edges[e].v0!=edges[e].v1)
+      {
+        ordinal_t v0 = edges[e].v0;
+        ordinal_t v1 = edges[e].v1;
+
+        entries(Kokkos::atomic_fetch_add(&fillPos(v0),1)) = v1;
+        entries(Kokkos::atomic_fetch_add(&fillPos(v1),1)) = v0;
+      }
+    }
+  );
+
+  execSpace::fence();
+  unmapGraphFile(data, fileSize);
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Sort rows, count distinct columns
+  //////////////////////////////////////////////////////////////
+  row_map_view_t newRowMap("Row map of A", m+1);
+  size_type numDuplicates=0;
+
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<execSpace,Kokkos::Schedule<Kokkos::Dynamic> >(0,m),
+    KOKKOS_LAMBDA(const ordinal_t &row, size_type &lnumDups)
+    {
+      ordinal_t *first = entries.data() + rowMap(row);
+      ordinal_t *last = first + (rowMap(row+1)-rowMap(row));
+
+      std::sort(first,last);
+      size_type numDistinct = std::unique(first,last) - first;
+
+      newRowMap(row+1) = numDistinct;
+      lnumDups += (last-first) - numDistinct;
+    }, numDuplicates
+  );
+  //////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////
+  // Remove duplicates (edges given in both directions)
+  //////////////////////////////////////////////////////////////
+  if(numDuplicates>0)
+  {
+    Kokkos::parallel_scan(Kokkos::RangePolicy<execSpace>(0,m+1),
+      KOKKOS_LAMBDA(const ordinal_t &row, size_type &update, const bool final)
+      {
+        update += newRowMap(row);
+        if(final)
+        {
+          newRowMap(row) = update;
+        }
+      }
+    );
+
+    cols_view_t newEntries("Entries of A", nnz-numDuplicates);
+
+    Kokkos::parallel_for(Kokkos::RangePolicy<execSpace>(0,m),
+      KOKKOS_LAMBDA(const ordinal_t &row)
+      {
+        for(size_type nz=0; nz<newRowMap(row+1)-newRowMap(row); nz++)
+        {
+          newEntries(newRowMap(row)+nz) = entries(rowMap(row)+nz);
+        }
+      }
+    );
+
+    rowMap = newRowMap;
+    entries = newEntries;
+  }
+  //////////////////////////////////////////////////////////////
+
+  graph_t graph(entries, rowMap);
+  matrix = crsMat_t("A", m, values_view_t(), graph);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads cached CSR file
+//////////////////////////////////////////////////////////////////////////////
+template <typename crsMat_t, typename execSpace>
+void readCachedCrsMatrix(const char *fname, crsMat_t &matrix)
+{
+  // Lambdas read the mapped file
+  static_assert(Kokkos::SpaceAccessibility<execSpace, Kokkos::HostSpace>::accessible,
+                "readCachedCrsMatrix requires a host-accessible execution space");
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename crsMat_t::index_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::ordinal_type ordinal_t;
+  typedef typename crsMat_t::size_type size_type;
+
+  size_t fileSize;
+  const char *data = mapGraphFile(fname, fileSize);
+
+  size_t headerSize = 4 + 2*sizeof(int64_t);
+
+  if(fileSize<headerSize || strncmp(data,CSR_CACHE_MAGIC,4)!=0)
+  {
+    std::cerr << "File " << fname << " is not a cached CSR file" << std::endl;
+    exit(1);
+  }
+
+  int64_t numRows, numNZ;
+  memcpy(&numRows, data+4, sizeof(int64_t));
+  memcpy(&numNZ, data+4+sizeof(int64_t), sizeof(int64_t));
+
+  if(fileSize!=headerSize + (numRows+1+numNZ)*sizeof(int64_t) ||
+     numRows>=(int64_t) std::numeric_limits<ordinal_t>::max() ||
+     numNZ>=(int64_t) std::numeric_limits<size_type>::max())
+  {
+    std::cerr << "Cached CSR file " << fname << " is truncated or too large" << std::endl;
+    exit(1);
+  }
+
+  // Header is 20 bytes, so arrays are read with memcpy
+  const char *fileRowMap = data + headerSize;
+  const char *fileEntries = fileRowMap + (numRows+1)*sizeof(int64_t);
+
+  const ordinal_t m = numRows;
+  row_map_view_t rowMap("Row map of A", m+1);
+  cols_view_t entries("Entries of A", numNZ);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<execSpace>(0,m+1),
+    KOKKOS_LAMBDA(const ordinal_t &row)
+    {
+      int64_t val;
+      memcpy(&val, fileRowMap+row*sizeof(int64_t), sizeof(int64_t));
+      rowMap(row) = val;
+    }
+  );
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<execSpace>(0,numNZ),
+    KOKKOS_LAMBDA(const int64_t &nz)
+    {
+      int64_t val;
+      memcpy(&val, fileEntries+nz*sizeof(int64_t), sizeof(int64_t));
+      entries(nz) = val;
+    }
+  );
+
+  execSpace::fence();
+  unmapGraphFile(data, fileSize);
+
+  graph_t graph(entries, rowMap);
+  matrix = crsMat_t("A", m, values_view_t(), graph);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Writes matrix structure as cached CSR file
+//////////////////////////////////////////////////////////////////////////////
+template <typename crsMat_t>
+void writeCachedCrsMatrix(const char *fname, const crsMat_t &matrix)
+{
+  int64_t numRows = matrix.numRows();
+  int64_t numNZ = matrix.nnz();
+
+  Kokkos::View<typename crsMat_t::size_type *,Kokkos::HostSpace> rowMap("Row map", numRows+1);
+  Kokkos::View<typename crsMat_t::ordinal_type *,Kokkos::HostSpace> entries("Entries", numNZ);
+
+  Kokkos::deep_copy(rowMap, matrix.graph.row_map);
+  Kokkos::deep_copy(entries, matrix.graph.entries);
+
+  std::vector<int64_t> buffer(numRows+1+numNZ);
+  for(int64_t row=0; row<=numRows; row++)
+  {
+    buffer[row] = rowMap(row);
+  }
+  for(int64_t nz=0; nz<numNZ; nz++)
+  {
+    buffer[numRows+1+nz] = entries(nz);
+  }
+
+  std::ofstream file(fname, std::ios::binary);
+
+  file.write(CSR_CACHE_MAGIC, 4);
+  file.write((const char *) &numRows, sizeof(int64_t));
+  file.write((const char *) &numNZ, sizeof(int64_t));
+  file.write((const char *) buffer.data(), buffer.size()*sizeof(int64_t));
+
+  if(!file)
+  {
+    std::cerr << "Could not write cached CSR file " << fname << std::endl;
+    exit(1);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Reads graph file in format given by extension (see above)
+//    -- matrix.values is empty for every format, including .mtx
+//////////////////////////////////////////////////////////////////////////////
+template <typename crsMat_t, typename execSpace>
+void readKKMatrix(const char *fname, crsMat_t &matrix)
+{
+  std::string name(fname);
+  std::string ext = (name.rfind('.')==std::string::npos) ? "" : name.substr(name.rfind('.'));
+
+  if(ext==".mtx")
+  {
+    matrix = KokkosKernels::Impl::read_kokkos_crst_matrix<crsMat_t>(fname);
+    matrix.values = typename crsMat_t::values_type::non_const_type();
+  }
+  else if(ext==".csr")
+  {
+    readCachedCrsMatrix<crsMat_t,execSpace>(fname, matrix);
+  }
+  else
+  {
+    readBinCrsMatrix<crsMat_t,execSpace>(fname, matrix);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
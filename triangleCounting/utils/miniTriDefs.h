@@ -53,6 +53,15 @@
 #ifndef MINITRIDEFS_H
 #define MINITRIDEFS_H
 
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// Vertex and edge IDs are stored as int (range checked when graph is built).
+// Triangle counts can exceed that range on large graphs and are accumulated
+// as count_t.
+//////////////////////////////////////////////////////////////////////////////
+typedef int64_t count_t;
+
 typedef struct {
   int64_t v0;
   int64_t v1;
@@ -85,7 +85,7 @@ void writeMMBanner(std::ofstream &ofs, int m, int n, int nnz)
 //////////////////////////////////////////////////////////////////////////////
 // Matrix market file to edge list conversion
 //////////////////////////////////////////////////////////////////////////////
-void buildEdgeListFromMM(const char *fname, int &numVerts, int &numEdges, std::vector<edge_t> &edgeList)
+void buildEdgeListFromMM(const char *fname, int &numVerts, int64_t &numEdges, std::vector<edge_t> &edgeList)
 {
   //handle symmetric
   MM_typecode matcode;
@@ -106,7 +106,7 @@ void buildEdgeListFromMM(const char *fname, int &numVerts, int &numEdges, std::v
   checkMatrixType(matcode);
 
   int numRows,numCols;
-  int nnzToRead;
+  int64_t nnzToRead;
   // determine matrix dimensions
   if ( mm_read_mtx_crd_size(fp, &numRows, &numCols, &nnzToRead) !=0 )
   {
@@ -145,7 +145,7 @@ void buildEdgeListFromMM(const char *fname, int &numVerts, int &numEdges, std::v
   int tmprow,tmpcol;
   int tmpval;
 
-  for (int i=0; i<nnzToRead; i++)
+  for (int64_t i=0; i<nnzToRead; i++)
   {
      if(mm_is_pattern(matcode)!=0)
      {
@@ -202,7 +202,7 @@ void buildDistEdgeListFromMM(const char *fname, int worldsize, int myrank,
   checkMatrixType(matcode);
 
   int numRows,numCols;
-  int nnzToRead;
+  int64_t nnzToRead;
   // determine matrix dimensions
   if ( mm_read_mtx_crd_size(fp, &numRows, &numCols, &nnzToRead) !=0 )
   {
@@ -251,7 +251,7 @@ void buildDistEdgeListFromMM(const char *fname, int worldsize, int myrank,
   int tmprow,tmpcol;
   int tmpval;
 
-  for (int i=0; i<nnzToRead; i++)
+  for (int64_t i=0; i<nnzToRead; i++)
   {
      if(mm_is_pattern(matcode)!=0)
      {
@@ -313,12 +313,25 @@ void checkMatrixType(const MM_typecode &matcode)
 //////////////////////////////////////////////////////////////////////////////
 void partitionMatrix(int gNumRows,int P, int rank, int &locNumRows,
                      int &startrow)
+{
+  int64_t startrow64;
+  partitionMatrix((int64_t) gNumRows,P,rank,locNumRows,startrow64);
+
+  startrow = (int) startrow64;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// 64-bit overload, used to partition edge ID columns
+//////////////////////////////////////////////////////////////////////////////
+void partitionMatrix(int64_t gNumRows,int P, int rank, int &locNumRows,
+                     int64_t &startrow)
 {
   /////////////////////////////////////////////////////////////////////////
   // Local number of rows is gNumRows/P + 1 if rank < gNumRows%P
   // Otherwise: gNumRows/P
   /////////////////////////////////////////////////////////////////////////
-  locNumRows = (gNumRows/P);
+  locNumRows = (int) (gNumRows/P);
   if(rank < gNumRows%P)
   {
     locNumRows++;
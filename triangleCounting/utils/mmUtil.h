@@ -26,7 +26,7 @@ void writeMMBanner(std::ofstream &ofs, int m, int n, int nnz);
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
-void buildEdgeListFromMM(const char *fname, int &numVerts, int &numEdges, 
+void buildEdgeListFromMM(const char *fname, int &numVerts, int64_t &numEdges, 
 			 std::vector<edge_t> &edgeList);
 //////////////////////////////////////////////////////////////////////////////
 
@@ -41,6 +41,8 @@ void buildDistEdgeListFromMM(const char *fname, int worldsize, int myrank,
 //////////////////////////////////////////////////////////////////////////////
 void partitionMatrix(int gNumRows,int P, int rank, int &locNumRows,
                      int &startrow);
+void partitionMatrix(int64_t gNumRows,int P, int rank, int &locNumRows,
+                     int64_t &startrow);
 //////////////////////////////////////////////////////////////////////////////
 
 
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <stdint.h>
 
 
 #define MM_MAX_LINE_LENGTH 1025
@@ -23,6 +24,7 @@ char *mm_typecode_to_str(MM_typecode matcode);
 
 int mm_read_banner(FILE *f, MM_typecode *matcode);
 int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int *nz);
+int mm_read_mtx_crd_size(FILE *f, int *M, int *N, int64_t *nz);
 int mm_read_mtx_array_size(FILE *f, int *M, int *N);
 
 int mm_write_banner(std::ofstream &ofs, MM_typecode matcode);
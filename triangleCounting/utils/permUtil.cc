@@ -0,0 +1,161 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      permUtil.cc                                                   //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for vertex permutation utilities.               //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <vector>
+#include <cstdint>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "permUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// createDegreePermutation -- stable counting sort of vertices by degree
+//
+// Each thread counts the degrees of a contiguous range of vertices.  The
+// counts are scanned in (degree,thread) order so that each thread can
+// scatter its range in order, which keeps ties in increasing vertex order.
+//////////////////////////////////////////////////////////////////////////////
+void createDegreePermutation(const int *degree, int size,
+                             std::vector<int> &perm, std::vector<int> &iperm)
+{
+  perm.resize(size);
+  iperm.resize(size);
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Find maximum degree to size the buckets
+  ///////////////////////////////////////////////////////////////////////////
+  int maxDegree=0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static) reduction(max:maxDegree)
+#endif
+  for(int i=0; i<size; i++)
+  {
+    if(degree[i]>maxDegree)
+    {
+      maxDegree=degree[i];
+    }
+  }
+  int numBuckets = maxDegree+1;
+  ///////////////////////////////////////////////////////////////////////////
+
+  int maxThreads=1;
+#ifdef _OPENMP
+  maxThreads = omp_get_max_threads();
+#endif
+
+  // bucketOffsets[tid*numBuckets+d] -- count, then first position, of the
+  // degree d vertices in thread tid's range
+  std::vector<int> bucketOffsets((int64_t)maxThreads*numBuckets,0);
+
+#ifdef _OPENMP
+  #pragma omp parallel num_threads(maxThreads)
+#endif
+  {
+    int tid=0;
+    int numThreads=1;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+    numThreads = omp_get_num_threads();
+#endif
+
+    int startVert = ((int64_t)size*tid)/numThreads;
+    int endVert = ((int64_t)size*(tid+1))/numThreads;
+    int *offsets = &bucketOffsets[(int64_t)tid*numBuckets];
+
+    ////////////////////////////////////////////////////////////////////
+    // Count degrees in this thread's range
+    ////////////////////////////////////////////////////////////////////
+    for(int i=startVert; i<endVert; i++)
+    {
+      offsets[degree[i]]++;
+    }
+    ////////////////////////////////////////////////////////////////////
+
+#ifdef _OPENMP
+    #pragma omp barrier
+    #pragma omp single
+#endif
+    {
+      //////////////////////////////////////////////////////////////////
+      // Exclusive scan of counts, degree major, thread minor
+      //////////////////////////////////////////////////////////////////
+      int pos=0;
+      for(int d=0; d<numBuckets; d++)
+      {
+        for(int t=0; t<numThreads; t++)
+        {
+          int cnt = bucketOffsets[(int64_t)t*numBuckets+d];
+          bucketOffsets[(int64_t)t*numBuckets+d] = pos;
+          pos += cnt;
+        }
+      }
+      //////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////
+    // Scatter this thread's range into its slots
+    ////////////////////////////////////////////////////////////////////
+    for(int i=startVert; i<endVert; i++)
+    {
+      int newID = offsets[degree[i]]++;
+      perm[i] = newID;
+      iperm[newID] = i;
+    }
+    ////////////////////////////////////////////////////////////////////
+  }
+
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,322 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      sampleUtil.cc                                                 //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for approximate triangle counting by sampling.  //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "sampleUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses trailing options
+//////////////////////////////////////////////////////////////////////////////
+int parseApproxOptions(int argc, char *argv[], approxParams &params)
+{
+  int firstOpt = argc;
+
+  for(int i=1; i<argc; i++)
+  {
+    if(strncmp(argv[i],"--",2)!=0)
+    {
+      if(firstOpt<argc)
+      {
+        std::cerr << "Positional argument " << argv[i] 
+                  << " must precede options" << std::endl;
+        printApproxUsage();
+        exit(1);
+      }
+      continue;
+    }
+
+    if(firstOpt==argc)
+    {
+      firstOpt = i;
+    }
+
+    if(i+1>=argc)
+    {
+      std::cerr << "Missing value for " << argv[i] << std::endl;
+      printApproxUsage();
+      exit(1);
+    }
+
+    std::string opt(argv[i]);
+    std::string val(argv[++i]);
+
+    if(opt=="--approx")
+    {
+      std::string name = val.substr(0,val.find(':'));
+      std::string arg = (val.find(':')==std::string::npos) ? "" : val.substr(val.find(':')+1);
+
+      if(name=="doulion")
+      {
+        params.method = DOULION_METHOD;
+        params.param = 0.1;
+      }
+      else if(name=="colorful")
+      {
+        params.method = COLORFUL_METHOD;
+        params.param = 10;
+      }
+      else if(name=="wedge")
+      {
+        params.method = WEDGE_METHOD;
+        params.param = 0;
+      }
+      else
+      {
+        std::cerr << "Unknown sampling method: " << name << std::endl;
+        printApproxUsage();
+        exit(1);
+      }
+
+      if(arg!="")
+      {
+        params.param = atof(arg.c_str());
+      }
+    }
+    else if(opt=="--reps")
+    {
+      params.reps = atoi(val.c_str());
+    }
+    else if(opt=="--seed")
+    {
+      params.seed = strtoull(val.c_str(),0,10);
+    }
+    else if(opt=="--error")
+    {
+      params.error = atof(val.c_str());
+    }
+    else
+    {
+      std::cerr << "Unknown option: " << opt << std::endl;
+      printApproxUsage();
+      exit(1);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////
+  // Check parameters
+  /////////////////////////////////////////////////////////////////////////
+  if(params.reps<1 || params.error<=0.0 ||
+     (params.method==DOULION_METHOD && (params.param<=0.0 || params.param>1.0)) ||
+     (params.method==COLORFUL_METHOD && params.param<1.0) ||
+     (params.method==WEDGE_METHOD && params.param<0.0))
+  {
+    std::cerr << "Invalid sampling parameters" << std::endl;
+    printApproxUsage();
+    exit(1);
+  }
+  /////////////////////////////////////////////////////////////////////////
+
+  return firstOpt;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints usage of approximate counting options
+//////////////////////////////////////////////////////////////////////////////
+void printApproxUsage()
+{
+  std::cerr << "Approximate counting options:" << std::endl
+            << "  --approx doulion[:p]      keep edges with probability p (default 0.1)" << std::endl
+            << "  --approx colorful[:N]     keep edges within N colors (default 10)" << std::endl
+            << "  --approx wedge[:samples]  sample wedges (default: samples for --error)" << std::endl
+            << "  --reps R                  repetitions (default 3)" << std::endl
+            << "  --seed S                  random seed (default 1)" << std::endl
+            << "  --error e                 wedge sampling error bound (default 0.01)" << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints estimates
+//////////////////////////////////////////////////////////////////////////////
+void printApproxResult(const approxParams &params, const approxResult &result)
+{
+  const char *names[] = {"exact", "doulion", "colorful", "wedge"};
+
+  std::cout << "APPROX - Method: " << names[params.method]
+            << ", parameter: " << params.param
+            << ", repetitions: " << params.reps
+            << ", seed: " << params.seed << std::endl;
+
+  if(params.method==WEDGE_METHOD)
+  {
+    std::cout << "APPROX - Sampled wedges: " << result.sampleSize << std::endl;
+  }
+  else
+  {
+    std::cout << "APPROX - Sampled edges: " << result.sampleSize << std::endl;
+  }
+
+  std::cout << "Number of Triangles (est.): " << result.numTriangles << std::endl;
+  std::cout << "95% confidence interval: [" 
+            << std::max(0.0,result.numTriangles-1.96*result.stdErr) << ", "
+            << result.numTriangles+1.96*result.stdErr << "]" << std::endl;
+
+  double maxVTris=0.0;
+  for(unsigned int v=0; v<result.vertexTris.size(); v++)
+  {
+    maxVTris = std::max(maxVTris,result.vertexTris[v]);
+  }
+  std::cout << "Maximum vertex triangle degree (est.): " << maxVTris << std::endl;
+
+  if(result.kCounts.size()>0)
+  {
+    std::cout << "K-Counts (est., 95% confidence interval): " << std::endl;
+    for(unsigned int k=3; k<result.kCounts.size(); k++)
+    {
+      std::cout << "K[" << k << "] = " << result.kCounts[k] << " [" 
+                << std::max(0.0,result.kCounts[k]-1.96*result.kStdErr[k]) << ", "
+                << result.kCounts[k]+1.96*result.kStdErr[k] << "]" << std::endl;
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Uniform number in [0,1) from (seed,key) -- splitmix64 finalizer
+//////////////////////////////////////////////////////////////////////////////
+double sampleUnit(uint64_t seed, uint64_t key)
+{
+  uint64_t z = seed*0x9E3779B97F4A7C15ULL + key + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+
+  return (z >> 11) * (1.0/9007199254740992.0);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// k of triangle from min vertex/edge triangle degrees, same rule as the
+// exact k-counts
+//////////////////////////////////////////////////////////////////////////////
+unsigned int approxK(double tvMin, int64_t teMin, unsigned int numKCounts)
+{
+  unsigned int maxK=3;
+  for(unsigned int k=3; k<numKCounts; k++)
+  {
+    if(tvMin >= 0.5*(k-1)*(k-2) && teMin >= k-2)
+    {
+      maxK = k;
+    }
+    else
+    {
+      break;
+    }
+  }
+  return maxK;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Mean and standard error of the mean of independent repetitions
+//////////////////////////////////////////////////////////////////////////////
+void meanStdErr(const std::vector<double> &vals, double &mean, double &stdErr)
+{
+  int reps = vals.size();
+
+  mean=0.0;
+  for(int r=0; r<reps; r++)
+  {
+    mean += vals[r];
+  }
+  mean /= reps;
+
+  double var=0.0;
+  for(int r=0; r<reps; r++)
+  {
+    var += (vals[r]-mean)*(vals[r]-mean);
+  }
+  var = (reps>1) ? var/(reps-1) : 0.0;
+
+  stdErr = sqrt(var/reps);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Averages repetitions: vertexTris holds sums over repetitions,
+// repKCounts the k-counts of each repetition (empty if not requested)
+//////////////////////////////////////////////////////////////////////////////
+void combineApproxReps(const std::vector<double> &repTris, 
+                       const std::vector<std::vector<double> > &repKCounts,
+                       approxResult &result)
+{
+  int reps = repTris.size();
+
+  meanStdErr(repTris, result.numTriangles, result.stdErr);
+
+  for(unsigned int v=0; v<result.vertexTris.size(); v++)
+  {
+    result.vertexTris[v] /= reps;
+  }
+
+  unsigned int numKCounts = repKCounts[0].size();
+
+  result.kCounts.assign(numKCounts,0.0);
+  result.kStdErr.assign(numKCounts,0.0);
+
+  std::vector<double> repK(reps);
+  for(unsigned int k=0; k<numKCounts; k++)
+  {
+    for(int r=0; r<reps; r++)
+    {
+      repK[r] = repKCounts[r][k];
+    }
+    meanStdErr(repK, result.kCounts[k], result.kStdErr[k]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,147 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      supportUtil.cc                                                //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for per-vertex/per-edge triangle count output.  //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+
+#include "supportUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void unpermuteTriangleSupport(const std::vector<int> &origID,
+                              std::vector<int64_t> &vertexTris,
+                              std::vector<edgeSupport_t> &edges)
+{
+  std::vector<int64_t> permTris(vertexTris);
+
+  for(unsigned int v=0; v<permTris.size(); v++)
+  {
+    vertexTris[origID[v]] = permTris[v];
+  }
+
+  for(unsigned int e=0; e<edges.size(); e++)
+  {
+    int v0 = origID[edges[e].v0];
+    int v1 = origID[edges[e].v1];
+
+    edges[e].v0 = (v0>v1) ? v0 : v1;
+    edges[e].v1 = (v0>v1) ? v1 : v0;
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void writeTriangleSupport(const char *fname, int64_t numTriangles,
+                          int64_t numVerts, const int64_t *vertexTris,
+                          int64_t numEdges, const edgeSupport_t *edges)
+{
+  std::ofstream ofs(fname, std::ios::binary);
+
+  if(!ofs)
+  {
+    std::cerr << "Cannot open filename " << fname << std::endl;
+    exit(1);
+  }
+
+  const char magic[4] = {'T','R','I','S'};
+  int32_t version = SUPPORT_FILE_VERSION;
+
+  ofs.write(magic, sizeof(magic));
+  ofs.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  ofs.write(reinterpret_cast<const char *>(&numVerts), sizeof(numVerts));
+  ofs.write(reinterpret_cast<const char *>(&numEdges), sizeof(numEdges));
+  ofs.write(reinterpret_cast<const char *>(&numTriangles), sizeof(numTriangles));
+
+  ofs.write(reinterpret_cast<const char *>(vertexTris), numVerts*sizeof(int64_t));
+  ofs.write(reinterpret_cast<const char *>(edges), numEdges*sizeof(edgeSupport_t));
+
+  if(!ofs)
+  {
+    std::cerr << "Error writing triangle support file " << fname << std::endl;
+    exit(1);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void parseSupportOption(int &argc, char *argv[], std::string &supportFile)
+{
+  int newArgc=0;
+
+  for(int i=0; i<argc; i++)
+  {
+    std::string arg(argv[i]);
+
+    if(arg=="--support")
+    {
+      if(i+1>=argc)
+      {
+        std::cerr << "Missing value for " << arg << std::endl;
+        exit(1);
+      }
+
+      supportFile = argv[++i];
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+
+  argc = newArgc;
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      supportUtil.h                                                 //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for per-vertex/per-edge triangle count output.  //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef SUPPORTUTIL_H
+#define SUPPORTUTIL_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// Edge and the number of triangles containing it (0-based, v0 > v1)
+//////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  int v0;
+  int v1;
+  int support;
+} edgeSupport_t;
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Binary triangle support file layout (native byte order):
+//
+//    char    magic[4]           "TRIS"
+//    int32   version            SUPPORT_FILE_VERSION
+//    int64   numVerts
+//    int64   numEdges
+//    int64   numTriangles
+//    int64   vertexTris[numVerts]     triangles containing each vertex
+//    int32   {v0,v1,support}[numEdges]
+//////////////////////////////////////////////////////////////////////////////
+#define SUPPORT_FILE_VERSION 1
+
+//////////////////////////////////////////////////////////////////////////////
+// Relabels vertex counts and edges from a reordered numbering back to the
+// input numbering.  origID maps new to old (0-based) vertex IDs.
+//////////////////////////////////////////////////////////////////////////////
+void unpermuteTriangleSupport(const std::vector<int> &origID,
+                              std::vector<int64_t> &vertexTris,
+                              std::vector<edgeSupport_t> &edges);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Writes per-vertex triangle counts and per-edge support to binary file
+//////////////////////////////////////////////////////////////////////////////
+void writeTriangleSupport(const char *fname, int64_t numTriangles,
+                          int64_t numVerts, const int64_t *vertexTris,
+                          int64_t numEdges, const edgeSupport_t *edges);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses "--support file" from the command line and removes it from argv.
+// supportFile is left unchanged if the option is not given.
+//////////////////////////////////////////////////////////////////////////////
+void parseSupportOption(int &argc, char *argv[], std::string &supportFile);
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,169 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      trialUtil.cc                                                  //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for repeated timing of triangle counts.         //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "trialUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes trial options
+//////////////////////////////////////////////////////////////////////////////
+void parseTrialOptions(int &argc, char *argv[], trialParams &params)
+{
+  int newArgc=0;
+
+  for(int i=0; i<argc; i++)
+  {
+    std::string arg(argv[i]);
+
+    if(arg=="--trials" || arg=="--warmup")
+    {
+      if(i+1>=argc)
+      {
+        std::cerr << "Missing value for " << arg << std::endl;
+        exit(1);
+      }
+
+      int val = atoi(argv[++i]);
+
+      if(arg=="--trials")
+      {
+        params.trials = val;
+      }
+      else
+      {
+        params.warmup = val;
+      }
+      params.enabled = true;
+    }
+    else
+    {
+      argv[newArgc++] = argv[i];
+    }
+  }
+
+  argc = newArgc;
+
+  if(params.trials<1 || params.warmup<0)
+  {
+    std::cerr << "Number of trials must be at least 1, warmup runs at least 0" << std::endl;
+    exit(1);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Discards std::cout output while silence is true
+//////////////////////////////////////////////////////////////////////////////
+void silenceOutput(bool silence)
+{
+  static std::streambuf *coutBuf = 0;
+  static std::ostringstream nullStream;
+
+  if(silence && coutBuf==0)
+  {
+    coutBuf = std::cout.rdbuf(nullStream.rdbuf());
+  }
+  else if(!silence && coutBuf!=0)
+  {
+    std::cout.rdbuf(coutBuf);
+    coutBuf = 0;
+  }
+
+  // Drop anything written while silenced
+  nullStream.str("");
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints statistics of trial times
+//////////////////////////////////////////////////////////////////////////////
+void printTrialStats(const char *driver, const trialParams &params,
+                     const std::vector<double> &times, int64_t numEdges)
+{
+  std::vector<double> sorted(times);
+  std::sort(sorted.begin(),sorted.end());
+
+  int n = sorted.size();
+
+  double median = (n%2==1) ? sorted[n/2] : 0.5*(sorted[n/2-1]+sorted[n/2]);
+
+  double mean=0.0;
+  for(int t=0; t<n; t++)
+  {
+    mean += sorted[t];
+  }
+  mean /= n;
+
+  double var=0.0;
+  for(int t=0; t<n; t++)
+  {
+    var += (sorted[t]-mean)*(sorted[t]-mean);
+  }
+  double stddev = (n>1) ? sqrt(var/(n-1)) : 0.0;
+
+  std::cout << "TRIALS driver=" << driver << " trials=" << params.trials
+            << " warmup=" << params.warmup << " edges=" << numEdges
+            << " min=" << sorted[0] << " median=" << median 
+            << " mean=" << mean << " stddev=" << stddev
+            << " gteps_best=" << ((sorted[0]>0.0) ? numEdges/sorted[0]/1.0e9 : 0.0)
+            << " gteps_median=" << ((median>0.0) ? numEdges/median/1.0e9 : 0.0)
+            << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,100 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      trialUtil.h                                                   //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for repeated timing of triangle counts.         //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef TRIALUTIL_H
+#define TRIALUTIL_H
+
+#include <vector>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////////////
+// Number of timed trials and of untimed warmup runs
+//////////////////////////////////////////////////////////////////////////////
+struct trialParams
+{
+  int trials;
+  int warmup;
+  bool enabled;    // --trials or --warmup given
+
+  trialParams()
+    :trials(1),warmup(0),enabled(false)
+  {
+  };
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Parses and removes "--trials N" and "--warmup W" from argv, so that the
+// driver's own argument parsing is unchanged
+//////////////////////////////////////////////////////////////////////////////
+void parseTrialOptions(int &argc, char *argv[], trialParams &params);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Discards std::cout output while silence is true (used for all runs
+// after the first, so that the output of the count is printed once)
+//////////////////////////////////////////////////////////////////////////////
+void silenceOutput(bool silence);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints min/median/mean/stddev of the trial times and the edge rate
+// (GTEPS = numEdges / time / 1e9) as a single line:
+//    TRIALS driver=... trials=N warmup=W edges=E min=... median=... 
+//           mean=... stddev=... gteps_best=... gteps_median=...
+//////////////////////////////////////////////////////////////////////////////
+void printTrialStats(const char *driver, const trialParams &params,
+                     const std::vector<double> &times, int64_t numEdges);
+//////////////////////////////////////////////////////////////////////////////
+
+#endif
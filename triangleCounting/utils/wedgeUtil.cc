@@ -0,0 +1,387 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      wedgeUtil.cc                                                  //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Source file for wedge count estimates and formulation       //
+//              selection.                                                  //
+//                                                                          //
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "wedgeUtil.h"
+#include "permUtil.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Cost model -- seconds per wedge and per adjacency nonzero for each
+// formulation's multiply phases, fit to the serial reference
+// implementations.  For LL/LU one std::map insert per wedge dominates and
+// the per nonzero cost covers B .* L.  LH uses a count-only kernel with a
+// dense row marker; its per nonzero cost covers building implicit H and L.
+//////////////////////////////////////////////////////////////////////////////
+namespace
+{
+  const double secPerWedge[NUM_FORMS] = {2.4e-7, 2.7e-7, 2.5e-9};
+  const double secPerNZ[NUM_FORMS]    = {1.5e-7, 1.5e-7, 1.0e-7};
+}
+//////////////////////////////////////////////////////////////////////////////
+
+void createOrderingRanks(vertorder_t order, const std::vector<int> &degree,
+                         std::vector<int> &rank);
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+const char *formulationName(triformulation_t form)
+{
+  switch(form)
+  {
+    case LL_FORM: return "LL";
+    case LU_FORM: return "LU";
+    case LH_FORM: return "LH";
+    default: return "UNDEFINED";
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+const char *orderingName(vertorder_t order)
+{
+  switch(order)
+  {
+    case NATURAL_ORDER: return "natural";
+    case DEGREE_ASCENDING: return "ascending";
+    case DEGREE_DESCENDING: return "descending";
+    case AUTO_ORDER: return "auto";
+    default: return "UNDEFINED";
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+vertorder_t parseOrdering(const std::string &name)
+{
+  if(name=="natural")
+  {
+    return NATURAL_ORDER;
+  }
+  else if(name=="ascending")
+  {
+    return DEGREE_ASCENDING;
+  }
+  else if(name=="descending")
+  {
+    return DEGREE_DESCENDING;
+  }
+  else if(name=="auto")
+  {
+    return AUTO_ORDER;
+  }
+
+  std::cerr << "Ordering must be natural, ascending, descending or auto" 
+            << std::endl;
+  exit(1);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// computeWedgeStats
+//
+// With vertex ranks fixed by an ordering, let low(k) and high(k) be the
+// number of neighbors of k ranked below and above k.  Row i of L holds the
+// neighbors ranked below i, so summing over the middle vertex k:
+//    LL: L(i,k)*L(k,j)  -- high(k) * low(k) wedges
+//    LU: L(i,k)*U(k,j)  -- high(k) * high(k) wedges
+//    LH: L(i,k)*H(k,e)  -- high(k) * high(k) wedges, since the count-only
+//                          kernel scans only the edges to k's higher
+//                          neighbors (each entry C(i,e)==2 is found from
+//                          the lower endpoint of e)
+//////////////////////////////////////////////////////////////////////////////
+void computeWedgeStats(int numVerts, const std::vector<edge_t> &edgeList,
+                       wedgeStats &stats)
+{
+  stats.numVerts = numVerts;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Degree statistics
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> degree(numVerts,0);
+  stats.numNZ = 0;
+
+  for(unsigned int i=0; i<edgeList.size(); i++)
+  {
+    if(edgeList[i].v0!=edgeList[i].v1)
+    {
+      degree[edgeList[i].v0-1]++;
+      stats.numNZ++;
+    }
+  }
+
+  stats.maxDegree = 0;
+  double sumDegSq = 0.0;
+  for(int v=0; v<numVerts; v++)
+  {
+    if(degree[v]>stats.maxDegree)
+    {
+      stats.maxDegree = degree[v];
+    }
+    sumDegSq += (double)degree[v]*degree[v];
+  }
+
+  stats.avgDegree = 0.0;
+  stats.degreeStdDev = 0.0;
+  if(numVerts>0)
+  {
+    stats.avgDegree = (double)stats.numNZ/numVerts;
+    double var = sumDegSq/numVerts - stats.avgDegree*stats.avgDegree;
+    stats.degreeStdDev = std::sqrt(var>0.0 ? var : 0.0);
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Exact wedge counts for each ordering
+  ///////////////////////////////////////////////////////////////////////////
+  std::vector<int> rank;
+  std::vector<int> lowDegree(numVerts);
+
+  for(int order=0; order<NUM_ORDERS; order++)
+  {
+    createOrderingRanks((vertorder_t)order, degree, rank);
+
+    std::fill(lowDegree.begin(),lowDegree.end(),0);
+
+    for(unsigned int i=0; i<edgeList.size(); i++)
+    {
+      int v0 = edgeList[i].v0-1;
+      int v1 = edgeList[i].v1-1;
+
+      if(rank[v1]<rank[v0])
+      {
+        lowDegree[v0]++;
+      }
+    }
+
+    int64_t wLL=0, wLU=0, wLH=0;
+    for(int k=0; k<numVerts; k++)
+    {
+      int64_t low = lowDegree[k];
+      int64_t high = degree[k]-lowDegree[k];
+
+      wLL += high*low;
+      wLU += high*high;
+      wLH += high*high;
+    }
+
+    stats.wedges[LL_FORM][order] = wLL;
+    stats.wedges[LU_FORM][order] = wLU;
+    stats.wedges[LH_FORM][order] = wLH;
+  }
+  ///////////////////////////////////////////////////////////////////////////
+
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+double predictTime(const wedgeStats &stats, triformulation_t form,
+                   vertorder_t order)
+{
+  return secPerWedge[form]*stats.wedges[form][order] + 
+         secPerNZ[form]*stats.numNZ;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+vertorder_t selectOrdering(const wedgeStats &stats, triformulation_t form)
+{
+  vertorder_t bestOrder = NATURAL_ORDER;
+
+  for(int order=1; order<NUM_ORDERS; order++)
+  {
+    if(predictTime(stats,form,(vertorder_t)order) < 
+       predictTime(stats,form,bestOrder))
+    {
+      bestOrder = (vertorder_t) order;
+    }
+  }
+  return bestOrder;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void selectFormulation(const wedgeStats &stats, triformulation_t &form,
+                       vertorder_t &order)
+{
+  form = LL_FORM;
+  order = selectOrdering(stats,LL_FORM);
+
+  for(int f=1; f<NUM_FORMS; f++)
+  {
+    vertorder_t fOrder = selectOrdering(stats,(triformulation_t)f);
+
+    if(predictTime(stats,(triformulation_t)f,fOrder) < 
+       predictTime(stats,form,order))
+    {
+      form = (triformulation_t) f;
+      order = fOrder;
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void printWedgeStats(const wedgeStats &stats)
+{
+  std::cout << "Vertices: " << stats.numVerts 
+            << ", Nonzeros: " << stats.numNZ << std::endl;
+  std::cout << "Degree max: " << stats.maxDegree 
+            << ", avg: " << stats.avgDegree
+            << ", stddev: " << stats.degreeStdDev << std::endl;
+
+  for(int form=0; form<NUM_FORMS; form++)
+  {
+    for(int order=0; order<NUM_ORDERS; order++)
+    {
+      std::cout << "WEDGES - " << formulationName((triformulation_t)form)
+                << " " << std::setw(10) << std::left 
+                << orderingName((vertorder_t)order) << std::right 
+                << ": " << stats.wedges[form][order] 
+                << ", predicted time: " 
+                << predictTime(stats,(triformulation_t)form,(vertorder_t)order)
+                << std::endl;
+    }
+  }
+
+  triformulation_t bestForm;
+  vertorder_t bestOrder;
+  selectFormulation(stats,bestForm,bestOrder);
+
+  std::cout << "Selected formulation: " << formulationName(bestForm) 
+            << ", ordering: " << orderingName(bestOrder) << std::endl;
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+void applyOrdering(vertorder_t order, int numVerts,
+                   std::vector<edge_t> &edgeList, std::vector<int> &origID)
+{
+  origID.resize(numVerts);
+
+  if(order==NATURAL_ORDER)
+  {
+    for(int v=0; v<numVerts; v++)
+    {
+      origID[v] = v;
+    }
+    return;
+  }
+
+  std::vector<int> degree(numVerts,0);
+  for(unsigned int i=0; i<edgeList.size(); i++)
+  {
+    if(edgeList[i].v0!=edgeList[i].v1)
+    {
+      degree[edgeList[i].v0-1]++;
+    }
+  }
+
+  std::vector<int> rank;
+  createOrderingRanks(order, degree, rank);
+
+  for(int v=0; v<numVerts; v++)
+  {
+    origID[rank[v]] = v;
+  }
+
+  for(unsigned int i=0; i<edgeList.size(); i++)
+  {
+    edgeList[i].v0 = rank[edgeList[i].v0-1]+1;
+    edgeList[i].v1 = rank[edgeList[i].v1-1]+1;
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// createOrderingRanks -- rank[v] is the new (0-based) ID of vertex v
+//////////////////////////////////////////////////////////////////////////////
+void createOrderingRanks(vertorder_t order, const std::vector<int> &degree,
+                         std::vector<int> &rank)
+{
+  int numVerts = degree.size();
+
+  if(order==NATURAL_ORDER)
+  {
+    rank.resize(numVerts);
+    for(int v=0; v<numVerts; v++)
+    {
+      rank[v] = v;
+    }
+    return;
+  }
+
+  std::vector<int> iperm;
+  createDegreePermutation(&degree[0], numVerts, rank, iperm);
+
+  if(order==DEGREE_DESCENDING)
+  {
+    for(int v=0; v<numVerts; v++)
+    {
+      rank[v] = numVerts-1-rank[v];
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
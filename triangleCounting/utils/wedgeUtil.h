@@ -0,0 +1,144 @@
+//@HEADER
+// ************************************************************************
+// 
+//                        miniTri v. 1.0
+//              Copyright (2016) Sandia Corporation
+// 
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Jon Berry (jberry@sandia.gov)
+//                     Michael Wolf (mmwolf@sandia.gov)
+// 
+// ************************************************************************
+//@HEADER
+
+
+//////////////////////////////////////////////////////////////////////////////
+//                                                                          //
+// File:      wedgeUtil.h                                                   //
+// Project:   miniTri                                                       //
+// Author:    Michael Wolf                                                  //
+//                                                                          //
+// Description:                                                             //
+//              Header file for wedge count estimates and formulation       //
+//              selection.                                                  //
+//////////////////////////////////////////////////////////////////////////////
+#ifndef WEDGEUTIL_H
+#define WEDGEUTIL_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include "miniTriDefs.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// Triangle counting formulations
+//    LL_FORM -- sum((L * L) .* L)
+//    LU_FORM -- sum((L * U) .* L)
+//    LH_FORM -- number of entries of L * H equal to 2, H incidence matrix
+//////////////////////////////////////////////////////////////////////////////
+enum triformulation_t {LL_FORM=0, LU_FORM, LH_FORM, NUM_FORMS};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Vertex orderings applied before L and U are formed
+//////////////////////////////////////////////////////////////////////////////
+enum vertorder_t {NATURAL_ORDER=0, DEGREE_ASCENDING, DEGREE_DESCENDING,
+                  NUM_ORDERS, AUTO_ORDER};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Degree statistics and exact wedge counts for each formulation/ordering.
+// A wedge is one (i,k,j) product term of the formulation's matmat, so it
+// is the number of scalar multiply-adds the kernel performs.
+//////////////////////////////////////////////////////////////////////////////
+struct wedgeStats
+{
+  int numVerts;
+  int64_t numNZ;            // nonzeros in adjacency matrix, no self loops
+  int maxDegree;
+  double avgDegree;
+  double degreeStdDev;
+  int64_t wedges[NUM_FORMS][NUM_ORDERS];
+};
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Names used for printing and parsing
+//////////////////////////////////////////////////////////////////////////////
+const char *formulationName(triformulation_t form);
+const char *orderingName(vertorder_t order);
+
+// Exits with an error if name is not natural, ascending, descending or auto
+vertorder_t parseOrdering(const std::string &name);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Computes wedge statistics from a symmetric 1-based edge list -- O(edges)
+// per ordering
+//////////////////////////////////////////////////////////////////////////////
+void computeWedgeStats(int numVerts, const std::vector<edge_t> &edgeList,
+                       wedgeStats &stats);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Predicted time (seconds) of the formulation's multiply phases on the
+// serial reference implementation
+//////////////////////////////////////////////////////////////////////////////
+double predictTime(const wedgeStats &stats, triformulation_t form,
+                   vertorder_t order);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Selectors -- lowest predicted time for a given formulation, or over all
+// formulations and orderings
+//////////////////////////////////////////////////////////////////////////////
+vertorder_t selectOrdering(const wedgeStats &stats, triformulation_t form);
+void selectFormulation(const wedgeStats &stats, triformulation_t &form,
+                       vertorder_t &order);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints degree statistics and the predictions for all formulations
+//////////////////////////////////////////////////////////////////////////////
+void printWedgeStats(const wedgeStats &stats);
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+// Relabels the vertices of a 1-based edge list with the given ordering.
+// origID maps new to old (0-based) vertex IDs.
+//////////////////////////////////////////////////////////////////////////////
+void applyOrdering(vertorder_t order, int numVerts,
+                   std::vector<edge_t> &edgeList, std::vector<int> &origID);
+//////////////////////////////////////////////////////////////////////////////
+
+#endif